@@ -9,3 +9,8 @@
 #define GL_GLEXT_PROTOTYPES 1
 #include "glcorearb.h"
 #endif
+
+#ifdef GL_CALL_COUNTERS
+//count and time every GL call (see gl_call_counters.hpp):
+#include "gl_counters.hpp"
+#endif
@@ -0,0 +1,146 @@
+#include "alloc_tracker.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef ALLOC_TRACKING
+
+static std::atomic< uint64_t > total_allocations(0);
+static std::atomic< uint64_t > total_bytes(0);
+static std::atomic< uint64_t > total_frees(0);
+static thread_local AllocCounts thread_counts;
+
+static void *counted_alloc(size_t size) {
+	total_allocations.fetch_add(1, std::memory_order_relaxed);
+	total_bytes.fetch_add(size, std::memory_order_relaxed);
+	thread_counts.allocations += 1;
+	thread_counts.bytes += size;
+	return std::malloc(size ? size : 1);
+}
+
+static void counted_free(void *ptr) {
+	if (!ptr) return;
+	total_frees.fetch_add(1, std::memory_order_relaxed);
+	thread_counts.frees += 1;
+	std::free(ptr);
+}
+
+void *operator new(size_t size) {
+	void *ptr = counted_alloc(size);
+	if (!ptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size) {
+	void *ptr = counted_alloc(size);
+	if (!ptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new(size_t size, std::nothrow_t const &) noexcept {
+	return counted_alloc(size);
+}
+
+void *operator new[](size_t size, std::nothrow_t const &) noexcept {
+	return counted_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	counted_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	counted_free(ptr);
+}
+
+void operator delete(void *ptr, std::nothrow_t const &) noexcept {
+	counted_free(ptr);
+}
+
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept {
+	counted_free(ptr);
+}
+
+bool alloc_tracking_enabled() {
+	return true;
+}
+
+AllocCounts alloc_counts() {
+	AllocCounts counts;
+	counts.allocations = total_allocations.load(std::memory_order_relaxed);
+	counts.bytes = total_bytes.load(std::memory_order_relaxed);
+	counts.frees = total_frees.load(std::memory_order_relaxed);
+	return counts;
+}
+
+AllocCounts thread_alloc_counts() {
+	return thread_counts;
+}
+
+#else
+
+bool alloc_tracking_enabled() {
+	return false;
+}
+
+AllocCounts alloc_counts() {
+	return AllocCounts();
+}
+
+AllocCounts thread_alloc_counts() {
+	return AllocCounts();
+}
+
+#endif //ALLOC_TRACKING
+
+void FrameAllocTracker::begin_frame() {
+	phase_count = 0;
+	excused = false;
+	phase_start = thread_alloc_counts();
+}
+
+void FrameAllocTracker::close_phase() {
+	if (phase_count == 0) return;
+	AllocCounts now = thread_alloc_counts();
+	Phase &p = phases[phase_count - 1];
+	p.counts.allocations = now.allocations - phase_start.allocations;
+	p.counts.bytes = now.bytes - phase_start.bytes;
+	p.counts.frees = now.frees - phase_start.frees;
+	phase_start = now;
+}
+
+void FrameAllocTracker::phase(char const *name) {
+	close_phase();
+	if (phase_count == MaxPhases) return; //keep counting into the last phase
+	phases[phase_count].name = name;
+	phases[phase_count].counts = AllocCounts();
+	phase_count += 1;
+	phase_start = thread_alloc_counts();
+}
+
+void FrameAllocTracker::end_frame() {
+	close_phase();
+
+	AllocCounts frame_total;
+	for (uint32_t i = 0; i < phase_count; ++i) {
+		frame_total.allocations += phases[i].counts.allocations;
+		frame_total.bytes += phases[i].counts.bytes;
+		frame_total.frees += phases[i].counts.frees;
+	}
+
+	//printf rather than iostreams, so reporting does not count against the next frame:
+	if (frame >= warmup_frames && !excused && frame_total.allocations != 0) {
+		failed_frames += 1;
+		std::printf("frame %u: %llu allocation(s), %llu bytes:", frame,
+			(unsigned long long)frame_total.allocations, (unsigned long long)frame_total.bytes);
+		for (uint32_t i = 0; i < phase_count; ++i) {
+			if (phases[i].counts.allocations == 0) continue;
+			std::printf(" %s %llu (%llu bytes)", phases[i].name,
+				(unsigned long long)phases[i].counts.allocations, (unsigned long long)phases[i].counts.bytes);
+		}
+		std::printf("\n");
+	}
+	frame += 1;
+}
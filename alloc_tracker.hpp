@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Heap allocation counting for finding per-frame allocations.
+ *
+ * Building with ALLOC_TRACKING defined replaces the global operator new and
+ * delete with versions that count calls and bytes, both in total and per
+ * thread. Without it nothing is hooked and all counts stay zero.
+ *
+ * FrameAllocTracker splits the calling thread's counts into frames and
+ * named phases within a frame, and reports frames that allocate once
+ * warm-up is over. (Helper threads -- e.g. the level loader -- allocate as
+ * they please; only the thread running the frame is checked.)
+ */
+
+struct AllocCounts {
+	uint64_t allocations = 0;
+	uint64_t bytes = 0;
+	uint64_t frees = 0;
+};
+
+//true when built with ALLOC_TRACKING:
+bool alloc_tracking_enabled();
+
+//totals since startup, over all threads:
+AllocCounts alloc_counts();
+
+//totals since startup, for the calling thread only:
+AllocCounts thread_alloc_counts();
+
+struct FrameAllocTracker {
+	//frames before this one are allowed to allocate (buffers growing to size):
+	uint32_t warmup_frames = 120;
+
+	void begin_frame();
+	//end the current phase and start 'name' (a string literal; it is not copied):
+	void phase(char const *name);
+	//close the frame; reports it if it allocated after warm-up without being excused:
+	void end_frame();
+
+	//the current frame allocates on purpose (e.g. a level load) and is not reported:
+	void excuse_frame() { excused = true; }
+
+	uint32_t frame = 0;
+	uint32_t failed_frames = 0; //frames reported so far
+
+private:
+	enum { MaxPhases = 16 };
+	struct Phase {
+		char const *name;
+		AllocCounts counts;
+	};
+	void close_phase();
+
+	Phase phases[MaxPhases];
+	uint32_t phase_count = 0;
+	AllocCounts phase_start;
+	bool excused = false;
+};
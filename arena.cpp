@@ -0,0 +1,69 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <new>
+
+Arena::Arena(size_t block_size_) : block_size(block_size_) {
+}
+
+Arena::~Arena() {
+	for (auto const &block : blocks) {
+		::operator delete(block.data);
+	}
+}
+
+void Arena::add_block(size_t size) {
+	Block block;
+	block.data = static_cast< uint8_t * >(::operator new(size));
+	block.size = size;
+	blocks.emplace_back(block);
+	used = 0;
+	current.capacity += size;
+	current.blocks += 1;
+}
+
+void Arena::reserve(size_t bytes) {
+	if (!blocks.empty() && blocks[0].size >= bytes) return;
+	//only possible while nothing is allocated; otherwise the next reset() grows the block:
+	if (current.allocations != 0) return;
+	reset();
+	if (!blocks.empty()) {
+		current.capacity -= blocks[0].size;
+		current.blocks -= 1;
+		::operator delete(blocks[0].data);
+		blocks.clear();
+	}
+	add_block(std::max(bytes, block_size));
+}
+
+void *Arena::allocate(size_t bytes, size_t align) {
+	if (bytes == 0) bytes = 1;
+	if (!blocks.empty()) {
+		uintptr_t base = reinterpret_cast< uintptr_t >(blocks.back().data);
+		size_t at = ((base + used + align - 1) & ~uintptr_t(align - 1)) - base;
+		if (at + bytes <= blocks.back().size) {
+			current.bytes += (at - used) + bytes;
+			current.allocations += 1;
+			used = at + bytes;
+			return blocks.back().data + at;
+		}
+	}
+	add_block(std::max(bytes + align, block_size));
+	return allocate(bytes, align);
+}
+
+void Arena::reset() {
+	if (blocks.size() > 1) {
+		//overflowed: replace everything with one block big enough for the whole load
+		size_t high_water = current.bytes;
+		for (auto const &block : blocks) {
+			::operator delete(block.data);
+		}
+		blocks.clear();
+		current = Stats();
+		add_block(std::max(high_water, block_size));
+	}
+	used = 0;
+	current.bytes = 0;
+	current.allocations = 0;
+}
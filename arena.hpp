@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Bump allocator for memory that lives and dies together (e.g. everything
+ * belonging to one level).
+ *
+ * allocate() advances a cursor through the current block, starting a new
+ * block when it runs out; individual frees do nothing. reset() releases
+ * everything at once: the first block is kept (and grown to the previous
+ * high-water mark if the arena overflowed), the rest are freed.
+ */
+
+struct Arena {
+	explicit Arena(size_t block_size = 64 * 1024);
+	~Arena();
+
+	Arena(Arena const &) = delete;
+	Arena &operator=(Arena const &) = delete;
+
+	//make sure the first 'bytes' allocated after a reset() come from one block:
+	void reserve(size_t bytes);
+
+	void *allocate(size_t bytes, size_t align);
+
+	//forget every allocation (O(1) unless the arena had overflowed into extra blocks):
+	void reset();
+
+	struct Stats {
+		size_t bytes = 0;       //handed out since the last reset, padding included
+		size_t allocations = 0; //allocate() calls since the last reset
+		size_t capacity = 0;    //bytes held in blocks
+		size_t blocks = 0;
+	};
+	Stats const &stats() const { return current; }
+
+private:
+	struct Block {
+		uint8_t *data;
+		size_t size;
+	};
+	void add_block(size_t size);
+
+	size_t block_size;
+	std::vector< Block > blocks;
+	size_t used = 0; //bytes used in blocks.back()
+	Stats current;
+};
+
+//std-style allocator drawing from an Arena (deallocate is a no-op):
+template< typename T >
+struct ArenaAllocator {
+	typedef T value_type;
+
+	explicit ArenaAllocator(Arena *arena_) : arena(arena_) { }
+	template< typename U >
+	ArenaAllocator(ArenaAllocator< U > const &other) : arena(other.arena) { }
+
+	T *allocate(size_t n) {
+		return static_cast< T * >(arena->allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T *, size_t) { }
+
+	Arena *arena;
+};
+
+template< typename T, typename U >
+bool operator==(ArenaAllocator< T > const &a, ArenaAllocator< U > const &b) { return a.arena == b.arena; }
+template< typename T, typename U >
+bool operator!=(ArenaAllocator< T > const &a, ArenaAllocator< U > const &b) { return a.arena != b.arena; }
+
+template< typename T >
+using ArenaVector = std::vector< T, ArenaAllocator< T > >;
@@ -0,0 +1,229 @@
+#include "asset_pack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ASSET_PACK_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LOG_ERROR( X ) std::cerr << X << std::endl
+
+static const size_t EntryAlign = 16;
+static const size_t MapAtLeast = 16 * 1024;
+
+MappedFile::MappedFile() {
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+void MappedFile::close() {
+#ifdef ASSET_PACK_MMAP
+	if (mapped) munmap(const_cast< char * >(base), length);
+#endif
+	contents.clear();
+	base = nullptr;
+	length = 0;
+	mapped = false;
+}
+
+//whole file into 'out' (one read):
+static bool read_file(std::string const &filename, std::vector< char > *out) {
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	if (!file) return false;
+	file.seekg(0, std::ios::end);
+	std::streamoff size = file.tellg();
+	if (size < 0) return false;
+	file.seekg(0, std::ios::beg);
+	out->resize(size_t(size));
+	return size == 0 || bool(file.read(&(*out)[0], size));
+}
+
+bool MappedFile::open(std::string const &filename) {
+	close();
+
+#ifdef ASSET_PACK_MMAP
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	struct stat info;
+	if (fstat(fd, &info) == 0 && size_t(info.st_size) >= MapAtLeast) {
+		void *at = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (at != MAP_FAILED) {
+			base = static_cast< char const * >(at);
+			length = size_t(info.st_size);
+			mapped = true;
+			//whole files are wanted right away; let the kernel read ahead:
+			madvise(at, length, MADV_WILLNEED);
+		}
+	}
+	::close(fd);
+#endif
+	if (!mapped) {
+		if (!read_file(filename, &contents)) return false;
+		base = contents.data();
+		length = contents.size();
+	}
+	return true;
+}
+
+bool AssetPack::open(std::string const &filename) {
+	entries.clear();
+	if (!file.open(filename)) return false;
+	char const *base = file.data();
+	size_t length = file.size();
+
+	auto fail = [&](char const *why) {
+		LOG_ERROR("  '" << filename << "' " << why << ".");
+		entries.clear();
+		file.close();
+		return false;
+	};
+	if (length < 12 || std::memcmp(base, "APK1", 4) != 0) return fail("is not an asset pack");
+	uint32_t count, table_size;
+	std::memcpy(&count, base + 4, 4);
+	std::memcpy(&table_size, base + 8, 4);
+	if (table_size > length - 12) return fail("has a truncated table");
+	//(every entry takes at least 20 bytes, so a bad count fails here, not in reserve())
+	if (count > table_size / 20) return fail("has more entries than its table holds");
+
+	char const *at = base + 12;
+	char const *table_end = at + table_size;
+	entries.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t name_length;
+		Entry entry;
+		if (table_end - at < 20) return fail("has a truncated table");
+		std::memcpy(&entry.offset, at, 8);
+		std::memcpy(&entry.size, at + 8, 8);
+		std::memcpy(&name_length, at + 16, 4);
+		at += 20;
+		size_t padded = (size_t(name_length) + 3) & ~size_t(3);
+		if (size_t(table_end - at) < padded) return fail("has a truncated table");
+		entry.name.assign(at, name_length);
+		at += padded;
+		if (entry.offset > length || entry.size > length - entry.offset) return fail("has an entry past its end");
+		entries.emplace_back(std::move(entry));
+	}
+	std::sort(entries.begin(), entries.end(), [](Entry const &a, Entry const &b) { return a.name < b.name; });
+	return true;
+}
+
+bool AssetPack::find(std::string const &name, char const **data, size_t *size) const {
+	auto entry = std::lower_bound(entries.begin(), entries.end(), name, [](Entry const &e, std::string const &n) { return e.name < n; });
+	if (entry == entries.end() || entry->name != name) return false;
+	*data = file.data() + entry->offset;
+	*size = size_t(entry->size);
+	return true;
+}
+
+bool write_asset_pack(std::string const &filename, std::vector< std::string > const &names_) {
+	std::vector< std::string > names = names_;
+	std::sort(names.begin(), names.end());
+	names.erase(std::unique(names.begin(), names.end()), names.end());
+
+	std::vector< std::string > packed;
+	std::vector< std::vector< char > > data;
+	for (auto const &name : names) {
+		std::vector< char > bytes;
+		if (!read_file(name, &bytes)) {
+			LOG_ERROR("  cannot read '" << name << "'; leaving it out (the game will look for it as a loose file).");
+			continue;
+		}
+		packed.emplace_back(name);
+		data.emplace_back(std::move(bytes));
+	}
+
+	uint32_t table_size = 0;
+	for (auto const &name : packed) {
+		table_size += 20 + ((uint32_t(name.size()) + 3) & ~3U);
+	}
+	auto align = [](uint64_t offset) { return (offset + EntryAlign - 1) & ~uint64_t(EntryAlign - 1); };
+
+	std::ofstream file(filename.c_str(), std::ios::binary);
+	if (!file) {
+		LOG_ERROR("  cannot open '" << filename << "' for writing.");
+		return false;
+	}
+	uint32_t count = uint32_t(packed.size());
+	file.write("APK1", 4);
+	file.write(reinterpret_cast< char const * >(&count), 4);
+	file.write(reinterpret_cast< char const * >(&table_size), 4);
+
+	uint64_t offset = align(12 + table_size);
+	for (size_t i = 0; i < packed.size(); ++i) {
+		uint64_t size = data[i].size();
+		uint32_t name_length = uint32_t(packed[i].size());
+		static const char zeros[EntryAlign] = { };
+		file.write(reinterpret_cast< char const * >(&offset), 8);
+		file.write(reinterpret_cast< char const * >(&size), 8);
+		file.write(reinterpret_cast< char const * >(&name_length), 4);
+		file.write(packed[i].data(), name_length);
+		file.write(zeros, ((name_length + 3) & ~3U) - name_length);
+		offset = align(offset + size);
+	}
+
+	uint64_t written = 12 + table_size;
+	for (auto const &bytes : data) {
+		static const char zeros[EntryAlign] = { };
+		file.write(zeros, std::streamsize(align(written) - written));
+		written = align(written);
+		if (!bytes.empty()) file.write(bytes.data(), bytes.size());
+		written += bytes.size();
+	}
+	if (!file) {
+		LOG_ERROR("  error writing '" << filename << "'.");
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------
+
+static AssetPack const *pack_in_use = nullptr;
+
+void use_asset_pack(AssetPack const *pack) {
+	pack_in_use = pack;
+}
+
+bool asset_pack_in_use() {
+	return pack_in_use != nullptr;
+}
+
+bool load_asset(std::string const &name, AssetBytes *bytes) {
+	bytes->file.close();
+	if (pack_in_use && pack_in_use->find(name, &bytes->data, &bytes->size)) {
+		return true;
+	}
+	if (!bytes->file.open(name)) return false;
+	bytes->data = bytes->file.data();
+	bytes->size = bytes->file.size();
+	return true;
+}
+
+AssetStreamBuffer::AssetStreamBuffer(AssetBytes const &bytes) {
+	char *begin = const_cast< char * >(bytes.data); //only ever read
+	setg(begin, begin, begin + bytes.size);
+}
+
+AssetStreamBuffer::pos_type AssetStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+	if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+	off_type at;
+	if (dir == std::ios_base::beg) at = off;
+	else if (dir == std::ios_base::cur) at = (gptr() - eback()) + off;
+	else at = (egptr() - eback()) + off;
+	if (at < 0 || at > egptr() - eback()) return pos_type(off_type(-1));
+	setg(eback(), eback() + at, egptr());
+	return pos_type(at);
+}
+
+AssetStreamBuffer::pos_type AssetStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which) {
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Asset packs: the game's data files gathered into one file, so a cold start
+ * is one open and (mostly) sequential reads instead of a seek per file.
+ *
+ * Entries are named by the path the game opens them with, relative to dist/
+ * (e.g. "atlas.manifest", "level0/chunk2.txt", "../sounds/step.wav").
+ * load_asset() looks a name up in the pack in use and falls back to the loose
+ * file, so a pack can leave things out (or be missing entirely).
+ *
+ * File layout (little-endian):
+ *   "APK1"
+ *   uint32 entry count
+ *   uint32 table size in bytes
+ *   table: per entry, sorted by name:
+ *     uint64 offset (from the start of the file), uint64 size,
+ *     uint32 name length, name bytes (zero-padded to a multiple of 4)
+ *   entry data, each entry starting on a 16-byte boundary
+ *
+ * The pack is mapped into memory (read into it where mmap is unavailable),
+ * so entries are read in place. Loose files are mapped the same way.
+ */
+
+//A whole file in memory: mapped read-only where possible, else read in.
+//Small files are always read (cheaper than setting up a mapping, and immune
+//to the file being truncated under us, e.g. by an editor saving a level):
+struct MappedFile {
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(MappedFile const &) = delete;
+	MappedFile &operator=(MappedFile const &) = delete;
+
+	bool open(std::string const &filename);
+	void close();
+
+	char const *data() const { return base; }
+	size_t size() const { return length; }
+
+private:
+	char const *base = nullptr;
+	size_t length = 0;
+	bool mapped = false;
+	std::vector< char > contents; //when the file could not be mapped
+};
+
+struct AssetPack {
+	AssetPack() { }
+	AssetPack(AssetPack const &) = delete;
+	AssetPack &operator=(AssetPack const &) = delete;
+
+	//map 'filename' and read its table; false (and logs) if it is missing or malformed:
+	bool open(std::string const &filename);
+
+	//bytes of entry 'name' (valid while the pack is open); false if there is no such entry:
+	bool find(std::string const &name, char const **data, size_t *size) const;
+
+	size_t size() const { return entries.size(); }
+
+private:
+	struct Entry {
+		std::string name;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	MappedFile file;
+	std::vector< Entry > entries; //sorted by name
+};
+
+//Write a pack of the files named in 'names' (read from disk, relative to the
+//working directory). Missing files are left out with a warning.
+bool write_asset_pack(std::string const &filename, std::vector< std::string > const &names);
+
+//------------------------------------------------------------------
+//Loading by name:
+
+//Make 'pack' (or nullptr for none) the first place load_asset() looks:
+void use_asset_pack(AssetPack const *pack);
+bool asset_pack_in_use();
+
+//An asset's bytes, read-only: pointing into the pack or into 'file':
+struct AssetBytes {
+	char const *data = nullptr;
+	size_t size = 0;
+	MappedFile file;
+};
+
+//find asset 'name' in the pack in use, or map the file of that name (no copies either way):
+bool load_asset(std::string const &name, AssetBytes *bytes);
+
+//An istream over an asset's bytes (no copy), for loaders written against streams:
+struct AssetStreamBuffer : std::streambuf {
+	explicit AssetStreamBuffer(AssetBytes const &bytes);
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+struct AssetStream : private AssetStreamBuffer, public std::istream {
+	explicit AssetStream(AssetBytes const &bytes) : AssetStreamBuffer(bytes), std::istream(static_cast< AssetStreamBuffer * >(this)) { }
+};
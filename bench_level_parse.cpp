@@ -0,0 +1,167 @@
+//bench_level_parse: measure level chunk parsing throughput.
+//Writes a generated chunk file of the given size, then parses it repeatedly with
+//load_level_chunk (text_scan.hpp) and with a line-by-line iostream parser for
+//comparison, checking that both read the same values.
+//
+//  usage: bench_level_parse [megabytes (default 8)] [scratch file (default bench_chunk.txt)]
+
+#include "level_stream.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+//the iostream way: getline, strip the comment, then >> each value:
+static bool load_level_chunk_iostream(std::string const &filename, uint32_t index, float chunk_width, LevelChunk *chunk) {
+	*chunk = LevelChunk();
+	chunk->index = index;
+	std::ifstream file(filename.c_str());
+	if (!file) return false;
+	float left = index * chunk_width;
+
+	std::string line;
+	while (std::getline(file, line)) {
+		std::string::size_type comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+		std::istringstream in(line);
+		std::string kind;
+		if (!(in >> kind)) continue;
+
+		bool ok = false;
+		if (kind == "platform") {
+			PlatformSpec p;
+			ok = bool(in >> p.pos.x >> p.pos.y >> p.size.x >> p.size.y);
+			p.pos.x += left;
+			chunk->platforms.emplace_back(p);
+		} else if (kind == "enemy") {
+			EnemySpec e;
+			ok = bool(in >> e.pos.x >> e.pos.y
+				>> e.waypoints[0].x >> e.waypoints[0].y >> e.waypoints[1].x >> e.waypoints[1].y
+				>> e.flashlight_size.x >> e.flashlight_size.y);
+			e.pos.x += left;
+			e.waypoints[0].x += left;
+			e.waypoints[1].x += left;
+			chunk->enemies.emplace_back(e);
+		} else if (kind == "light") {
+			LightSpec l;
+			ok = bool(in >> l.pos.x >> l.pos.y >> l.size.x >> l.size.y >> l.dir);
+			uint32_t c[4];
+			if (ok && (in >> c[0])) { //optional color, then softness
+				ok = bool(in >> c[1] >> c[2] >> c[3]);
+				l.color = glm::u8vec4(c[0], c[1], c[2], c[3]);
+				float softness;
+				if (ok && (in >> softness)) l.softness = softness;
+			}
+			l.pos.x += left;
+			chunk->lights.emplace_back(l);
+		} else if (kind == "door") {
+			DoorSpec d;
+			ok = bool(in >> d.pos.x >> d.pos.y);
+			d.pos.x += left;
+			chunk->doors.emplace_back(d);
+		} else if (kind == "ladder") {
+			LadderSpec l;
+			ok = bool(in >> l.pos.x >> l.pos.y >> l.height);
+			l.pos.x += left;
+			chunk->ladders.emplace_back(l);
+		}
+		if (!ok) return false;
+	}
+	return true;
+}
+
+template< typename T >
+static bool same_specs(std::vector< T > const &a, std::vector< T > const &b) {
+	return a.size() == b.size() && (a.empty() || memcmp(&a[0], &b[0], sizeof(T) * a.size()) == 0);
+}
+
+int main(int argc, char **argv) {
+	double megabytes = (argc > 1 ? std::atof(argv[1]) : 8.0);
+	std::string filename = (argc > 2 ? argv[2] : "bench_chunk.txt");
+	if (!(megabytes > 0.0)) {
+		std::cerr << "usage: " << argv[0] << " [megabytes] [scratch file]" << std::endl;
+		return 1;
+	}
+
+	//generate a chunk in the style of the real ones (a mix of records, short decimals, some comments):
+	size_t bytes = 0;
+	{
+		std::ofstream file(filename.c_str(), std::ios::binary);
+		if (!file) {
+			std::cerr << "cannot write '" << filename << "'." << std::endl;
+			return 1;
+		}
+		std::mt19937 rng(0x1e7e1);
+		std::uniform_int_distribution< int > quarters(0, 40);
+		std::uniform_real_distribution< float > unit(0.0f, 1.0f);
+		auto q = [&]() { return 0.25f * quarters(rng); };
+		char line[256];
+		size_t target = size_t(megabytes * 1024.0 * 1024.0);
+		for (uint32_t n = 0; bytes < target; ++n) {
+			int length = 0;
+			switch (n % 8) {
+				case 0: case 1: case 2:
+					length = snprintf(line, sizeof(line), "platform %.2f %.2f %.1f %.2f\n", q(), q(), q(), unit(rng));
+					break;
+				case 3:
+					length = snprintf(line, sizeof(line), "enemy %.2f %.2f %.2f %.2f %.2f %.2f %.3f %.3f # patrol %u\n", q(), q(), q(), q(), q(), q(), unit(rng), unit(rng), n);
+					break;
+				case 4:
+					if (n % 16 == 4) {
+						length = snprintf(line, sizeof(line), "light %.2f %.2f %.2f %.2f %.6g\n", q(), q(), q(), q(), 2.0f * unit(rng));
+					} else { //(colored, soft)
+						length = snprintf(line, sizeof(line), "light %.2f %.2f %.2f %.2f %.6g 255 %u 120 136 %.2f\n", q(), q(), q(), q(), 2.0f * unit(rng), n % 256, 0.25f * unit(rng));
+					}
+					break;
+				case 5:
+					length = snprintf(line, sizeof(line), "door %.2f %.2f\n", q(), q());
+					break;
+				case 6:
+					length = snprintf(line, sizeof(line), "ladder %.2f %.2f %.2f\n", q(), q(), q());
+					break;
+				case 7:
+					length = snprintf(line, sizeof(line), "\n# section %u\n", n / 8);
+					break;
+			}
+			file.write(line, length);
+			bytes += size_t(length);
+		}
+	}
+
+	auto time = [&](char const *name, bool (*load)(std::string const &, uint32_t, float, LevelChunk *), LevelChunk *chunk) {
+		double best = 1e30;
+		for (uint32_t run = 0; run < 5; ++run) {
+			auto before = std::chrono::high_resolution_clock::now();
+			if (!load(filename, 3, 10.0f, chunk)) {
+				std::cerr << name << ": failed to parse '" << filename << "'." << std::endl;
+				exit(1);
+			}
+			double seconds = std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+			best = std::min(best, seconds);
+		}
+		std::cout << name << ": " << (double(bytes) / (1024.0 * 1024.0)) / best << " MB/s (" << best * 1000.0 << " ms best of 5)." << std::endl;
+		return best;
+	};
+
+	LevelChunk scanned, streamed;
+	std::cout << "Parsing " << double(bytes) / (1024.0 * 1024.0) << " MB of generated chunk records." << std::endl;
+	double fast = time("text_scan", &load_level_chunk, &scanned);
+	double slow = time("iostream ", &load_level_chunk_iostream, &streamed);
+	std::cout << "Speedup: " << slow / fast << "x." << std::endl;
+
+	bool same = same_specs(scanned.platforms, streamed.platforms) && same_specs(scanned.enemies, streamed.enemies)
+		&& same_specs(scanned.lights, streamed.lights) && same_specs(scanned.doors, streamed.doors)
+		&& same_specs(scanned.ladders, streamed.ladders);
+	std::remove(filename.c_str());
+	if (!same) {
+		std::cerr << "The parsers disagree!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,93 @@
+//bench_sprite_batch: measure sprite vertex generation throughput.
+//Generates sprite records like a frame's (mostly unrotated; trimmed, mirrored and
+//tinted ones mixed in), then turns them into vertices repeatedly with emit_sprites
+//(sprite_batch.hpp) and with the one-call-per-sprite code it replaced, checking that
+//both make the same vertices. Built with COMPACT_VERTICES, measures that layout.
+//
+//  usage: bench_sprite_batch [sprites (default 10000)] [rotated percent (default 2)]
+
+#include "sprite_batch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+//the old way: cos/sin and six emplace_backs for every sprite, whatever its angle:
+static void draw_sprite(SpriteRecord const &r, std::vector< SpriteVertex > *verts_) {
+	std::vector< SpriteVertex > &verts = *verts_;
+	glm::vec2 right = glm::vec2(std::cos(r.angle), std::sin(r.angle));
+	glm::vec2 up = glm::vec2(-right.y, right.x);
+	glm::vec2 lo = r.size * (r.inset_min - 0.5f);
+	glm::vec2 hi = r.size * (0.5f - r.inset_max);
+	verts.emplace_back(r.at + right * lo.x + up * lo.y, glm::vec2(r.min_uv.x, r.min_uv.y), r.tint);
+	verts.emplace_back(verts.back());
+	verts.emplace_back(r.at + right * lo.x + up * hi.y, glm::vec2(r.min_uv.x, r.max_uv.y), r.tint);
+	verts.emplace_back(r.at + right * hi.x + up * lo.y, glm::vec2(r.max_uv.x, r.min_uv.y), r.tint);
+	verts.emplace_back(r.at + right * hi.x + up * hi.y, glm::vec2(r.max_uv.x, r.max_uv.y), r.tint);
+	verts.emplace_back(verts.back());
+}
+
+int main(int argc, char **argv) {
+	int sprites = (argc > 1 ? std::atoi(argv[1]) : 10000);
+	double rotated_percent = (argc > 2 ? std::atof(argv[2]) : 2.0);
+	if (sprites <= 0 || !(rotated_percent >= 0.0 && rotated_percent <= 100.0)) {
+		std::cerr << "usage: " << argv[0] << " [sprites] [rotated percent]" << std::endl;
+		return 1;
+	}
+
+	std::vector< SpriteRecord > records(sprites);
+	{
+		std::mt19937 rng(0x5b17e);
+		std::uniform_real_distribution< float > unit(0.0f, 1.0f);
+		for (auto &r : records) {
+			r.at = glm::vec2(unit(rng) - 0.5f, unit(rng) - 0.5f) * glm::vec2(12.0f, 8.0f);
+			r.size = glm::vec2(0.25f + unit(rng), 0.25f + unit(rng));
+			if (unit(rng) < 0.5f) r.size.x = -r.size.x; //(facing left)
+			r.inset_min = (unit(rng) < 0.5f ? glm::vec2(0.0f) : glm::vec2(unit(rng), unit(rng)) * 0.2f);
+			r.inset_max = (unit(rng) < 0.5f ? glm::vec2(0.0f) : glm::vec2(unit(rng), unit(rng)) * 0.2f);
+			r.min_uv = glm::vec2(unit(rng), unit(rng)) * 0.9f;
+			r.max_uv = r.min_uv + glm::vec2(0.1f * unit(rng), 0.1f * unit(rng));
+			r.tint = glm::u8vec4(0x34, 0x4c, 0x73, 0x88);
+			r.angle = (unit(rng) * 100.0f < rotated_percent ? 6.2831853f * unit(rng) : 0.0f);
+		}
+	}
+
+	//each run makes all the vertices into a cleared vector (as a frame does, once the vector has grown):
+	uint32_t const runs = std::max(1, 20000000 / sprites);
+	auto time = [&](char const *name, void (*make)(std::vector< SpriteRecord > const &, std::vector< SpriteVertex > *), std::vector< SpriteVertex > *verts) {
+		double best = 1e30;
+		for (uint32_t round = 0; round < 5; ++round) {
+			auto before = std::chrono::high_resolution_clock::now();
+			for (uint32_t run = 0; run < runs; ++run) {
+				verts->clear();
+				make(records, verts);
+			}
+			double seconds = std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+			best = std::min(best, seconds);
+		}
+		std::cout << name << ": " << (double(sprites) * runs) / (best * 1e6) << " sprites/us (" << best * 1e6 / runs << " us per " << sprites << " sprites, best of 5)." << std::endl;
+		return best;
+	};
+
+	std::vector< SpriteVertex > batched, per_call;
+	std::cout << sprites << " sprites, " << rotated_percent << "% rotated, " << sizeof(SpriteVertex) << "-byte vertices." << std::endl;
+	double fast = time("emit_sprites", [](std::vector< SpriteRecord > const &records, std::vector< SpriteVertex > *verts) {
+		emit_sprites(records.data(), records.size(), verts);
+	}, &batched);
+	double slow = time("per call    ", [](std::vector< SpriteRecord > const &records, std::vector< SpriteVertex > *verts) {
+		for (auto const &r : records) {
+			draw_sprite(r, verts);
+		}
+	}, &per_call);
+	std::cout << "Speedup: " << slow / fast << "x." << std::endl;
+
+	if (batched.size() != per_call.size() || memcmp(batched.data(), per_call.data(), sizeof(SpriteVertex) * batched.size()) != 0) {
+		std::cerr << "The vertices differ!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,469 @@
+#include "block_compress.hpp"
+
+#include "asset_pack.hpp"
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define LOG_ERROR( X ) std::cerr << X << std::endl
+
+uint32_t block_bytes(BlockFormat format) {
+	return (format == BlockBC3 ? 16 : 8);
+}
+
+//------------------------------------------------------------------
+//single-channel (BC4 / BC3 alpha) blocks:
+
+static void channel_palette(uint8_t a0, uint8_t a1, uint8_t palette[8]) {
+	palette[0] = a0;
+	palette[1] = a1;
+	if (a0 > a1) {
+		for (int i = 1; i < 7; ++i) {
+			palette[i + 1] = uint8_t(((7 - i) * a0 + i * a1 + 3) / 7);
+		}
+	} else {
+		for (int i = 1; i < 5; ++i) {
+			palette[i + 1] = uint8_t(((5 - i) * a0 + i * a1 + 2) / 5);
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+//pick the nearest palette entry for every value; returns the summed squared error:
+static uint32_t channel_indices(uint8_t const values[16], uint8_t a0, uint8_t a1, uint8_t indices[16]) {
+	uint8_t palette[8];
+	channel_palette(a0, a1, palette);
+	uint32_t total = 0;
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int best_err = 256 * 256;
+		for (int p = 0; p < 8; ++p) {
+			int d = int(values[i]) - int(palette[p]);
+			if (d * d < best_err) {
+				best_err = d * d;
+				best = p;
+			}
+		}
+		indices[i] = uint8_t(best);
+		total += best_err;
+	}
+	return total;
+}
+
+static void encode_channel_block(uint8_t const values[16], BlockQuality quality, uint8_t out[8]) {
+	uint8_t lo = 255, hi = 0;
+	for (int i = 0; i < 16; ++i) {
+		lo = std::min(lo, values[i]);
+		hi = std::max(hi, values[i]);
+	}
+
+	//eight interpolated values between the extremes:
+	uint8_t a0 = hi, a1 = lo;
+	uint8_t indices[16];
+	uint32_t err = channel_indices(values, a0, a1, indices);
+
+	//six values between the extremes excluding 0 and 255, which get exact codes:
+	if (quality >= BlockQualityNormal && err != 0) {
+		uint8_t lo6 = 255, hi6 = 0;
+		for (int i = 0; i < 16; ++i) {
+			if (values[i] == 0 || values[i] == 255) continue;
+			lo6 = std::min(lo6, values[i]);
+			hi6 = std::max(hi6, values[i]);
+		}
+		if (lo6 > hi6) {
+			lo6 = hi6 = 0;
+		}
+		uint8_t indices6[16];
+		uint32_t err6 = channel_indices(values, lo6, hi6, indices6);
+		if (err6 < err) {
+			a0 = lo6;
+			a1 = hi6;
+			err = err6;
+			std::memcpy(indices, indices6, 16);
+		}
+	}
+
+	out[0] = a0;
+	out[1] = a1;
+	uint64_t bits = 0;
+	for (int i = 0; i < 16; ++i) {
+		bits |= uint64_t(indices[i]) << (3 * i);
+	}
+	for (int b = 0; b < 6; ++b) {
+		out[2 + b] = uint8_t(bits >> (8 * b));
+	}
+}
+
+static void decode_channel_block(uint8_t const in[8], uint8_t values[16]) {
+	uint8_t palette[8];
+	channel_palette(in[0], in[1], palette);
+	uint64_t bits = 0;
+	for (int b = 0; b < 6; ++b) {
+		bits |= uint64_t(in[2 + b]) << (8 * b);
+	}
+	for (int i = 0; i < 16; ++i) {
+		values[i] = palette[(bits >> (3 * i)) & 0x7];
+	}
+}
+
+//------------------------------------------------------------------
+//color (BC1-style, always four-color in BC3) blocks:
+
+static uint16_t pack_565(float r, float g, float b) {
+	int ri = std::max(0, std::min(31, int(std::floor(r * (31.0f / 255.0f) + 0.5f))));
+	int gi = std::max(0, std::min(63, int(std::floor(g * (63.0f / 255.0f) + 0.5f))));
+	int bi = std::max(0, std::min(31, int(std::floor(b * (31.0f / 255.0f) + 0.5f))));
+	return uint16_t((ri << 11) | (gi << 5) | bi);
+}
+
+static void unpack_565(uint16_t c, float rgb[3]) {
+	int r = (c >> 11) & 0x1f, g = (c >> 5) & 0x3f, b = c & 0x1f;
+	rgb[0] = float((r << 3) | (r >> 2));
+	rgb[1] = float((g << 2) | (g >> 4));
+	rgb[2] = float((b << 3) | (b >> 2));
+}
+
+static void color_palette(uint16_t c0, uint16_t c1, float palette[4][3]) {
+	unpack_565(c0, palette[0]);
+	unpack_565(c1, palette[1]);
+	for (int c = 0; c < 3; ++c) {
+		palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+		palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+	}
+}
+
+//nearest palette entry for all 16 pixels (given as r[16], g[16], b[16]):
+static void color_indices(float const r[16], float const g[16], float const b[16], float const palette[4][3], uint8_t indices[16]) {
+#ifdef __SSE2__
+	for (int i = 0; i < 16; i += 4) {
+		__m128 pr = _mm_loadu_ps(r + i);
+		__m128 pg = _mm_loadu_ps(g + i);
+		__m128 pb = _mm_loadu_ps(b + i);
+		__m128 best = _mm_set1_ps(1e30f);
+		__m128i best_index = _mm_setzero_si128();
+		for (int p = 0; p < 4; ++p) {
+			__m128 dr = _mm_sub_ps(pr, _mm_set1_ps(palette[p][0]));
+			__m128 dg = _mm_sub_ps(pg, _mm_set1_ps(palette[p][1]));
+			__m128 db = _mm_sub_ps(pb, _mm_set1_ps(palette[p][2]));
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+			__m128i closer = _mm_castps_si128(_mm_cmplt_ps(d, best));
+			best = _mm_min_ps(d, best);
+			best_index = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(p)), _mm_andnot_si128(closer, best_index));
+		}
+		int32_t lanes[4];
+		_mm_storeu_si128(reinterpret_cast< __m128i * >(lanes), best_index);
+		for (int l = 0; l < 4; ++l) {
+			indices[i + l] = uint8_t(lanes[l]);
+		}
+	}
+#else
+	for (int i = 0; i < 16; ++i) {
+		float best = 1e30f;
+		for (int p = 0; p < 4; ++p) {
+			float dr = r[i] - palette[p][0], dg = g[i] - palette[p][1], db = b[i] - palette[p][2];
+			float d = dr * dr + dg * dg + db * db;
+			if (d < best) {
+				best = d;
+				indices[i] = uint8_t(p);
+			}
+		}
+	}
+#endif
+}
+
+static void encode_color_block(float const r[16], float const g[16], float const b[16], float const w[16], BlockQuality quality, uint8_t out[8]) {
+	float const *ch[3] = { r, g, b };
+	float total_w = 0.0f;
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	float lo[3] = { 255.0f, 255.0f, 255.0f };
+	float hi[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; ++i) {
+		if (w[i] == 0.0f) continue;
+		total_w += w[i];
+		for (int c = 0; c < 3; ++c) {
+			mean[c] += w[i] * ch[c][i];
+			lo[c] = std::min(lo[c], ch[c][i]);
+			hi[c] = std::max(hi[c], ch[c][i]);
+		}
+	}
+	if (total_w == 0.0f) {
+		std::memset(out, 0, 8);
+		return;
+	}
+	for (int c = 0; c < 3; ++c) mean[c] /= total_w;
+
+	float e0[3], e1[3];
+	if (quality == BlockQualityFast) {
+		//bounding box, pulled in a little to center the interpolants:
+		for (int c = 0; c < 3; ++c) {
+			float inset = (hi[c] - lo[c]) / 16.0f;
+			e0[c] = hi[c] - inset;
+			e1[c] = lo[c] + inset;
+		}
+	} else {
+		//principal axis by power iteration on the covariance:
+		float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; ++i) {
+			if (w[i] == 0.0f) continue;
+			float d[3] = { r[i] - mean[0], g[i] - mean[1], b[i] - mean[2] };
+			cov[0] += w[i] * d[0] * d[0]; cov[1] += w[i] * d[0] * d[1]; cov[2] += w[i] * d[0] * d[2];
+			cov[3] += w[i] * d[1] * d[1]; cov[4] += w[i] * d[1] * d[2]; cov[5] += w[i] * d[2] * d[2];
+		}
+		float axis[3] = { hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2] };
+		for (int it = 0; it < 8; ++it) {
+			float n[3] = {
+				cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+				cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+				cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+			};
+			float len = std::max(std::fabs(n[0]), std::max(std::fabs(n[1]), std::fabs(n[2])));
+			if (len == 0.0f) break;
+			for (int c = 0; c < 3; ++c) axis[c] = n[c] / len;
+		}
+		float len2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+		float t_lo = 0.0f, t_hi = 0.0f;
+		if (len2 > 0.0f) {
+			t_lo = 1e30f;
+			t_hi = -1e30f;
+			for (int i = 0; i < 16; ++i) {
+				if (w[i] == 0.0f) continue;
+				float t = ((r[i] - mean[0]) * axis[0] + (g[i] - mean[1]) * axis[1] + (b[i] - mean[2]) * axis[2]) / len2;
+				t_lo = std::min(t_lo, t);
+				t_hi = std::max(t_hi, t);
+			}
+		}
+		for (int c = 0; c < 3; ++c) {
+			e0[c] = mean[c] + t_hi * axis[c];
+			e1[c] = mean[c] + t_lo * axis[c];
+		}
+	}
+
+	uint16_t c0 = pack_565(e0[0], e0[1], e0[2]);
+	uint16_t c1 = pack_565(e1[0], e1[1], e1[2]);
+	float palette[4][3];
+	uint8_t indices[16];
+	color_palette(c0, c1, palette);
+	color_indices(r, g, b, palette, indices);
+
+	if (quality == BlockQualityBest) {
+		//least-squares endpoints for the chosen indices, then re-pick indices:
+		static const float weight0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		for (int iteration = 0; iteration < 2; ++iteration) {
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+			for (int i = 0; i < 16; ++i) {
+				if (w[i] == 0.0f) continue;
+				float a = weight0[indices[i]], bw = 1.0f - a;
+				aa += w[i] * a * a; ab += w[i] * a * bw; bb += w[i] * bw * bw;
+				for (int c = 0; c < 3; ++c) {
+					ax[c] += w[i] * a * ch[c][i];
+					bx[c] += w[i] * bw * ch[c][i];
+				}
+			}
+			float det = aa * bb - ab * ab;
+			if (std::fabs(det) < 1e-6f) break;
+			for (int c = 0; c < 3; ++c) {
+				e0[c] = std::max(0.0f, std::min(255.0f, (ax[c] * bb - bx[c] * ab) / det));
+				e1[c] = std::max(0.0f, std::min(255.0f, (bx[c] * aa - ax[c] * ab) / det));
+			}
+			c0 = pack_565(e0[0], e0[1], e0[2]);
+			c1 = pack_565(e1[0], e1[1], e1[2]);
+			color_palette(c0, c1, palette);
+			color_indices(r, g, b, palette, indices);
+		}
+	}
+
+	//keep c0 > c1 so the block also decodes as four-color BC1:
+	if (c0 < c1) {
+		std::swap(c0, c1);
+		static const uint8_t swapped[4] = { 1, 0, 3, 2 };
+		for (int i = 0; i < 16; ++i) indices[i] = swapped[indices[i]];
+	} else if (c0 == c1) {
+		for (int i = 0; i < 16; ++i) indices[i] = 0;
+	}
+
+	uint32_t bits = 0;
+	for (int i = 0; i < 16; ++i) {
+		bits |= uint32_t(indices[i]) << (2 * i);
+	}
+	out[0] = uint8_t(c0); out[1] = uint8_t(c0 >> 8);
+	out[2] = uint8_t(c1); out[3] = uint8_t(c1 >> 8);
+	out[4] = uint8_t(bits); out[5] = uint8_t(bits >> 8); out[6] = uint8_t(bits >> 16); out[7] = uint8_t(bits >> 24);
+}
+
+static void decode_color_block(uint8_t const in[8], uint8_t rgb[16][3]) {
+	uint16_t c0 = uint16_t(in[0] | (in[1] << 8));
+	uint16_t c1 = uint16_t(in[2] | (in[3] << 8));
+	float palette[4][3];
+	color_palette(c0, c1, palette);
+	uint32_t bits = uint32_t(in[4]) | (uint32_t(in[5]) << 8) | (uint32_t(in[6]) << 16) | (uint32_t(in[7]) << 24);
+	for (int i = 0; i < 16; ++i) {
+		float const *p = palette[(bits >> (2 * i)) & 0x3];
+		for (int c = 0; c < 3; ++c) {
+			rgb[i][c] = uint8_t(p[c] + 0.5f);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+
+void compress_blocks(BlockFormat format, BlockQuality quality,
+	uint32_t width, uint32_t height, uint32_t const *pixels,
+	CompressedLevel *level, JobSystem *jobs) {
+
+	uint32_t blocks_x = (width + 3) / 4;
+	uint32_t blocks_y = (height + 3) / 4;
+	uint32_t bytes = block_bytes(format);
+
+	level->width = width;
+	level->height = height;
+	level->data.assign(size_t(blocks_x) * blocks_y * bytes, 0);
+
+	auto encode_rows = [&](uint32_t begin, uint32_t end) {
+		for (uint32_t by = begin; by < end; ++by) {
+			for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+				float r[16], g[16], b[16], w[16];
+				uint8_t a[16];
+				for (uint32_t i = 0; i < 16; ++i) {
+					uint32_t x = std::min(bx * 4 + (i % 4), width - 1);
+					uint32_t y = std::min(by * 4 + (i / 4), height - 1);
+					uint32_t px = pixels[y * width + x];
+					r[i] = float(px & 0xff);
+					g[i] = float((px >> 8) & 0xff);
+					b[i] = float((px >> 16) & 0xff);
+					a[i] = uint8_t(px >> 24);
+					//color under fully transparent texels never shows:
+					w[i] = (a[i] == 0 ? 0.0f : 1.0f);
+				}
+				uint8_t *out = &level->data[(size_t(by) * blocks_x + bx) * bytes];
+				if (format == BlockBC3) {
+					encode_channel_block(a, quality, out);
+					encode_color_block(r, g, b, w, quality, out + 8);
+				} else {
+					uint8_t red[16];
+					for (int i = 0; i < 16; ++i) red[i] = uint8_t(r[i]);
+					encode_channel_block(red, quality, out);
+				}
+			}
+		}
+	};
+
+	if (jobs) {
+		jobs->parallel_for(blocks_y, 4, encode_rows);
+	} else {
+		encode_rows(0, blocks_y);
+	}
+}
+
+void decompress_blocks(BlockFormat format, CompressedLevel const &level, std::vector< uint32_t > *pixels) {
+	uint32_t blocks_x = (level.width + 3) / 4;
+	uint32_t blocks_y = (level.height + 3) / 4;
+	uint32_t bytes = block_bytes(format);
+	pixels->assign(size_t(level.width) * level.height, 0);
+
+	for (uint32_t by = 0; by < blocks_y; ++by) {
+		for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+			uint8_t const *in = &level.data[(size_t(by) * blocks_x + bx) * bytes];
+			uint8_t a[16];
+			uint8_t rgb[16][3];
+			if (format == BlockBC3) {
+				decode_channel_block(in, a);
+				decode_color_block(in + 8, rgb);
+			} else {
+				decode_channel_block(in, a);
+				for (int i = 0; i < 16; ++i) {
+					rgb[i][0] = a[i];
+					rgb[i][1] = rgb[i][2] = 0;
+					a[i] = 255;
+				}
+			}
+			for (uint32_t i = 0; i < 16; ++i) {
+				uint32_t x = bx * 4 + (i % 4);
+				uint32_t y = by * 4 + (i / 4);
+				if (x >= level.width || y >= level.height) continue;
+				(*pixels)[y * level.width + x] = uint32_t(rgb[i][0]) | (uint32_t(rgb[i][1]) << 8) | (uint32_t(rgb[i][2]) << 16) | (uint32_t(a[i]) << 24);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------
+//.ctex files: "CTX2", format, level count, flags (1 = premultiplied), then per level: width, height, byte count, bytes.
+
+bool load_compressed_texture(std::string const &filename, CompressedTexture *texture) {
+	AssetBytes bytes;
+	if (!load_asset(filename, &bytes)) {
+		return false;
+	}
+	AssetStream file(bytes);
+	char magic[4];
+	uint32_t header[3];
+	if (!file.read(magic, 4) || std::memcmp(magic, "CTX2", 4) != 0
+		|| !file.read(reinterpret_cast< char * >(header), sizeof(header))) {
+		LOG_ERROR("  '" << filename << "' is not a compressed texture (or predates premultiplied alpha; rerun compress_texture).");
+		return false;
+	}
+	if (header[0] != BlockBC3 && header[0] != BlockBC4) {
+		LOG_ERROR("  '" << filename << "' has an unknown block format.");
+		return false;
+	}
+	//(a 32-bit-sized image has at most 33 levels, 2^32 x 1 down to 1 x 1)
+	if (header[1] == 0 || header[1] > 33) {
+		LOG_ERROR("  '" << filename << "' has an impossible level count (" << header[1] << ").");
+		return false;
+	}
+	texture->format = BlockFormat(header[0]);
+	texture->premultiplied = (header[2] & 1) != 0;
+	texture->levels.resize(header[1]);
+	for (auto &level : texture->levels) {
+		uint32_t info[3];
+		if (!file.read(reinterpret_cast< char * >(info), sizeof(info))) {
+			LOG_ERROR("  '" << filename << "' is truncated.");
+			return false;
+		}
+		level.width = info[0];
+		level.height = info[1];
+		//(64-bit, so huge dimensions cannot wrap around to match a small size)
+		uint64_t expected = uint64_t((level.width + 3ULL) / 4) * uint64_t((level.height + 3ULL) / 4) * block_bytes(texture->format);
+		if (level.width == 0 || level.height == 0 || info[2] != expected) {
+			LOG_ERROR("  '" << filename << "' has a level of the wrong size.");
+			return false;
+		}
+		if (info[2] > bytes.size - size_t(file.tellg())) {
+			LOG_ERROR("  '" << filename << "' is truncated.");
+			return false;
+		}
+		level.data.resize(info[2]);
+		if (!file.read(reinterpret_cast< char * >(level.data.data()), info[2])) {
+			LOG_ERROR("  '" << filename << "' is truncated.");
+			return false;
+		}
+	}
+	return true;
+}
+
+bool save_compressed_texture(std::string const &filename, CompressedTexture const &texture) {
+	std::ofstream file(filename.c_str(), std::ios::binary);
+	if (!file) {
+		LOG_ERROR("  cannot open '" << filename << "' for writing.");
+		return false;
+	}
+	uint32_t header[3] = { uint32_t(texture.format), uint32_t(texture.levels.size()), texture.premultiplied ? 1U : 0U };
+	file.write("CTX2", 4);
+	file.write(reinterpret_cast< char const * >(header), sizeof(header));
+	for (auto const &level : texture.levels) {
+		uint32_t info[3] = { level.width, level.height, uint32_t(level.data.size()) };
+		file.write(reinterpret_cast< char const * >(info), sizeof(info));
+		file.write(reinterpret_cast< char const * >(level.data.data()), level.data.size());
+	}
+	return bool(file);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct JobSystem;
+
+/*
+ * CPU block compression for textures:
+ *  - BC3 (DXT5): RGB565 color endpoints + 8-bit alpha endpoints, 16 bytes per 4x4 block.
+ *  - BC4 (RGTC1): a single 8-bit channel (red), 8 bytes per 4x4 block.
+ *
+ * Pixels are packed RGBA8 (red in the low byte, as from load_png), row-major
+ * starting at the row GL treats as t = 0.
+ *
+ * Compressed textures are stored in ".ctex" files: a small header followed by
+ * every mip level, so they can be handed straight to glCompressedTexImage2D.
+ */
+
+enum BlockFormat {
+	BlockBC3 = 1,
+	BlockBC4 = 2,
+};
+
+//Encoder effort: fast fits color endpoints to the bounding box and uses the
+//8-value alpha/BC4 mode only; normal fits color to the principal axis and also
+//tries the 6-value mode (exact 0 and 255) on alpha/BC4; best adds least-squares
+//refinement of the color endpoints.
+enum BlockQuality {
+	BlockQualityFast = 0,
+	BlockQualityNormal = 1,
+	BlockQualityBest = 2,
+};
+
+struct CompressedLevel {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector< uint8_t > data;
+};
+
+struct CompressedTexture {
+	BlockFormat format = BlockBC3;
+	bool premultiplied = false; //color already scaled by alpha (see mip_chain.hpp)
+	std::vector< CompressedLevel > levels; //level 0 first
+};
+
+uint32_t block_bytes(BlockFormat format);
+
+//Compress one image (any size; edge blocks repeat the last row/column).
+//Rows of blocks are spread over 'jobs' when one is given:
+void compress_blocks(BlockFormat format, BlockQuality quality,
+	uint32_t width, uint32_t height, uint32_t const *pixels,
+	CompressedLevel *level, JobSystem *jobs = nullptr);
+
+//Decompress back to RGBA8 (BC4 decodes to red only, green = blue = 0, alpha = 255):
+void decompress_blocks(BlockFormat format, CompressedLevel const &level, std::vector< uint32_t > *pixels);
+
+bool load_compressed_texture(std::string const &filename, CompressedTexture *texture);
+bool save_compressed_texture(std::string const &filename, CompressedTexture const &texture);
@@ -0,0 +1,112 @@
+//compress_texture: block-compress a PNG (with its mip chain) into a .ctex file.
+//BC3 textures are stored with premultiplied alpha, to match how the game draws.
+//
+//  usage: compress_texture <in.png> <out.ctex> <bc3|bc4> [fast|normal|best] [--no-mips]
+//
+//Prints encoder throughput and the PSNR of the decoded top level against the source.
+//Run from dist/, e.g.: ../compress_texture atlas_0.png atlas_0.ctex bc3 best
+
+#include "block_compress.hpp"
+#include "job_system.hpp"
+#include "load_save_png.hpp"
+#include "mip_chain.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+
+//color under fully transparent texels is not encoded, so it does not count:
+static double psnr(BlockFormat format, std::vector< uint32_t > const &a, std::vector< uint32_t > const &b) {
+	double total = 0.0;
+	uint64_t count = 0;
+	for (size_t i = 0; i < a.size(); ++i) {
+		int first = 0, last = 0;
+		if (format == BlockBC3) {
+			first = ((a[i] >> 24) == 0 ? 3 : 0);
+			last = 3;
+		}
+		for (int c = first; c <= last; ++c) {
+			double d = double((a[i] >> (8 * c)) & 0xff) - double((b[i] >> (8 * c)) & 0xff);
+			total += d * d;
+			count += 1;
+		}
+	}
+	if (total == 0.0) return INFINITY;
+	return 10.0 * std::log10(255.0 * 255.0 / (total / double(count)));
+}
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		std::cerr << "usage: " << argv[0] << " <in.png> <out.ctex> <bc3|bc4> [fast|normal|best] [--no-mips]" << std::endl;
+		return 1;
+	}
+	std::string in_name = argv[1];
+	std::string out_name = argv[2];
+	std::string format_name = argv[3];
+
+	CompressedTexture texture;
+	if (format_name == "bc3") texture.format = BlockBC3;
+	else if (format_name == "bc4") texture.format = BlockBC4;
+	else {
+		std::cerr << "Unknown format '" << format_name << "' (expecting bc3 or bc4)." << std::endl;
+		return 1;
+	}
+
+	BlockQuality quality = BlockQualityNormal;
+	bool mips = true;
+	for (int a = 4; a < argc; ++a) {
+		std::string arg = argv[a];
+		if (arg == "fast") quality = BlockQualityFast;
+		else if (arg == "normal") quality = BlockQualityNormal;
+		else if (arg == "best") quality = BlockQualityBest;
+		else if (arg == "--no-mips") mips = false;
+		else {
+			std::cerr << "Unknown option '" << arg << "'." << std::endl;
+			return 1;
+		}
+	}
+
+	MipLevel top;
+	//same origin as the game uses when uploading:
+	if (!load_png(in_name, &top.width, &top.height, &top.pixels, LowerLeftOrigin)) {
+		std::cerr << "Failed to load '" << in_name << "'." << std::endl;
+		return 1;
+	}
+
+	JobSystem jobs;
+
+	if (texture.format == BlockBC3) {
+		premultiply_alpha(&top.pixels, &jobs);
+		texture.premultiplied = true;
+	}
+	std::vector< MipLevel > chain;
+	if (mips) {
+		build_mip_chain(std::move(top), &chain, &jobs);
+	} else {
+		chain.emplace_back(std::move(top));
+	}
+
+	double seconds = 0.0;
+	uint64_t texels = 0;
+	for (auto const &level : chain) {
+		texture.levels.emplace_back();
+		auto before = std::chrono::high_resolution_clock::now();
+		compress_blocks(texture.format, quality, level.width, level.height, level.pixels.data(), &texture.levels.back(), &jobs);
+		seconds += std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+		texels += uint64_t(level.width) * level.height;
+
+		if (texture.levels.size() == 1) {
+			std::vector< uint32_t > decoded;
+			decompress_blocks(texture.format, texture.levels[0], &decoded);
+			std::cout << "Level 0: " << level.width << "x" << level.height << ", PSNR " << psnr(texture.format, level.pixels, decoded) << " dB." << std::endl;
+		}
+	}
+
+	if (!save_compressed_texture(out_name, texture)) return 1;
+
+	std::cout << "Compressed " << texture.levels.size() << " level(s) on " << jobs.thread_count() << " thread(s): "
+		<< (double(texels) / 1.0e6) / seconds << " Mtexel/s." << std::endl;
+	return 0;
+}
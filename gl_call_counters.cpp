@@ -0,0 +1,59 @@
+#include "gl_call_counters.hpp"
+
+#ifdef GL_CALL_COUNTERS
+
+//(gl_counters.hpp defines the names array in this file only)
+#define GL_COUNTERS_DEFINE_NAMES
+#include "GL.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+GLCallCounter gl_call_counters[GLCallCount];
+
+bool gl_call_counters_enabled() {
+	return true;
+}
+
+void gl_call_counters_reset() {
+	for (auto &counter : gl_call_counters) {
+		counter = GLCallCounter();
+	}
+}
+
+void gl_call_counters_report(uint32_t frames) {
+	uint16_t order[GLCallCount];
+	uint32_t used = 0;
+	uint64_t calls = 0, nanoseconds = 0;
+	for (uint32_t i = 0; i < GLCallCount; ++i) {
+		if (gl_call_counters[i].calls == 0) continue;
+		order[used++] = uint16_t(i);
+		calls += gl_call_counters[i].calls;
+		nanoseconds += gl_call_counters[i].nanoseconds;
+	}
+	std::sort(order, order + used, [](uint16_t a, uint16_t b) {
+		return gl_call_counters[a].nanoseconds > gl_call_counters[b].nanoseconds;
+	});
+
+	double per_frame = 1.0 / std::max(frames, 1U);
+	std::printf("gl calls per frame (over %u frames): %.1f calls, %.1f us\n", frames, calls * per_frame, nanoseconds * 1e-3 * per_frame);
+	for (uint32_t i = 0; i < used; ++i) {
+		GLCallCounter const &counter = gl_call_counters[order[i]];
+		std::printf("  %-32s %8.1f calls %9.1f us\n", gl_call_names[order[i]], counter.calls * per_frame, counter.nanoseconds * 1e-3 * per_frame);
+	}
+	gl_call_counters_reset();
+}
+
+#else //GL_CALL_COUNTERS
+
+bool gl_call_counters_enabled() {
+	return false;
+}
+
+void gl_call_counters_reset() {
+}
+
+void gl_call_counters_report(uint32_t) {
+}
+
+#endif //GL_CALL_COUNTERS
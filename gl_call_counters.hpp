@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+/*
+ * GL call counts and CPU time per entry point, for seeing which GL calls the
+ * frame spends its driver time in without an external debugger.
+ *
+ * Building with GL_CALL_COUNTERS defined makes GL.hpp include gl_counters.hpp
+ * (generated by 'make-gl-shims.py --counters'), which routes every core GL
+ * call through a wrapper that counts it and times it with GLCallTimer.
+ * Without it nothing is wrapped and the report is empty.
+ *
+ * The counters are plain (not atomic): GL calls come from the one thread
+ * that has the context.
+ */
+
+struct GLCallCounter {
+	uint64_t calls = 0;
+	uint64_t nanoseconds = 0;
+};
+
+//true when built with GL_CALL_COUNTERS:
+bool gl_call_counters_enabled();
+
+//zero every counter:
+void gl_call_counters_reset();
+
+//Print the entry points called since the last reset, most time first, as
+//per-frame averages over 'frames' frames, then reset (printf; does not allocate):
+void gl_call_counters_report(uint32_t frames);
+
+//indexed by GLCallIndex (gl_counters.hpp):
+extern GLCallCounter gl_call_counters[];
+
+//counts one call to entry point 'index' and the time until it goes out of scope:
+struct GLCallTimer {
+	typedef std::chrono::steady_clock Clock;
+
+	explicit GLCallTimer(uint32_t index_) : index(index_), start(Clock::now()) { }
+	~GLCallTimer() {
+		GLCallCounter &counter = gl_call_counters[index];
+		counter.calls += 1;
+		counter.nanoseconds += uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(Clock::now() - start).count());
+	}
+
+	GLCallTimer(GLCallTimer const &) = delete;
+	GLCallTimer &operator=(GLCallTimer const &) = delete;
+
+private:
+	uint32_t index;
+	Clock::time_point start;
+};
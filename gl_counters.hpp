@@ -0,0 +1,1425 @@
+#pragma once
+
+//Generated by 'make-gl-shims.py --counters > gl_counters.hpp'; do not edit.
+//
+//Every core GL entry point through 3.3, wrapped so that each call is counted and
+//timed (see gl_call_counters.hpp), and the gl* names redefined to the wrappers.
+//GL.hpp includes this after the GL prototypes when GL_CALL_COUNTERS is defined.
+
+#include "gl_call_counters.hpp"
+
+enum GLCallIndex {
+	GLCall_CullFace,
+	GLCall_FrontFace,
+	GLCall_Hint,
+	GLCall_LineWidth,
+	GLCall_PointSize,
+	GLCall_PolygonMode,
+	GLCall_Scissor,
+	GLCall_TexParameterf,
+	GLCall_TexParameterfv,
+	GLCall_TexParameteri,
+	GLCall_TexParameteriv,
+	GLCall_TexImage1D,
+	GLCall_TexImage2D,
+	GLCall_DrawBuffer,
+	GLCall_Clear,
+	GLCall_ClearColor,
+	GLCall_ClearStencil,
+	GLCall_ClearDepth,
+	GLCall_StencilMask,
+	GLCall_ColorMask,
+	GLCall_DepthMask,
+	GLCall_Disable,
+	GLCall_Enable,
+	GLCall_Finish,
+	GLCall_Flush,
+	GLCall_BlendFunc,
+	GLCall_LogicOp,
+	GLCall_StencilFunc,
+	GLCall_StencilOp,
+	GLCall_DepthFunc,
+	GLCall_PixelStoref,
+	GLCall_PixelStorei,
+	GLCall_ReadBuffer,
+	GLCall_ReadPixels,
+	GLCall_GetBooleanv,
+	GLCall_GetDoublev,
+	GLCall_GetError,
+	GLCall_GetFloatv,
+	GLCall_GetIntegerv,
+	GLCall_GetString,
+	GLCall_GetTexImage,
+	GLCall_GetTexParameterfv,
+	GLCall_GetTexParameteriv,
+	GLCall_GetTexLevelParameterfv,
+	GLCall_GetTexLevelParameteriv,
+	GLCall_IsEnabled,
+	GLCall_DepthRange,
+	GLCall_Viewport,
+	GLCall_DrawArrays,
+	GLCall_DrawElements,
+	GLCall_GetPointerv,
+	GLCall_PolygonOffset,
+	GLCall_CopyTexImage1D,
+	GLCall_CopyTexImage2D,
+	GLCall_CopyTexSubImage1D,
+	GLCall_CopyTexSubImage2D,
+	GLCall_TexSubImage1D,
+	GLCall_TexSubImage2D,
+	GLCall_BindTexture,
+	GLCall_DeleteTextures,
+	GLCall_GenTextures,
+	GLCall_IsTexture,
+	GLCall_DrawRangeElements,
+	GLCall_TexImage3D,
+	GLCall_TexSubImage3D,
+	GLCall_CopyTexSubImage3D,
+	GLCall_ActiveTexture,
+	GLCall_SampleCoverage,
+	GLCall_CompressedTexImage3D,
+	GLCall_CompressedTexImage2D,
+	GLCall_CompressedTexImage1D,
+	GLCall_CompressedTexSubImage3D,
+	GLCall_CompressedTexSubImage2D,
+	GLCall_CompressedTexSubImage1D,
+	GLCall_GetCompressedTexImage,
+	GLCall_BlendFuncSeparate,
+	GLCall_MultiDrawArrays,
+	GLCall_MultiDrawElements,
+	GLCall_PointParameterf,
+	GLCall_PointParameterfv,
+	GLCall_PointParameteri,
+	GLCall_PointParameteriv,
+	GLCall_BlendColor,
+	GLCall_BlendEquation,
+	GLCall_GenQueries,
+	GLCall_DeleteQueries,
+	GLCall_IsQuery,
+	GLCall_BeginQuery,
+	GLCall_EndQuery,
+	GLCall_GetQueryiv,
+	GLCall_GetQueryObjectiv,
+	GLCall_GetQueryObjectuiv,
+	GLCall_BindBuffer,
+	GLCall_DeleteBuffers,
+	GLCall_GenBuffers,
+	GLCall_IsBuffer,
+	GLCall_BufferData,
+	GLCall_BufferSubData,
+	GLCall_GetBufferSubData,
+	GLCall_MapBuffer,
+	GLCall_UnmapBuffer,
+	GLCall_GetBufferParameteriv,
+	GLCall_GetBufferPointerv,
+	GLCall_BlendEquationSeparate,
+	GLCall_DrawBuffers,
+	GLCall_StencilOpSeparate,
+	GLCall_StencilFuncSeparate,
+	GLCall_StencilMaskSeparate,
+	GLCall_AttachShader,
+	GLCall_BindAttribLocation,
+	GLCall_CompileShader,
+	GLCall_CreateProgram,
+	GLCall_CreateShader,
+	GLCall_DeleteProgram,
+	GLCall_DeleteShader,
+	GLCall_DetachShader,
+	GLCall_DisableVertexAttribArray,
+	GLCall_EnableVertexAttribArray,
+	GLCall_GetActiveAttrib,
+	GLCall_GetActiveUniform,
+	GLCall_GetAttachedShaders,
+	GLCall_GetAttribLocation,
+	GLCall_GetProgramiv,
+	GLCall_GetProgramInfoLog,
+	GLCall_GetShaderiv,
+	GLCall_GetShaderInfoLog,
+	GLCall_GetShaderSource,
+	GLCall_GetUniformLocation,
+	GLCall_GetUniformfv,
+	GLCall_GetUniformiv,
+	GLCall_GetVertexAttribdv,
+	GLCall_GetVertexAttribfv,
+	GLCall_GetVertexAttribiv,
+	GLCall_GetVertexAttribPointerv,
+	GLCall_IsProgram,
+	GLCall_IsShader,
+	GLCall_LinkProgram,
+	GLCall_ShaderSource,
+	GLCall_UseProgram,
+	GLCall_Uniform1f,
+	GLCall_Uniform2f,
+	GLCall_Uniform3f,
+	GLCall_Uniform4f,
+	GLCall_Uniform1i,
+	GLCall_Uniform2i,
+	GLCall_Uniform3i,
+	GLCall_Uniform4i,
+	GLCall_Uniform1fv,
+	GLCall_Uniform2fv,
+	GLCall_Uniform3fv,
+	GLCall_Uniform4fv,
+	GLCall_Uniform1iv,
+	GLCall_Uniform2iv,
+	GLCall_Uniform3iv,
+	GLCall_Uniform4iv,
+	GLCall_UniformMatrix2fv,
+	GLCall_UniformMatrix3fv,
+	GLCall_UniformMatrix4fv,
+	GLCall_ValidateProgram,
+	GLCall_VertexAttrib1d,
+	GLCall_VertexAttrib1dv,
+	GLCall_VertexAttrib1f,
+	GLCall_VertexAttrib1fv,
+	GLCall_VertexAttrib1s,
+	GLCall_VertexAttrib1sv,
+	GLCall_VertexAttrib2d,
+	GLCall_VertexAttrib2dv,
+	GLCall_VertexAttrib2f,
+	GLCall_VertexAttrib2fv,
+	GLCall_VertexAttrib2s,
+	GLCall_VertexAttrib2sv,
+	GLCall_VertexAttrib3d,
+	GLCall_VertexAttrib3dv,
+	GLCall_VertexAttrib3f,
+	GLCall_VertexAttrib3fv,
+	GLCall_VertexAttrib3s,
+	GLCall_VertexAttrib3sv,
+	GLCall_VertexAttrib4Nbv,
+	GLCall_VertexAttrib4Niv,
+	GLCall_VertexAttrib4Nsv,
+	GLCall_VertexAttrib4Nub,
+	GLCall_VertexAttrib4Nubv,
+	GLCall_VertexAttrib4Nuiv,
+	GLCall_VertexAttrib4Nusv,
+	GLCall_VertexAttrib4bv,
+	GLCall_VertexAttrib4d,
+	GLCall_VertexAttrib4dv,
+	GLCall_VertexAttrib4f,
+	GLCall_VertexAttrib4fv,
+	GLCall_VertexAttrib4iv,
+	GLCall_VertexAttrib4s,
+	GLCall_VertexAttrib4sv,
+	GLCall_VertexAttrib4ubv,
+	GLCall_VertexAttrib4uiv,
+	GLCall_VertexAttrib4usv,
+	GLCall_VertexAttribPointer,
+	GLCall_UniformMatrix2x3fv,
+	GLCall_UniformMatrix3x2fv,
+	GLCall_UniformMatrix2x4fv,
+	GLCall_UniformMatrix4x2fv,
+	GLCall_UniformMatrix3x4fv,
+	GLCall_UniformMatrix4x3fv,
+	GLCall_ColorMaski,
+	GLCall_GetBooleani_v,
+	GLCall_GetIntegeri_v,
+	GLCall_Enablei,
+	GLCall_Disablei,
+	GLCall_IsEnabledi,
+	GLCall_BeginTransformFeedback,
+	GLCall_EndTransformFeedback,
+	GLCall_BindBufferRange,
+	GLCall_BindBufferBase,
+	GLCall_TransformFeedbackVaryings,
+	GLCall_GetTransformFeedbackVarying,
+	GLCall_ClampColor,
+	GLCall_BeginConditionalRender,
+	GLCall_EndConditionalRender,
+	GLCall_VertexAttribIPointer,
+	GLCall_GetVertexAttribIiv,
+	GLCall_GetVertexAttribIuiv,
+	GLCall_VertexAttribI1i,
+	GLCall_VertexAttribI2i,
+	GLCall_VertexAttribI3i,
+	GLCall_VertexAttribI4i,
+	GLCall_VertexAttribI1ui,
+	GLCall_VertexAttribI2ui,
+	GLCall_VertexAttribI3ui,
+	GLCall_VertexAttribI4ui,
+	GLCall_VertexAttribI1iv,
+	GLCall_VertexAttribI2iv,
+	GLCall_VertexAttribI3iv,
+	GLCall_VertexAttribI4iv,
+	GLCall_VertexAttribI1uiv,
+	GLCall_VertexAttribI2uiv,
+	GLCall_VertexAttribI3uiv,
+	GLCall_VertexAttribI4uiv,
+	GLCall_VertexAttribI4bv,
+	GLCall_VertexAttribI4sv,
+	GLCall_VertexAttribI4ubv,
+	GLCall_VertexAttribI4usv,
+	GLCall_GetUniformuiv,
+	GLCall_BindFragDataLocation,
+	GLCall_GetFragDataLocation,
+	GLCall_Uniform1ui,
+	GLCall_Uniform2ui,
+	GLCall_Uniform3ui,
+	GLCall_Uniform4ui,
+	GLCall_Uniform1uiv,
+	GLCall_Uniform2uiv,
+	GLCall_Uniform3uiv,
+	GLCall_Uniform4uiv,
+	GLCall_TexParameterIiv,
+	GLCall_TexParameterIuiv,
+	GLCall_GetTexParameterIiv,
+	GLCall_GetTexParameterIuiv,
+	GLCall_ClearBufferiv,
+	GLCall_ClearBufferuiv,
+	GLCall_ClearBufferfv,
+	GLCall_ClearBufferfi,
+	GLCall_GetStringi,
+	GLCall_IsRenderbuffer,
+	GLCall_BindRenderbuffer,
+	GLCall_DeleteRenderbuffers,
+	GLCall_GenRenderbuffers,
+	GLCall_RenderbufferStorage,
+	GLCall_GetRenderbufferParameteriv,
+	GLCall_IsFramebuffer,
+	GLCall_BindFramebuffer,
+	GLCall_DeleteFramebuffers,
+	GLCall_GenFramebuffers,
+	GLCall_CheckFramebufferStatus,
+	GLCall_FramebufferTexture1D,
+	GLCall_FramebufferTexture2D,
+	GLCall_FramebufferTexture3D,
+	GLCall_FramebufferRenderbuffer,
+	GLCall_GetFramebufferAttachmentParameteriv,
+	GLCall_GenerateMipmap,
+	GLCall_BlitFramebuffer,
+	GLCall_RenderbufferStorageMultisample,
+	GLCall_FramebufferTextureLayer,
+	GLCall_MapBufferRange,
+	GLCall_FlushMappedBufferRange,
+	GLCall_BindVertexArray,
+	GLCall_DeleteVertexArrays,
+	GLCall_GenVertexArrays,
+	GLCall_IsVertexArray,
+	GLCall_DrawArraysInstanced,
+	GLCall_DrawElementsInstanced,
+	GLCall_TexBuffer,
+	GLCall_PrimitiveRestartIndex,
+	GLCall_CopyBufferSubData,
+	GLCall_GetUniformIndices,
+	GLCall_GetActiveUniformsiv,
+	GLCall_GetActiveUniformName,
+	GLCall_GetUniformBlockIndex,
+	GLCall_GetActiveUniformBlockiv,
+	GLCall_GetActiveUniformBlockName,
+	GLCall_UniformBlockBinding,
+	GLCall_DrawElementsBaseVertex,
+	GLCall_DrawRangeElementsBaseVertex,
+	GLCall_DrawElementsInstancedBaseVertex,
+	GLCall_MultiDrawElementsBaseVertex,
+	GLCall_ProvokingVertex,
+	GLCall_FenceSync,
+	GLCall_IsSync,
+	GLCall_DeleteSync,
+	GLCall_ClientWaitSync,
+	GLCall_WaitSync,
+	GLCall_GetInteger64v,
+	GLCall_GetSynciv,
+	GLCall_GetInteger64i_v,
+	GLCall_GetBufferParameteri64v,
+	GLCall_FramebufferTexture,
+	GLCall_TexImage2DMultisample,
+	GLCall_TexImage3DMultisample,
+	GLCall_GetMultisamplefv,
+	GLCall_SampleMaski,
+	GLCall_BindFragDataLocationIndexed,
+	GLCall_GetFragDataIndex,
+	GLCall_GenSamplers,
+	GLCall_DeleteSamplers,
+	GLCall_IsSampler,
+	GLCall_BindSampler,
+	GLCall_SamplerParameteri,
+	GLCall_SamplerParameteriv,
+	GLCall_SamplerParameterf,
+	GLCall_SamplerParameterfv,
+	GLCall_SamplerParameterIiv,
+	GLCall_SamplerParameterIuiv,
+	GLCall_GetSamplerParameteriv,
+	GLCall_GetSamplerParameterIiv,
+	GLCall_GetSamplerParameterfv,
+	GLCall_GetSamplerParameterIuiv,
+	GLCall_QueryCounter,
+	GLCall_GetQueryObjecti64v,
+	GLCall_GetQueryObjectui64v,
+	GLCall_VertexAttribDivisor,
+	GLCall_VertexAttribP1ui,
+	GLCall_VertexAttribP1uiv,
+	GLCall_VertexAttribP2ui,
+	GLCall_VertexAttribP2uiv,
+	GLCall_VertexAttribP3ui,
+	GLCall_VertexAttribP3uiv,
+	GLCall_VertexAttribP4ui,
+	GLCall_VertexAttribP4uiv,
+	GLCallCount
+};
+
+#ifdef GL_COUNTERS_DEFINE_NAMES
+char const *gl_call_names[GLCallCount] = {
+	"glCullFace",
+	"glFrontFace",
+	"glHint",
+	"glLineWidth",
+	"glPointSize",
+	"glPolygonMode",
+	"glScissor",
+	"glTexParameterf",
+	"glTexParameterfv",
+	"glTexParameteri",
+	"glTexParameteriv",
+	"glTexImage1D",
+	"glTexImage2D",
+	"glDrawBuffer",
+	"glClear",
+	"glClearColor",
+	"glClearStencil",
+	"glClearDepth",
+	"glStencilMask",
+	"glColorMask",
+	"glDepthMask",
+	"glDisable",
+	"glEnable",
+	"glFinish",
+	"glFlush",
+	"glBlendFunc",
+	"glLogicOp",
+	"glStencilFunc",
+	"glStencilOp",
+	"glDepthFunc",
+	"glPixelStoref",
+	"glPixelStorei",
+	"glReadBuffer",
+	"glReadPixels",
+	"glGetBooleanv",
+	"glGetDoublev",
+	"glGetError",
+	"glGetFloatv",
+	"glGetIntegerv",
+	"glGetString",
+	"glGetTexImage",
+	"glGetTexParameterfv",
+	"glGetTexParameteriv",
+	"glGetTexLevelParameterfv",
+	"glGetTexLevelParameteriv",
+	"glIsEnabled",
+	"glDepthRange",
+	"glViewport",
+	"glDrawArrays",
+	"glDrawElements",
+	"glGetPointerv",
+	"glPolygonOffset",
+	"glCopyTexImage1D",
+	"glCopyTexImage2D",
+	"glCopyTexSubImage1D",
+	"glCopyTexSubImage2D",
+	"glTexSubImage1D",
+	"glTexSubImage2D",
+	"glBindTexture",
+	"glDeleteTextures",
+	"glGenTextures",
+	"glIsTexture",
+	"glDrawRangeElements",
+	"glTexImage3D",
+	"glTexSubImage3D",
+	"glCopyTexSubImage3D",
+	"glActiveTexture",
+	"glSampleCoverage",
+	"glCompressedTexImage3D",
+	"glCompressedTexImage2D",
+	"glCompressedTexImage1D",
+	"glCompressedTexSubImage3D",
+	"glCompressedTexSubImage2D",
+	"glCompressedTexSubImage1D",
+	"glGetCompressedTexImage",
+	"glBlendFuncSeparate",
+	"glMultiDrawArrays",
+	"glMultiDrawElements",
+	"glPointParameterf",
+	"glPointParameterfv",
+	"glPointParameteri",
+	"glPointParameteriv",
+	"glBlendColor",
+	"glBlendEquation",
+	"glGenQueries",
+	"glDeleteQueries",
+	"glIsQuery",
+	"glBeginQuery",
+	"glEndQuery",
+	"glGetQueryiv",
+	"glGetQueryObjectiv",
+	"glGetQueryObjectuiv",
+	"glBindBuffer",
+	"glDeleteBuffers",
+	"glGenBuffers",
+	"glIsBuffer",
+	"glBufferData",
+	"glBufferSubData",
+	"glGetBufferSubData",
+	"glMapBuffer",
+	"glUnmapBuffer",
+	"glGetBufferParameteriv",
+	"glGetBufferPointerv",
+	"glBlendEquationSeparate",
+	"glDrawBuffers",
+	"glStencilOpSeparate",
+	"glStencilFuncSeparate",
+	"glStencilMaskSeparate",
+	"glAttachShader",
+	"glBindAttribLocation",
+	"glCompileShader",
+	"glCreateProgram",
+	"glCreateShader",
+	"glDeleteProgram",
+	"glDeleteShader",
+	"glDetachShader",
+	"glDisableVertexAttribArray",
+	"glEnableVertexAttribArray",
+	"glGetActiveAttrib",
+	"glGetActiveUniform",
+	"glGetAttachedShaders",
+	"glGetAttribLocation",
+	"glGetProgramiv",
+	"glGetProgramInfoLog",
+	"glGetShaderiv",
+	"glGetShaderInfoLog",
+	"glGetShaderSource",
+	"glGetUniformLocation",
+	"glGetUniformfv",
+	"glGetUniformiv",
+	"glGetVertexAttribdv",
+	"glGetVertexAttribfv",
+	"glGetVertexAttribiv",
+	"glGetVertexAttribPointerv",
+	"glIsProgram",
+	"glIsShader",
+	"glLinkProgram",
+	"glShaderSource",
+	"glUseProgram",
+	"glUniform1f",
+	"glUniform2f",
+	"glUniform3f",
+	"glUniform4f",
+	"glUniform1i",
+	"glUniform2i",
+	"glUniform3i",
+	"glUniform4i",
+	"glUniform1fv",
+	"glUniform2fv",
+	"glUniform3fv",
+	"glUniform4fv",
+	"glUniform1iv",
+	"glUniform2iv",
+	"glUniform3iv",
+	"glUniform4iv",
+	"glUniformMatrix2fv",
+	"glUniformMatrix3fv",
+	"glUniformMatrix4fv",
+	"glValidateProgram",
+	"glVertexAttrib1d",
+	"glVertexAttrib1dv",
+	"glVertexAttrib1f",
+	"glVertexAttrib1fv",
+	"glVertexAttrib1s",
+	"glVertexAttrib1sv",
+	"glVertexAttrib2d",
+	"glVertexAttrib2dv",
+	"glVertexAttrib2f",
+	"glVertexAttrib2fv",
+	"glVertexAttrib2s",
+	"glVertexAttrib2sv",
+	"glVertexAttrib3d",
+	"glVertexAttrib3dv",
+	"glVertexAttrib3f",
+	"glVertexAttrib3fv",
+	"glVertexAttrib3s",
+	"glVertexAttrib3sv",
+	"glVertexAttrib4Nbv",
+	"glVertexAttrib4Niv",
+	"glVertexAttrib4Nsv",
+	"glVertexAttrib4Nub",
+	"glVertexAttrib4Nubv",
+	"glVertexAttrib4Nuiv",
+	"glVertexAttrib4Nusv",
+	"glVertexAttrib4bv",
+	"glVertexAttrib4d",
+	"glVertexAttrib4dv",
+	"glVertexAttrib4f",
+	"glVertexAttrib4fv",
+	"glVertexAttrib4iv",
+	"glVertexAttrib4s",
+	"glVertexAttrib4sv",
+	"glVertexAttrib4ubv",
+	"glVertexAttrib4uiv",
+	"glVertexAttrib4usv",
+	"glVertexAttribPointer",
+	"glUniformMatrix2x3fv",
+	"glUniformMatrix3x2fv",
+	"glUniformMatrix2x4fv",
+	"glUniformMatrix4x2fv",
+	"glUniformMatrix3x4fv",
+	"glUniformMatrix4x3fv",
+	"glColorMaski",
+	"glGetBooleani_v",
+	"glGetIntegeri_v",
+	"glEnablei",
+	"glDisablei",
+	"glIsEnabledi",
+	"glBeginTransformFeedback",
+	"glEndTransformFeedback",
+	"glBindBufferRange",
+	"glBindBufferBase",
+	"glTransformFeedbackVaryings",
+	"glGetTransformFeedbackVarying",
+	"glClampColor",
+	"glBeginConditionalRender",
+	"glEndConditionalRender",
+	"glVertexAttribIPointer",
+	"glGetVertexAttribIiv",
+	"glGetVertexAttribIuiv",
+	"glVertexAttribI1i",
+	"glVertexAttribI2i",
+	"glVertexAttribI3i",
+	"glVertexAttribI4i",
+	"glVertexAttribI1ui",
+	"glVertexAttribI2ui",
+	"glVertexAttribI3ui",
+	"glVertexAttribI4ui",
+	"glVertexAttribI1iv",
+	"glVertexAttribI2iv",
+	"glVertexAttribI3iv",
+	"glVertexAttribI4iv",
+	"glVertexAttribI1uiv",
+	"glVertexAttribI2uiv",
+	"glVertexAttribI3uiv",
+	"glVertexAttribI4uiv",
+	"glVertexAttribI4bv",
+	"glVertexAttribI4sv",
+	"glVertexAttribI4ubv",
+	"glVertexAttribI4usv",
+	"glGetUniformuiv",
+	"glBindFragDataLocation",
+	"glGetFragDataLocation",
+	"glUniform1ui",
+	"glUniform2ui",
+	"glUniform3ui",
+	"glUniform4ui",
+	"glUniform1uiv",
+	"glUniform2uiv",
+	"glUniform3uiv",
+	"glUniform4uiv",
+	"glTexParameterIiv",
+	"glTexParameterIuiv",
+	"glGetTexParameterIiv",
+	"glGetTexParameterIuiv",
+	"glClearBufferiv",
+	"glClearBufferuiv",
+	"glClearBufferfv",
+	"glClearBufferfi",
+	"glGetStringi",
+	"glIsRenderbuffer",
+	"glBindRenderbuffer",
+	"glDeleteRenderbuffers",
+	"glGenRenderbuffers",
+	"glRenderbufferStorage",
+	"glGetRenderbufferParameteriv",
+	"glIsFramebuffer",
+	"glBindFramebuffer",
+	"glDeleteFramebuffers",
+	"glGenFramebuffers",
+	"glCheckFramebufferStatus",
+	"glFramebufferTexture1D",
+	"glFramebufferTexture2D",
+	"glFramebufferTexture3D",
+	"glFramebufferRenderbuffer",
+	"glGetFramebufferAttachmentParameteriv",
+	"glGenerateMipmap",
+	"glBlitFramebuffer",
+	"glRenderbufferStorageMultisample",
+	"glFramebufferTextureLayer",
+	"glMapBufferRange",
+	"glFlushMappedBufferRange",
+	"glBindVertexArray",
+	"glDeleteVertexArrays",
+	"glGenVertexArrays",
+	"glIsVertexArray",
+	"glDrawArraysInstanced",
+	"glDrawElementsInstanced",
+	"glTexBuffer",
+	"glPrimitiveRestartIndex",
+	"glCopyBufferSubData",
+	"glGetUniformIndices",
+	"glGetActiveUniformsiv",
+	"glGetActiveUniformName",
+	"glGetUniformBlockIndex",
+	"glGetActiveUniformBlockiv",
+	"glGetActiveUniformBlockName",
+	"glUniformBlockBinding",
+	"glDrawElementsBaseVertex",
+	"glDrawRangeElementsBaseVertex",
+	"glDrawElementsInstancedBaseVertex",
+	"glMultiDrawElementsBaseVertex",
+	"glProvokingVertex",
+	"glFenceSync",
+	"glIsSync",
+	"glDeleteSync",
+	"glClientWaitSync",
+	"glWaitSync",
+	"glGetInteger64v",
+	"glGetSynciv",
+	"glGetInteger64i_v",
+	"glGetBufferParameteri64v",
+	"glFramebufferTexture",
+	"glTexImage2DMultisample",
+	"glTexImage3DMultisample",
+	"glGetMultisamplefv",
+	"glSampleMaski",
+	"glBindFragDataLocationIndexed",
+	"glGetFragDataIndex",
+	"glGenSamplers",
+	"glDeleteSamplers",
+	"glIsSampler",
+	"glBindSampler",
+	"glSamplerParameteri",
+	"glSamplerParameteriv",
+	"glSamplerParameterf",
+	"glSamplerParameterfv",
+	"glSamplerParameterIiv",
+	"glSamplerParameterIuiv",
+	"glGetSamplerParameteriv",
+	"glGetSamplerParameterIiv",
+	"glGetSamplerParameterfv",
+	"glGetSamplerParameterIuiv",
+	"glQueryCounter",
+	"glGetQueryObjecti64v",
+	"glGetQueryObjectui64v",
+	"glVertexAttribDivisor",
+	"glVertexAttribP1ui",
+	"glVertexAttribP1uiv",
+	"glVertexAttribP2ui",
+	"glVertexAttribP2uiv",
+	"glVertexAttribP3ui",
+	"glVertexAttribP3uiv",
+	"glVertexAttribP4ui",
+	"glVertexAttribP4uiv",
+};
+#endif //GL_COUNTERS_DEFINE_NAMES
+
+
+// GL_VERSION_1_0:
+inline void counted_glCullFace(GLenum mode) { GLCallTimer timer(GLCall_CullFace); glCullFace(mode); }
+#define glCullFace counted_glCullFace
+inline void counted_glFrontFace(GLenum mode) { GLCallTimer timer(GLCall_FrontFace); glFrontFace(mode); }
+#define glFrontFace counted_glFrontFace
+inline void counted_glHint(GLenum target, GLenum mode) { GLCallTimer timer(GLCall_Hint); glHint(target, mode); }
+#define glHint counted_glHint
+inline void counted_glLineWidth(GLfloat width) { GLCallTimer timer(GLCall_LineWidth); glLineWidth(width); }
+#define glLineWidth counted_glLineWidth
+inline void counted_glPointSize(GLfloat size) { GLCallTimer timer(GLCall_PointSize); glPointSize(size); }
+#define glPointSize counted_glPointSize
+inline void counted_glPolygonMode(GLenum face, GLenum mode) { GLCallTimer timer(GLCall_PolygonMode); glPolygonMode(face, mode); }
+#define glPolygonMode counted_glPolygonMode
+inline void counted_glScissor(GLint x, GLint y, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_Scissor); glScissor(x, y, width, height); }
+#define glScissor counted_glScissor
+inline void counted_glTexParameterf(GLenum target, GLenum pname, GLfloat param) { GLCallTimer timer(GLCall_TexParameterf); glTexParameterf(target, pname, param); }
+#define glTexParameterf counted_glTexParameterf
+inline void counted_glTexParameterfv(GLenum target, GLenum pname, const GLfloat *params) { GLCallTimer timer(GLCall_TexParameterfv); glTexParameterfv(target, pname, params); }
+#define glTexParameterfv counted_glTexParameterfv
+inline void counted_glTexParameteri(GLenum target, GLenum pname, GLint param) { GLCallTimer timer(GLCall_TexParameteri); glTexParameteri(target, pname, param); }
+#define glTexParameteri counted_glTexParameteri
+inline void counted_glTexParameteriv(GLenum target, GLenum pname, const GLint *params) { GLCallTimer timer(GLCall_TexParameteriv); glTexParameteriv(target, pname, params); }
+#define glTexParameteriv counted_glTexParameteriv
+inline void counted_glTexImage1D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexImage1D); glTexImage1D(target, level, internalformat, width, border, format, type, pixels); }
+#define glTexImage1D counted_glTexImage1D
+inline void counted_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexImage2D); glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels); }
+#define glTexImage2D counted_glTexImage2D
+inline void counted_glDrawBuffer(GLenum buf) { GLCallTimer timer(GLCall_DrawBuffer); glDrawBuffer(buf); }
+#define glDrawBuffer counted_glDrawBuffer
+inline void counted_glClear(GLbitfield mask) { GLCallTimer timer(GLCall_Clear); glClear(mask); }
+#define glClear counted_glClear
+inline void counted_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { GLCallTimer timer(GLCall_ClearColor); glClearColor(red, green, blue, alpha); }
+#define glClearColor counted_glClearColor
+inline void counted_glClearStencil(GLint s) { GLCallTimer timer(GLCall_ClearStencil); glClearStencil(s); }
+#define glClearStencil counted_glClearStencil
+inline void counted_glClearDepth(GLdouble depth) { GLCallTimer timer(GLCall_ClearDepth); glClearDepth(depth); }
+#define glClearDepth counted_glClearDepth
+inline void counted_glStencilMask(GLuint mask) { GLCallTimer timer(GLCall_StencilMask); glStencilMask(mask); }
+#define glStencilMask counted_glStencilMask
+inline void counted_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) { GLCallTimer timer(GLCall_ColorMask); glColorMask(red, green, blue, alpha); }
+#define glColorMask counted_glColorMask
+inline void counted_glDepthMask(GLboolean flag) { GLCallTimer timer(GLCall_DepthMask); glDepthMask(flag); }
+#define glDepthMask counted_glDepthMask
+inline void counted_glDisable(GLenum cap) { GLCallTimer timer(GLCall_Disable); glDisable(cap); }
+#define glDisable counted_glDisable
+inline void counted_glEnable(GLenum cap) { GLCallTimer timer(GLCall_Enable); glEnable(cap); }
+#define glEnable counted_glEnable
+inline void counted_glFinish(void) { GLCallTimer timer(GLCall_Finish); glFinish(); }
+#define glFinish counted_glFinish
+inline void counted_glFlush(void) { GLCallTimer timer(GLCall_Flush); glFlush(); }
+#define glFlush counted_glFlush
+inline void counted_glBlendFunc(GLenum sfactor, GLenum dfactor) { GLCallTimer timer(GLCall_BlendFunc); glBlendFunc(sfactor, dfactor); }
+#define glBlendFunc counted_glBlendFunc
+inline void counted_glLogicOp(GLenum opcode) { GLCallTimer timer(GLCall_LogicOp); glLogicOp(opcode); }
+#define glLogicOp counted_glLogicOp
+inline void counted_glStencilFunc(GLenum func, GLint ref, GLuint mask) { GLCallTimer timer(GLCall_StencilFunc); glStencilFunc(func, ref, mask); }
+#define glStencilFunc counted_glStencilFunc
+inline void counted_glStencilOp(GLenum fail, GLenum zfail, GLenum zpass) { GLCallTimer timer(GLCall_StencilOp); glStencilOp(fail, zfail, zpass); }
+#define glStencilOp counted_glStencilOp
+inline void counted_glDepthFunc(GLenum func) { GLCallTimer timer(GLCall_DepthFunc); glDepthFunc(func); }
+#define glDepthFunc counted_glDepthFunc
+inline void counted_glPixelStoref(GLenum pname, GLfloat param) { GLCallTimer timer(GLCall_PixelStoref); glPixelStoref(pname, param); }
+#define glPixelStoref counted_glPixelStoref
+inline void counted_glPixelStorei(GLenum pname, GLint param) { GLCallTimer timer(GLCall_PixelStorei); glPixelStorei(pname, param); }
+#define glPixelStorei counted_glPixelStorei
+inline void counted_glReadBuffer(GLenum src) { GLCallTimer timer(GLCall_ReadBuffer); glReadBuffer(src); }
+#define glReadBuffer counted_glReadBuffer
+inline void counted_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) { GLCallTimer timer(GLCall_ReadPixels); glReadPixels(x, y, width, height, format, type, pixels); }
+#define glReadPixels counted_glReadPixels
+inline void counted_glGetBooleanv(GLenum pname, GLboolean *data) { GLCallTimer timer(GLCall_GetBooleanv); glGetBooleanv(pname, data); }
+#define glGetBooleanv counted_glGetBooleanv
+inline void counted_glGetDoublev(GLenum pname, GLdouble *data) { GLCallTimer timer(GLCall_GetDoublev); glGetDoublev(pname, data); }
+#define glGetDoublev counted_glGetDoublev
+inline GLenum counted_glGetError(void) { GLCallTimer timer(GLCall_GetError); return glGetError(); }
+#define glGetError counted_glGetError
+inline void counted_glGetFloatv(GLenum pname, GLfloat *data) { GLCallTimer timer(GLCall_GetFloatv); glGetFloatv(pname, data); }
+#define glGetFloatv counted_glGetFloatv
+inline void counted_glGetIntegerv(GLenum pname, GLint *data) { GLCallTimer timer(GLCall_GetIntegerv); glGetIntegerv(pname, data); }
+#define glGetIntegerv counted_glGetIntegerv
+inline const GLubyte * counted_glGetString(GLenum name) { GLCallTimer timer(GLCall_GetString); return glGetString(name); }
+#define glGetString counted_glGetString
+inline void counted_glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels) { GLCallTimer timer(GLCall_GetTexImage); glGetTexImage(target, level, format, type, pixels); }
+#define glGetTexImage counted_glGetTexImage
+inline void counted_glGetTexParameterfv(GLenum target, GLenum pname, GLfloat *params) { GLCallTimer timer(GLCall_GetTexParameterfv); glGetTexParameterfv(target, pname, params); }
+#define glGetTexParameterfv counted_glGetTexParameterfv
+inline void counted_glGetTexParameteriv(GLenum target, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetTexParameteriv); glGetTexParameteriv(target, pname, params); }
+#define glGetTexParameteriv counted_glGetTexParameteriv
+inline void counted_glGetTexLevelParameterfv(GLenum target, GLint level, GLenum pname, GLfloat *params) { GLCallTimer timer(GLCall_GetTexLevelParameterfv); glGetTexLevelParameterfv(target, level, pname, params); }
+#define glGetTexLevelParameterfv counted_glGetTexLevelParameterfv
+inline void counted_glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetTexLevelParameteriv); glGetTexLevelParameteriv(target, level, pname, params); }
+#define glGetTexLevelParameteriv counted_glGetTexLevelParameteriv
+inline GLboolean counted_glIsEnabled(GLenum cap) { GLCallTimer timer(GLCall_IsEnabled); return glIsEnabled(cap); }
+#define glIsEnabled counted_glIsEnabled
+inline void counted_glDepthRange(GLdouble near, GLdouble far) { GLCallTimer timer(GLCall_DepthRange); glDepthRange(near, far); }
+#define glDepthRange counted_glDepthRange
+inline void counted_glViewport(GLint x, GLint y, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_Viewport); glViewport(x, y, width, height); }
+#define glViewport counted_glViewport
+
+// GL_VERSION_1_1:
+inline void counted_glDrawArrays(GLenum mode, GLint first, GLsizei count) { GLCallTimer timer(GLCall_DrawArrays); glDrawArrays(mode, first, count); }
+#define glDrawArrays counted_glDrawArrays
+inline void counted_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) { GLCallTimer timer(GLCall_DrawElements); glDrawElements(mode, count, type, indices); }
+#define glDrawElements counted_glDrawElements
+inline void counted_glGetPointerv(GLenum pname, void **params) { GLCallTimer timer(GLCall_GetPointerv); glGetPointerv(pname, params); }
+#define glGetPointerv counted_glGetPointerv
+inline void counted_glPolygonOffset(GLfloat factor, GLfloat units) { GLCallTimer timer(GLCall_PolygonOffset); glPolygonOffset(factor, units); }
+#define glPolygonOffset counted_glPolygonOffset
+inline void counted_glCopyTexImage1D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border) { GLCallTimer timer(GLCall_CopyTexImage1D); glCopyTexImage1D(target, level, internalformat, x, y, width, border); }
+#define glCopyTexImage1D counted_glCopyTexImage1D
+inline void counted_glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) { GLCallTimer timer(GLCall_CopyTexImage2D); glCopyTexImage2D(target, level, internalformat, x, y, width, height, border); }
+#define glCopyTexImage2D counted_glCopyTexImage2D
+inline void counted_glCopyTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width) { GLCallTimer timer(GLCall_CopyTexSubImage1D); glCopyTexSubImage1D(target, level, xoffset, x, y, width); }
+#define glCopyTexSubImage1D counted_glCopyTexSubImage1D
+inline void counted_glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_CopyTexSubImage2D); glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height); }
+#define glCopyTexSubImage2D counted_glCopyTexSubImage2D
+inline void counted_glTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexSubImage1D); glTexSubImage1D(target, level, xoffset, width, format, type, pixels); }
+#define glTexSubImage1D counted_glTexSubImage1D
+inline void counted_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexSubImage2D); glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels); }
+#define glTexSubImage2D counted_glTexSubImage2D
+inline void counted_glBindTexture(GLenum target, GLuint texture) { GLCallTimer timer(GLCall_BindTexture); glBindTexture(target, texture); }
+#define glBindTexture counted_glBindTexture
+inline void counted_glDeleteTextures(GLsizei n, const GLuint *textures) { GLCallTimer timer(GLCall_DeleteTextures); glDeleteTextures(n, textures); }
+#define glDeleteTextures counted_glDeleteTextures
+inline void counted_glGenTextures(GLsizei n, GLuint *textures) { GLCallTimer timer(GLCall_GenTextures); glGenTextures(n, textures); }
+#define glGenTextures counted_glGenTextures
+inline GLboolean counted_glIsTexture(GLuint texture) { GLCallTimer timer(GLCall_IsTexture); return glIsTexture(texture); }
+#define glIsTexture counted_glIsTexture
+
+// GL_VERSION_1_2:
+inline void counted_glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices) { GLCallTimer timer(GLCall_DrawRangeElements); glDrawRangeElements(mode, start, end, count, type, indices); }
+#define glDrawRangeElements counted_glDrawRangeElements
+inline void counted_glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexImage3D); glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels); }
+#define glTexImage3D counted_glTexImage3D
+inline void counted_glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels) { GLCallTimer timer(GLCall_TexSubImage3D); glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels); }
+#define glTexSubImage3D counted_glTexSubImage3D
+inline void counted_glCopyTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_CopyTexSubImage3D); glCopyTexSubImage3D(target, level, xoffset, yoffset, zoffset, x, y, width, height); }
+#define glCopyTexSubImage3D counted_glCopyTexSubImage3D
+
+// GL_VERSION_1_3:
+inline void counted_glActiveTexture(GLenum texture) { GLCallTimer timer(GLCall_ActiveTexture); glActiveTexture(texture); }
+#define glActiveTexture counted_glActiveTexture
+inline void counted_glSampleCoverage(GLfloat value, GLboolean invert) { GLCallTimer timer(GLCall_SampleCoverage); glSampleCoverage(value, invert); }
+#define glSampleCoverage counted_glSampleCoverage
+inline void counted_glCompressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexImage3D); glCompressedTexImage3D(target, level, internalformat, width, height, depth, border, imageSize, data); }
+#define glCompressedTexImage3D counted_glCompressedTexImage3D
+inline void counted_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexImage2D); glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data); }
+#define glCompressedTexImage2D counted_glCompressedTexImage2D
+inline void counted_glCompressedTexImage1D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexImage1D); glCompressedTexImage1D(target, level, internalformat, width, border, imageSize, data); }
+#define glCompressedTexImage1D counted_glCompressedTexImage1D
+inline void counted_glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexSubImage3D); glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data); }
+#define glCompressedTexSubImage3D counted_glCompressedTexSubImage3D
+inline void counted_glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexSubImage2D); glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data); }
+#define glCompressedTexSubImage2D counted_glCompressedTexSubImage2D
+inline void counted_glCompressedTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data) { GLCallTimer timer(GLCall_CompressedTexSubImage1D); glCompressedTexSubImage1D(target, level, xoffset, width, format, imageSize, data); }
+#define glCompressedTexSubImage1D counted_glCompressedTexSubImage1D
+inline void counted_glGetCompressedTexImage(GLenum target, GLint level, void *img) { GLCallTimer timer(GLCall_GetCompressedTexImage); glGetCompressedTexImage(target, level, img); }
+#define glGetCompressedTexImage counted_glGetCompressedTexImage
+
+// GL_VERSION_1_4:
+inline void counted_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) { GLCallTimer timer(GLCall_BlendFuncSeparate); glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha); }
+#define glBlendFuncSeparate counted_glBlendFuncSeparate
+inline void counted_glMultiDrawArrays(GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount) { GLCallTimer timer(GLCall_MultiDrawArrays); glMultiDrawArrays(mode, first, count, drawcount); }
+#define glMultiDrawArrays counted_glMultiDrawArrays
+inline void counted_glMultiDrawElements(GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount) { GLCallTimer timer(GLCall_MultiDrawElements); glMultiDrawElements(mode, count, type, indices, drawcount); }
+#define glMultiDrawElements counted_glMultiDrawElements
+inline void counted_glPointParameterf(GLenum pname, GLfloat param) { GLCallTimer timer(GLCall_PointParameterf); glPointParameterf(pname, param); }
+#define glPointParameterf counted_glPointParameterf
+inline void counted_glPointParameterfv(GLenum pname, const GLfloat *params) { GLCallTimer timer(GLCall_PointParameterfv); glPointParameterfv(pname, params); }
+#define glPointParameterfv counted_glPointParameterfv
+inline void counted_glPointParameteri(GLenum pname, GLint param) { GLCallTimer timer(GLCall_PointParameteri); glPointParameteri(pname, param); }
+#define glPointParameteri counted_glPointParameteri
+inline void counted_glPointParameteriv(GLenum pname, const GLint *params) { GLCallTimer timer(GLCall_PointParameteriv); glPointParameteriv(pname, params); }
+#define glPointParameteriv counted_glPointParameteriv
+inline void counted_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { GLCallTimer timer(GLCall_BlendColor); glBlendColor(red, green, blue, alpha); }
+#define glBlendColor counted_glBlendColor
+inline void counted_glBlendEquation(GLenum mode) { GLCallTimer timer(GLCall_BlendEquation); glBlendEquation(mode); }
+#define glBlendEquation counted_glBlendEquation
+
+// GL_VERSION_1_5:
+inline void counted_glGenQueries(GLsizei n, GLuint *ids) { GLCallTimer timer(GLCall_GenQueries); glGenQueries(n, ids); }
+#define glGenQueries counted_glGenQueries
+inline void counted_glDeleteQueries(GLsizei n, const GLuint *ids) { GLCallTimer timer(GLCall_DeleteQueries); glDeleteQueries(n, ids); }
+#define glDeleteQueries counted_glDeleteQueries
+inline GLboolean counted_glIsQuery(GLuint id) { GLCallTimer timer(GLCall_IsQuery); return glIsQuery(id); }
+#define glIsQuery counted_glIsQuery
+inline void counted_glBeginQuery(GLenum target, GLuint id) { GLCallTimer timer(GLCall_BeginQuery); glBeginQuery(target, id); }
+#define glBeginQuery counted_glBeginQuery
+inline void counted_glEndQuery(GLenum target) { GLCallTimer timer(GLCall_EndQuery); glEndQuery(target); }
+#define glEndQuery counted_glEndQuery
+inline void counted_glGetQueryiv(GLenum target, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetQueryiv); glGetQueryiv(target, pname, params); }
+#define glGetQueryiv counted_glGetQueryiv
+inline void counted_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetQueryObjectiv); glGetQueryObjectiv(id, pname, params); }
+#define glGetQueryObjectiv counted_glGetQueryObjectiv
+inline void counted_glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint *params) { GLCallTimer timer(GLCall_GetQueryObjectuiv); glGetQueryObjectuiv(id, pname, params); }
+#define glGetQueryObjectuiv counted_glGetQueryObjectuiv
+inline void counted_glBindBuffer(GLenum target, GLuint buffer) { GLCallTimer timer(GLCall_BindBuffer); glBindBuffer(target, buffer); }
+#define glBindBuffer counted_glBindBuffer
+inline void counted_glDeleteBuffers(GLsizei n, const GLuint *buffers) { GLCallTimer timer(GLCall_DeleteBuffers); glDeleteBuffers(n, buffers); }
+#define glDeleteBuffers counted_glDeleteBuffers
+inline void counted_glGenBuffers(GLsizei n, GLuint *buffers) { GLCallTimer timer(GLCall_GenBuffers); glGenBuffers(n, buffers); }
+#define glGenBuffers counted_glGenBuffers
+inline GLboolean counted_glIsBuffer(GLuint buffer) { GLCallTimer timer(GLCall_IsBuffer); return glIsBuffer(buffer); }
+#define glIsBuffer counted_glIsBuffer
+inline void counted_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) { GLCallTimer timer(GLCall_BufferData); glBufferData(target, size, data, usage); }
+#define glBufferData counted_glBufferData
+inline void counted_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) { GLCallTimer timer(GLCall_BufferSubData); glBufferSubData(target, offset, size, data); }
+#define glBufferSubData counted_glBufferSubData
+inline void counted_glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void *data) { GLCallTimer timer(GLCall_GetBufferSubData); glGetBufferSubData(target, offset, size, data); }
+#define glGetBufferSubData counted_glGetBufferSubData
+inline void * counted_glMapBuffer(GLenum target, GLenum access) { GLCallTimer timer(GLCall_MapBuffer); return glMapBuffer(target, access); }
+#define glMapBuffer counted_glMapBuffer
+inline GLboolean counted_glUnmapBuffer(GLenum target) { GLCallTimer timer(GLCall_UnmapBuffer); return glUnmapBuffer(target); }
+#define glUnmapBuffer counted_glUnmapBuffer
+inline void counted_glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetBufferParameteriv); glGetBufferParameteriv(target, pname, params); }
+#define glGetBufferParameteriv counted_glGetBufferParameteriv
+inline void counted_glGetBufferPointerv(GLenum target, GLenum pname, void **params) { GLCallTimer timer(GLCall_GetBufferPointerv); glGetBufferPointerv(target, pname, params); }
+#define glGetBufferPointerv counted_glGetBufferPointerv
+
+// GL_VERSION_2_0:
+inline void counted_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) { GLCallTimer timer(GLCall_BlendEquationSeparate); glBlendEquationSeparate(modeRGB, modeAlpha); }
+#define glBlendEquationSeparate counted_glBlendEquationSeparate
+inline void counted_glDrawBuffers(GLsizei n, const GLenum *bufs) { GLCallTimer timer(GLCall_DrawBuffers); glDrawBuffers(n, bufs); }
+#define glDrawBuffers counted_glDrawBuffers
+inline void counted_glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) { GLCallTimer timer(GLCall_StencilOpSeparate); glStencilOpSeparate(face, sfail, dpfail, dppass); }
+#define glStencilOpSeparate counted_glStencilOpSeparate
+inline void counted_glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) { GLCallTimer timer(GLCall_StencilFuncSeparate); glStencilFuncSeparate(face, func, ref, mask); }
+#define glStencilFuncSeparate counted_glStencilFuncSeparate
+inline void counted_glStencilMaskSeparate(GLenum face, GLuint mask) { GLCallTimer timer(GLCall_StencilMaskSeparate); glStencilMaskSeparate(face, mask); }
+#define glStencilMaskSeparate counted_glStencilMaskSeparate
+inline void counted_glAttachShader(GLuint program, GLuint shader) { GLCallTimer timer(GLCall_AttachShader); glAttachShader(program, shader); }
+#define glAttachShader counted_glAttachShader
+inline void counted_glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) { GLCallTimer timer(GLCall_BindAttribLocation); glBindAttribLocation(program, index, name); }
+#define glBindAttribLocation counted_glBindAttribLocation
+inline void counted_glCompileShader(GLuint shader) { GLCallTimer timer(GLCall_CompileShader); glCompileShader(shader); }
+#define glCompileShader counted_glCompileShader
+inline GLuint counted_glCreateProgram(void) { GLCallTimer timer(GLCall_CreateProgram); return glCreateProgram(); }
+#define glCreateProgram counted_glCreateProgram
+inline GLuint counted_glCreateShader(GLenum type) { GLCallTimer timer(GLCall_CreateShader); return glCreateShader(type); }
+#define glCreateShader counted_glCreateShader
+inline void counted_glDeleteProgram(GLuint program) { GLCallTimer timer(GLCall_DeleteProgram); glDeleteProgram(program); }
+#define glDeleteProgram counted_glDeleteProgram
+inline void counted_glDeleteShader(GLuint shader) { GLCallTimer timer(GLCall_DeleteShader); glDeleteShader(shader); }
+#define glDeleteShader counted_glDeleteShader
+inline void counted_glDetachShader(GLuint program, GLuint shader) { GLCallTimer timer(GLCall_DetachShader); glDetachShader(program, shader); }
+#define glDetachShader counted_glDetachShader
+inline void counted_glDisableVertexAttribArray(GLuint index) { GLCallTimer timer(GLCall_DisableVertexAttribArray); glDisableVertexAttribArray(index); }
+#define glDisableVertexAttribArray counted_glDisableVertexAttribArray
+inline void counted_glEnableVertexAttribArray(GLuint index) { GLCallTimer timer(GLCall_EnableVertexAttribArray); glEnableVertexAttribArray(index); }
+#define glEnableVertexAttribArray counted_glEnableVertexAttribArray
+inline void counted_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) { GLCallTimer timer(GLCall_GetActiveAttrib); glGetActiveAttrib(program, index, bufSize, length, size, type, name); }
+#define glGetActiveAttrib counted_glGetActiveAttrib
+inline void counted_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) { GLCallTimer timer(GLCall_GetActiveUniform); glGetActiveUniform(program, index, bufSize, length, size, type, name); }
+#define glGetActiveUniform counted_glGetActiveUniform
+inline void counted_glGetAttachedShaders(GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders) { GLCallTimer timer(GLCall_GetAttachedShaders); glGetAttachedShaders(program, maxCount, count, shaders); }
+#define glGetAttachedShaders counted_glGetAttachedShaders
+inline GLint counted_glGetAttribLocation(GLuint program, const GLchar *name) { GLCallTimer timer(GLCall_GetAttribLocation); return glGetAttribLocation(program, name); }
+#define glGetAttribLocation counted_glGetAttribLocation
+inline void counted_glGetProgramiv(GLuint program, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetProgramiv); glGetProgramiv(program, pname, params); }
+#define glGetProgramiv counted_glGetProgramiv
+inline void counted_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) { GLCallTimer timer(GLCall_GetProgramInfoLog); glGetProgramInfoLog(program, bufSize, length, infoLog); }
+#define glGetProgramInfoLog counted_glGetProgramInfoLog
+inline void counted_glGetShaderiv(GLuint shader, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetShaderiv); glGetShaderiv(shader, pname, params); }
+#define glGetShaderiv counted_glGetShaderiv
+inline void counted_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) { GLCallTimer timer(GLCall_GetShaderInfoLog); glGetShaderInfoLog(shader, bufSize, length, infoLog); }
+#define glGetShaderInfoLog counted_glGetShaderInfoLog
+inline void counted_glGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source) { GLCallTimer timer(GLCall_GetShaderSource); glGetShaderSource(shader, bufSize, length, source); }
+#define glGetShaderSource counted_glGetShaderSource
+inline GLint counted_glGetUniformLocation(GLuint program, const GLchar *name) { GLCallTimer timer(GLCall_GetUniformLocation); return glGetUniformLocation(program, name); }
+#define glGetUniformLocation counted_glGetUniformLocation
+inline void counted_glGetUniformfv(GLuint program, GLint location, GLfloat *params) { GLCallTimer timer(GLCall_GetUniformfv); glGetUniformfv(program, location, params); }
+#define glGetUniformfv counted_glGetUniformfv
+inline void counted_glGetUniformiv(GLuint program, GLint location, GLint *params) { GLCallTimer timer(GLCall_GetUniformiv); glGetUniformiv(program, location, params); }
+#define glGetUniformiv counted_glGetUniformiv
+inline void counted_glGetVertexAttribdv(GLuint index, GLenum pname, GLdouble *params) { GLCallTimer timer(GLCall_GetVertexAttribdv); glGetVertexAttribdv(index, pname, params); }
+#define glGetVertexAttribdv counted_glGetVertexAttribdv
+inline void counted_glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat *params) { GLCallTimer timer(GLCall_GetVertexAttribfv); glGetVertexAttribfv(index, pname, params); }
+#define glGetVertexAttribfv counted_glGetVertexAttribfv
+inline void counted_glGetVertexAttribiv(GLuint index, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetVertexAttribiv); glGetVertexAttribiv(index, pname, params); }
+#define glGetVertexAttribiv counted_glGetVertexAttribiv
+inline void counted_glGetVertexAttribPointerv(GLuint index, GLenum pname, void **pointer) { GLCallTimer timer(GLCall_GetVertexAttribPointerv); glGetVertexAttribPointerv(index, pname, pointer); }
+#define glGetVertexAttribPointerv counted_glGetVertexAttribPointerv
+inline GLboolean counted_glIsProgram(GLuint program) { GLCallTimer timer(GLCall_IsProgram); return glIsProgram(program); }
+#define glIsProgram counted_glIsProgram
+inline GLboolean counted_glIsShader(GLuint shader) { GLCallTimer timer(GLCall_IsShader); return glIsShader(shader); }
+#define glIsShader counted_glIsShader
+inline void counted_glLinkProgram(GLuint program) { GLCallTimer timer(GLCall_LinkProgram); glLinkProgram(program); }
+#define glLinkProgram counted_glLinkProgram
+inline void counted_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) { GLCallTimer timer(GLCall_ShaderSource); glShaderSource(shader, count, string, length); }
+#define glShaderSource counted_glShaderSource
+inline void counted_glUseProgram(GLuint program) { GLCallTimer timer(GLCall_UseProgram); glUseProgram(program); }
+#define glUseProgram counted_glUseProgram
+inline void counted_glUniform1f(GLint location, GLfloat v0) { GLCallTimer timer(GLCall_Uniform1f); glUniform1f(location, v0); }
+#define glUniform1f counted_glUniform1f
+inline void counted_glUniform2f(GLint location, GLfloat v0, GLfloat v1) { GLCallTimer timer(GLCall_Uniform2f); glUniform2f(location, v0, v1); }
+#define glUniform2f counted_glUniform2f
+inline void counted_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) { GLCallTimer timer(GLCall_Uniform3f); glUniform3f(location, v0, v1, v2); }
+#define glUniform3f counted_glUniform3f
+inline void counted_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) { GLCallTimer timer(GLCall_Uniform4f); glUniform4f(location, v0, v1, v2, v3); }
+#define glUniform4f counted_glUniform4f
+inline void counted_glUniform1i(GLint location, GLint v0) { GLCallTimer timer(GLCall_Uniform1i); glUniform1i(location, v0); }
+#define glUniform1i counted_glUniform1i
+inline void counted_glUniform2i(GLint location, GLint v0, GLint v1) { GLCallTimer timer(GLCall_Uniform2i); glUniform2i(location, v0, v1); }
+#define glUniform2i counted_glUniform2i
+inline void counted_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) { GLCallTimer timer(GLCall_Uniform3i); glUniform3i(location, v0, v1, v2); }
+#define glUniform3i counted_glUniform3i
+inline void counted_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) { GLCallTimer timer(GLCall_Uniform4i); glUniform4i(location, v0, v1, v2, v3); }
+#define glUniform4i counted_glUniform4i
+inline void counted_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) { GLCallTimer timer(GLCall_Uniform1fv); glUniform1fv(location, count, value); }
+#define glUniform1fv counted_glUniform1fv
+inline void counted_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) { GLCallTimer timer(GLCall_Uniform2fv); glUniform2fv(location, count, value); }
+#define glUniform2fv counted_glUniform2fv
+inline void counted_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) { GLCallTimer timer(GLCall_Uniform3fv); glUniform3fv(location, count, value); }
+#define glUniform3fv counted_glUniform3fv
+inline void counted_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) { GLCallTimer timer(GLCall_Uniform4fv); glUniform4fv(location, count, value); }
+#define glUniform4fv counted_glUniform4fv
+inline void counted_glUniform1iv(GLint location, GLsizei count, const GLint *value) { GLCallTimer timer(GLCall_Uniform1iv); glUniform1iv(location, count, value); }
+#define glUniform1iv counted_glUniform1iv
+inline void counted_glUniform2iv(GLint location, GLsizei count, const GLint *value) { GLCallTimer timer(GLCall_Uniform2iv); glUniform2iv(location, count, value); }
+#define glUniform2iv counted_glUniform2iv
+inline void counted_glUniform3iv(GLint location, GLsizei count, const GLint *value) { GLCallTimer timer(GLCall_Uniform3iv); glUniform3iv(location, count, value); }
+#define glUniform3iv counted_glUniform3iv
+inline void counted_glUniform4iv(GLint location, GLsizei count, const GLint *value) { GLCallTimer timer(GLCall_Uniform4iv); glUniform4iv(location, count, value); }
+#define glUniform4iv counted_glUniform4iv
+inline void counted_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix2fv); glUniformMatrix2fv(location, count, transpose, value); }
+#define glUniformMatrix2fv counted_glUniformMatrix2fv
+inline void counted_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix3fv); glUniformMatrix3fv(location, count, transpose, value); }
+#define glUniformMatrix3fv counted_glUniformMatrix3fv
+inline void counted_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix4fv); glUniformMatrix4fv(location, count, transpose, value); }
+#define glUniformMatrix4fv counted_glUniformMatrix4fv
+inline void counted_glValidateProgram(GLuint program) { GLCallTimer timer(GLCall_ValidateProgram); glValidateProgram(program); }
+#define glValidateProgram counted_glValidateProgram
+inline void counted_glVertexAttrib1d(GLuint index, GLdouble x) { GLCallTimer timer(GLCall_VertexAttrib1d); glVertexAttrib1d(index, x); }
+#define glVertexAttrib1d counted_glVertexAttrib1d
+inline void counted_glVertexAttrib1dv(GLuint index, const GLdouble *v) { GLCallTimer timer(GLCall_VertexAttrib1dv); glVertexAttrib1dv(index, v); }
+#define glVertexAttrib1dv counted_glVertexAttrib1dv
+inline void counted_glVertexAttrib1f(GLuint index, GLfloat x) { GLCallTimer timer(GLCall_VertexAttrib1f); glVertexAttrib1f(index, x); }
+#define glVertexAttrib1f counted_glVertexAttrib1f
+inline void counted_glVertexAttrib1fv(GLuint index, const GLfloat *v) { GLCallTimer timer(GLCall_VertexAttrib1fv); glVertexAttrib1fv(index, v); }
+#define glVertexAttrib1fv counted_glVertexAttrib1fv
+inline void counted_glVertexAttrib1s(GLuint index, GLshort x) { GLCallTimer timer(GLCall_VertexAttrib1s); glVertexAttrib1s(index, x); }
+#define glVertexAttrib1s counted_glVertexAttrib1s
+inline void counted_glVertexAttrib1sv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttrib1sv); glVertexAttrib1sv(index, v); }
+#define glVertexAttrib1sv counted_glVertexAttrib1sv
+inline void counted_glVertexAttrib2d(GLuint index, GLdouble x, GLdouble y) { GLCallTimer timer(GLCall_VertexAttrib2d); glVertexAttrib2d(index, x, y); }
+#define glVertexAttrib2d counted_glVertexAttrib2d
+inline void counted_glVertexAttrib2dv(GLuint index, const GLdouble *v) { GLCallTimer timer(GLCall_VertexAttrib2dv); glVertexAttrib2dv(index, v); }
+#define glVertexAttrib2dv counted_glVertexAttrib2dv
+inline void counted_glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y) { GLCallTimer timer(GLCall_VertexAttrib2f); glVertexAttrib2f(index, x, y); }
+#define glVertexAttrib2f counted_glVertexAttrib2f
+inline void counted_glVertexAttrib2fv(GLuint index, const GLfloat *v) { GLCallTimer timer(GLCall_VertexAttrib2fv); glVertexAttrib2fv(index, v); }
+#define glVertexAttrib2fv counted_glVertexAttrib2fv
+inline void counted_glVertexAttrib2s(GLuint index, GLshort x, GLshort y) { GLCallTimer timer(GLCall_VertexAttrib2s); glVertexAttrib2s(index, x, y); }
+#define glVertexAttrib2s counted_glVertexAttrib2s
+inline void counted_glVertexAttrib2sv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttrib2sv); glVertexAttrib2sv(index, v); }
+#define glVertexAttrib2sv counted_glVertexAttrib2sv
+inline void counted_glVertexAttrib3d(GLuint index, GLdouble x, GLdouble y, GLdouble z) { GLCallTimer timer(GLCall_VertexAttrib3d); glVertexAttrib3d(index, x, y, z); }
+#define glVertexAttrib3d counted_glVertexAttrib3d
+inline void counted_glVertexAttrib3dv(GLuint index, const GLdouble *v) { GLCallTimer timer(GLCall_VertexAttrib3dv); glVertexAttrib3dv(index, v); }
+#define glVertexAttrib3dv counted_glVertexAttrib3dv
+inline void counted_glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z) { GLCallTimer timer(GLCall_VertexAttrib3f); glVertexAttrib3f(index, x, y, z); }
+#define glVertexAttrib3f counted_glVertexAttrib3f
+inline void counted_glVertexAttrib3fv(GLuint index, const GLfloat *v) { GLCallTimer timer(GLCall_VertexAttrib3fv); glVertexAttrib3fv(index, v); }
+#define glVertexAttrib3fv counted_glVertexAttrib3fv
+inline void counted_glVertexAttrib3s(GLuint index, GLshort x, GLshort y, GLshort z) { GLCallTimer timer(GLCall_VertexAttrib3s); glVertexAttrib3s(index, x, y, z); }
+#define glVertexAttrib3s counted_glVertexAttrib3s
+inline void counted_glVertexAttrib3sv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttrib3sv); glVertexAttrib3sv(index, v); }
+#define glVertexAttrib3sv counted_glVertexAttrib3sv
+inline void counted_glVertexAttrib4Nbv(GLuint index, const GLbyte *v) { GLCallTimer timer(GLCall_VertexAttrib4Nbv); glVertexAttrib4Nbv(index, v); }
+#define glVertexAttrib4Nbv counted_glVertexAttrib4Nbv
+inline void counted_glVertexAttrib4Niv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttrib4Niv); glVertexAttrib4Niv(index, v); }
+#define glVertexAttrib4Niv counted_glVertexAttrib4Niv
+inline void counted_glVertexAttrib4Nsv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttrib4Nsv); glVertexAttrib4Nsv(index, v); }
+#define glVertexAttrib4Nsv counted_glVertexAttrib4Nsv
+inline void counted_glVertexAttrib4Nub(GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w) { GLCallTimer timer(GLCall_VertexAttrib4Nub); glVertexAttrib4Nub(index, x, y, z, w); }
+#define glVertexAttrib4Nub counted_glVertexAttrib4Nub
+inline void counted_glVertexAttrib4Nubv(GLuint index, const GLubyte *v) { GLCallTimer timer(GLCall_VertexAttrib4Nubv); glVertexAttrib4Nubv(index, v); }
+#define glVertexAttrib4Nubv counted_glVertexAttrib4Nubv
+inline void counted_glVertexAttrib4Nuiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttrib4Nuiv); glVertexAttrib4Nuiv(index, v); }
+#define glVertexAttrib4Nuiv counted_glVertexAttrib4Nuiv
+inline void counted_glVertexAttrib4Nusv(GLuint index, const GLushort *v) { GLCallTimer timer(GLCall_VertexAttrib4Nusv); glVertexAttrib4Nusv(index, v); }
+#define glVertexAttrib4Nusv counted_glVertexAttrib4Nusv
+inline void counted_glVertexAttrib4bv(GLuint index, const GLbyte *v) { GLCallTimer timer(GLCall_VertexAttrib4bv); glVertexAttrib4bv(index, v); }
+#define glVertexAttrib4bv counted_glVertexAttrib4bv
+inline void counted_glVertexAttrib4d(GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w) { GLCallTimer timer(GLCall_VertexAttrib4d); glVertexAttrib4d(index, x, y, z, w); }
+#define glVertexAttrib4d counted_glVertexAttrib4d
+inline void counted_glVertexAttrib4dv(GLuint index, const GLdouble *v) { GLCallTimer timer(GLCall_VertexAttrib4dv); glVertexAttrib4dv(index, v); }
+#define glVertexAttrib4dv counted_glVertexAttrib4dv
+inline void counted_glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) { GLCallTimer timer(GLCall_VertexAttrib4f); glVertexAttrib4f(index, x, y, z, w); }
+#define glVertexAttrib4f counted_glVertexAttrib4f
+inline void counted_glVertexAttrib4fv(GLuint index, const GLfloat *v) { GLCallTimer timer(GLCall_VertexAttrib4fv); glVertexAttrib4fv(index, v); }
+#define glVertexAttrib4fv counted_glVertexAttrib4fv
+inline void counted_glVertexAttrib4iv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttrib4iv); glVertexAttrib4iv(index, v); }
+#define glVertexAttrib4iv counted_glVertexAttrib4iv
+inline void counted_glVertexAttrib4s(GLuint index, GLshort x, GLshort y, GLshort z, GLshort w) { GLCallTimer timer(GLCall_VertexAttrib4s); glVertexAttrib4s(index, x, y, z, w); }
+#define glVertexAttrib4s counted_glVertexAttrib4s
+inline void counted_glVertexAttrib4sv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttrib4sv); glVertexAttrib4sv(index, v); }
+#define glVertexAttrib4sv counted_glVertexAttrib4sv
+inline void counted_glVertexAttrib4ubv(GLuint index, const GLubyte *v) { GLCallTimer timer(GLCall_VertexAttrib4ubv); glVertexAttrib4ubv(index, v); }
+#define glVertexAttrib4ubv counted_glVertexAttrib4ubv
+inline void counted_glVertexAttrib4uiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttrib4uiv); glVertexAttrib4uiv(index, v); }
+#define glVertexAttrib4uiv counted_glVertexAttrib4uiv
+inline void counted_glVertexAttrib4usv(GLuint index, const GLushort *v) { GLCallTimer timer(GLCall_VertexAttrib4usv); glVertexAttrib4usv(index, v); }
+#define glVertexAttrib4usv counted_glVertexAttrib4usv
+inline void counted_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) { GLCallTimer timer(GLCall_VertexAttribPointer); glVertexAttribPointer(index, size, type, normalized, stride, pointer); }
+#define glVertexAttribPointer counted_glVertexAttribPointer
+
+// GL_VERSION_2_1:
+inline void counted_glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix2x3fv); glUniformMatrix2x3fv(location, count, transpose, value); }
+#define glUniformMatrix2x3fv counted_glUniformMatrix2x3fv
+inline void counted_glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix3x2fv); glUniformMatrix3x2fv(location, count, transpose, value); }
+#define glUniformMatrix3x2fv counted_glUniformMatrix3x2fv
+inline void counted_glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix2x4fv); glUniformMatrix2x4fv(location, count, transpose, value); }
+#define glUniformMatrix2x4fv counted_glUniformMatrix2x4fv
+inline void counted_glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix4x2fv); glUniformMatrix4x2fv(location, count, transpose, value); }
+#define glUniformMatrix4x2fv counted_glUniformMatrix4x2fv
+inline void counted_glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix3x4fv); glUniformMatrix3x4fv(location, count, transpose, value); }
+#define glUniformMatrix3x4fv counted_glUniformMatrix3x4fv
+inline void counted_glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { GLCallTimer timer(GLCall_UniformMatrix4x3fv); glUniformMatrix4x3fv(location, count, transpose, value); }
+#define glUniformMatrix4x3fv counted_glUniformMatrix4x3fv
+
+// GL_VERSION_3_0:
+inline void counted_glColorMaski(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a) { GLCallTimer timer(GLCall_ColorMaski); glColorMaski(index, r, g, b, a); }
+#define glColorMaski counted_glColorMaski
+inline void counted_glGetBooleani_v(GLenum target, GLuint index, GLboolean *data) { GLCallTimer timer(GLCall_GetBooleani_v); glGetBooleani_v(target, index, data); }
+#define glGetBooleani_v counted_glGetBooleani_v
+inline void counted_glGetIntegeri_v(GLenum target, GLuint index, GLint *data) { GLCallTimer timer(GLCall_GetIntegeri_v); glGetIntegeri_v(target, index, data); }
+#define glGetIntegeri_v counted_glGetIntegeri_v
+inline void counted_glEnablei(GLenum target, GLuint index) { GLCallTimer timer(GLCall_Enablei); glEnablei(target, index); }
+#define glEnablei counted_glEnablei
+inline void counted_glDisablei(GLenum target, GLuint index) { GLCallTimer timer(GLCall_Disablei); glDisablei(target, index); }
+#define glDisablei counted_glDisablei
+inline GLboolean counted_glIsEnabledi(GLenum target, GLuint index) { GLCallTimer timer(GLCall_IsEnabledi); return glIsEnabledi(target, index); }
+#define glIsEnabledi counted_glIsEnabledi
+inline void counted_glBeginTransformFeedback(GLenum primitiveMode) { GLCallTimer timer(GLCall_BeginTransformFeedback); glBeginTransformFeedback(primitiveMode); }
+#define glBeginTransformFeedback counted_glBeginTransformFeedback
+inline void counted_glEndTransformFeedback(void) { GLCallTimer timer(GLCall_EndTransformFeedback); glEndTransformFeedback(); }
+#define glEndTransformFeedback counted_glEndTransformFeedback
+inline void counted_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) { GLCallTimer timer(GLCall_BindBufferRange); glBindBufferRange(target, index, buffer, offset, size); }
+#define glBindBufferRange counted_glBindBufferRange
+inline void counted_glBindBufferBase(GLenum target, GLuint index, GLuint buffer) { GLCallTimer timer(GLCall_BindBufferBase); glBindBufferBase(target, index, buffer); }
+#define glBindBufferBase counted_glBindBufferBase
+inline void counted_glTransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode) { GLCallTimer timer(GLCall_TransformFeedbackVaryings); glTransformFeedbackVaryings(program, count, varyings, bufferMode); }
+#define glTransformFeedbackVaryings counted_glTransformFeedbackVaryings
+inline void counted_glGetTransformFeedbackVarying(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name) { GLCallTimer timer(GLCall_GetTransformFeedbackVarying); glGetTransformFeedbackVarying(program, index, bufSize, length, size, type, name); }
+#define glGetTransformFeedbackVarying counted_glGetTransformFeedbackVarying
+inline void counted_glClampColor(GLenum target, GLenum clamp) { GLCallTimer timer(GLCall_ClampColor); glClampColor(target, clamp); }
+#define glClampColor counted_glClampColor
+inline void counted_glBeginConditionalRender(GLuint id, GLenum mode) { GLCallTimer timer(GLCall_BeginConditionalRender); glBeginConditionalRender(id, mode); }
+#define glBeginConditionalRender counted_glBeginConditionalRender
+inline void counted_glEndConditionalRender(void) { GLCallTimer timer(GLCall_EndConditionalRender); glEndConditionalRender(); }
+#define glEndConditionalRender counted_glEndConditionalRender
+inline void counted_glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer) { GLCallTimer timer(GLCall_VertexAttribIPointer); glVertexAttribIPointer(index, size, type, stride, pointer); }
+#define glVertexAttribIPointer counted_glVertexAttribIPointer
+inline void counted_glGetVertexAttribIiv(GLuint index, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetVertexAttribIiv); glGetVertexAttribIiv(index, pname, params); }
+#define glGetVertexAttribIiv counted_glGetVertexAttribIiv
+inline void counted_glGetVertexAttribIuiv(GLuint index, GLenum pname, GLuint *params) { GLCallTimer timer(GLCall_GetVertexAttribIuiv); glGetVertexAttribIuiv(index, pname, params); }
+#define glGetVertexAttribIuiv counted_glGetVertexAttribIuiv
+inline void counted_glVertexAttribI1i(GLuint index, GLint x) { GLCallTimer timer(GLCall_VertexAttribI1i); glVertexAttribI1i(index, x); }
+#define glVertexAttribI1i counted_glVertexAttribI1i
+inline void counted_glVertexAttribI2i(GLuint index, GLint x, GLint y) { GLCallTimer timer(GLCall_VertexAttribI2i); glVertexAttribI2i(index, x, y); }
+#define glVertexAttribI2i counted_glVertexAttribI2i
+inline void counted_glVertexAttribI3i(GLuint index, GLint x, GLint y, GLint z) { GLCallTimer timer(GLCall_VertexAttribI3i); glVertexAttribI3i(index, x, y, z); }
+#define glVertexAttribI3i counted_glVertexAttribI3i
+inline void counted_glVertexAttribI4i(GLuint index, GLint x, GLint y, GLint z, GLint w) { GLCallTimer timer(GLCall_VertexAttribI4i); glVertexAttribI4i(index, x, y, z, w); }
+#define glVertexAttribI4i counted_glVertexAttribI4i
+inline void counted_glVertexAttribI1ui(GLuint index, GLuint x) { GLCallTimer timer(GLCall_VertexAttribI1ui); glVertexAttribI1ui(index, x); }
+#define glVertexAttribI1ui counted_glVertexAttribI1ui
+inline void counted_glVertexAttribI2ui(GLuint index, GLuint x, GLuint y) { GLCallTimer timer(GLCall_VertexAttribI2ui); glVertexAttribI2ui(index, x, y); }
+#define glVertexAttribI2ui counted_glVertexAttribI2ui
+inline void counted_glVertexAttribI3ui(GLuint index, GLuint x, GLuint y, GLuint z) { GLCallTimer timer(GLCall_VertexAttribI3ui); glVertexAttribI3ui(index, x, y, z); }
+#define glVertexAttribI3ui counted_glVertexAttribI3ui
+inline void counted_glVertexAttribI4ui(GLuint index, GLuint x, GLuint y, GLuint z, GLuint w) { GLCallTimer timer(GLCall_VertexAttribI4ui); glVertexAttribI4ui(index, x, y, z, w); }
+#define glVertexAttribI4ui counted_glVertexAttribI4ui
+inline void counted_glVertexAttribI1iv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttribI1iv); glVertexAttribI1iv(index, v); }
+#define glVertexAttribI1iv counted_glVertexAttribI1iv
+inline void counted_glVertexAttribI2iv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttribI2iv); glVertexAttribI2iv(index, v); }
+#define glVertexAttribI2iv counted_glVertexAttribI2iv
+inline void counted_glVertexAttribI3iv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttribI3iv); glVertexAttribI3iv(index, v); }
+#define glVertexAttribI3iv counted_glVertexAttribI3iv
+inline void counted_glVertexAttribI4iv(GLuint index, const GLint *v) { GLCallTimer timer(GLCall_VertexAttribI4iv); glVertexAttribI4iv(index, v); }
+#define glVertexAttribI4iv counted_glVertexAttribI4iv
+inline void counted_glVertexAttribI1uiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttribI1uiv); glVertexAttribI1uiv(index, v); }
+#define glVertexAttribI1uiv counted_glVertexAttribI1uiv
+inline void counted_glVertexAttribI2uiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttribI2uiv); glVertexAttribI2uiv(index, v); }
+#define glVertexAttribI2uiv counted_glVertexAttribI2uiv
+inline void counted_glVertexAttribI3uiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttribI3uiv); glVertexAttribI3uiv(index, v); }
+#define glVertexAttribI3uiv counted_glVertexAttribI3uiv
+inline void counted_glVertexAttribI4uiv(GLuint index, const GLuint *v) { GLCallTimer timer(GLCall_VertexAttribI4uiv); glVertexAttribI4uiv(index, v); }
+#define glVertexAttribI4uiv counted_glVertexAttribI4uiv
+inline void counted_glVertexAttribI4bv(GLuint index, const GLbyte *v) { GLCallTimer timer(GLCall_VertexAttribI4bv); glVertexAttribI4bv(index, v); }
+#define glVertexAttribI4bv counted_glVertexAttribI4bv
+inline void counted_glVertexAttribI4sv(GLuint index, const GLshort *v) { GLCallTimer timer(GLCall_VertexAttribI4sv); glVertexAttribI4sv(index, v); }
+#define glVertexAttribI4sv counted_glVertexAttribI4sv
+inline void counted_glVertexAttribI4ubv(GLuint index, const GLubyte *v) { GLCallTimer timer(GLCall_VertexAttribI4ubv); glVertexAttribI4ubv(index, v); }
+#define glVertexAttribI4ubv counted_glVertexAttribI4ubv
+inline void counted_glVertexAttribI4usv(GLuint index, const GLushort *v) { GLCallTimer timer(GLCall_VertexAttribI4usv); glVertexAttribI4usv(index, v); }
+#define glVertexAttribI4usv counted_glVertexAttribI4usv
+inline void counted_glGetUniformuiv(GLuint program, GLint location, GLuint *params) { GLCallTimer timer(GLCall_GetUniformuiv); glGetUniformuiv(program, location, params); }
+#define glGetUniformuiv counted_glGetUniformuiv
+inline void counted_glBindFragDataLocation(GLuint program, GLuint color, const GLchar *name) { GLCallTimer timer(GLCall_BindFragDataLocation); glBindFragDataLocation(program, color, name); }
+#define glBindFragDataLocation counted_glBindFragDataLocation
+inline GLint counted_glGetFragDataLocation(GLuint program, const GLchar *name) { GLCallTimer timer(GLCall_GetFragDataLocation); return glGetFragDataLocation(program, name); }
+#define glGetFragDataLocation counted_glGetFragDataLocation
+inline void counted_glUniform1ui(GLint location, GLuint v0) { GLCallTimer timer(GLCall_Uniform1ui); glUniform1ui(location, v0); }
+#define glUniform1ui counted_glUniform1ui
+inline void counted_glUniform2ui(GLint location, GLuint v0, GLuint v1) { GLCallTimer timer(GLCall_Uniform2ui); glUniform2ui(location, v0, v1); }
+#define glUniform2ui counted_glUniform2ui
+inline void counted_glUniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2) { GLCallTimer timer(GLCall_Uniform3ui); glUniform3ui(location, v0, v1, v2); }
+#define glUniform3ui counted_glUniform3ui
+inline void counted_glUniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) { GLCallTimer timer(GLCall_Uniform4ui); glUniform4ui(location, v0, v1, v2, v3); }
+#define glUniform4ui counted_glUniform4ui
+inline void counted_glUniform1uiv(GLint location, GLsizei count, const GLuint *value) { GLCallTimer timer(GLCall_Uniform1uiv); glUniform1uiv(location, count, value); }
+#define glUniform1uiv counted_glUniform1uiv
+inline void counted_glUniform2uiv(GLint location, GLsizei count, const GLuint *value) { GLCallTimer timer(GLCall_Uniform2uiv); glUniform2uiv(location, count, value); }
+#define glUniform2uiv counted_glUniform2uiv
+inline void counted_glUniform3uiv(GLint location, GLsizei count, const GLuint *value) { GLCallTimer timer(GLCall_Uniform3uiv); glUniform3uiv(location, count, value); }
+#define glUniform3uiv counted_glUniform3uiv
+inline void counted_glUniform4uiv(GLint location, GLsizei count, const GLuint *value) { GLCallTimer timer(GLCall_Uniform4uiv); glUniform4uiv(location, count, value); }
+#define glUniform4uiv counted_glUniform4uiv
+inline void counted_glTexParameterIiv(GLenum target, GLenum pname, const GLint *params) { GLCallTimer timer(GLCall_TexParameterIiv); glTexParameterIiv(target, pname, params); }
+#define glTexParameterIiv counted_glTexParameterIiv
+inline void counted_glTexParameterIuiv(GLenum target, GLenum pname, const GLuint *params) { GLCallTimer timer(GLCall_TexParameterIuiv); glTexParameterIuiv(target, pname, params); }
+#define glTexParameterIuiv counted_glTexParameterIuiv
+inline void counted_glGetTexParameterIiv(GLenum target, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetTexParameterIiv); glGetTexParameterIiv(target, pname, params); }
+#define glGetTexParameterIiv counted_glGetTexParameterIiv
+inline void counted_glGetTexParameterIuiv(GLenum target, GLenum pname, GLuint *params) { GLCallTimer timer(GLCall_GetTexParameterIuiv); glGetTexParameterIuiv(target, pname, params); }
+#define glGetTexParameterIuiv counted_glGetTexParameterIuiv
+inline void counted_glClearBufferiv(GLenum buffer, GLint drawbuffer, const GLint *value) { GLCallTimer timer(GLCall_ClearBufferiv); glClearBufferiv(buffer, drawbuffer, value); }
+#define glClearBufferiv counted_glClearBufferiv
+inline void counted_glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint *value) { GLCallTimer timer(GLCall_ClearBufferuiv); glClearBufferuiv(buffer, drawbuffer, value); }
+#define glClearBufferuiv counted_glClearBufferuiv
+inline void counted_glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat *value) { GLCallTimer timer(GLCall_ClearBufferfv); glClearBufferfv(buffer, drawbuffer, value); }
+#define glClearBufferfv counted_glClearBufferfv
+inline void counted_glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) { GLCallTimer timer(GLCall_ClearBufferfi); glClearBufferfi(buffer, drawbuffer, depth, stencil); }
+#define glClearBufferfi counted_glClearBufferfi
+inline const GLubyte * counted_glGetStringi(GLenum name, GLuint index) { GLCallTimer timer(GLCall_GetStringi); return glGetStringi(name, index); }
+#define glGetStringi counted_glGetStringi
+inline GLboolean counted_glIsRenderbuffer(GLuint renderbuffer) { GLCallTimer timer(GLCall_IsRenderbuffer); return glIsRenderbuffer(renderbuffer); }
+#define glIsRenderbuffer counted_glIsRenderbuffer
+inline void counted_glBindRenderbuffer(GLenum target, GLuint renderbuffer) { GLCallTimer timer(GLCall_BindRenderbuffer); glBindRenderbuffer(target, renderbuffer); }
+#define glBindRenderbuffer counted_glBindRenderbuffer
+inline void counted_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers) { GLCallTimer timer(GLCall_DeleteRenderbuffers); glDeleteRenderbuffers(n, renderbuffers); }
+#define glDeleteRenderbuffers counted_glDeleteRenderbuffers
+inline void counted_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers) { GLCallTimer timer(GLCall_GenRenderbuffers); glGenRenderbuffers(n, renderbuffers); }
+#define glGenRenderbuffers counted_glGenRenderbuffers
+inline void counted_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_RenderbufferStorage); glRenderbufferStorage(target, internalformat, width, height); }
+#define glRenderbufferStorage counted_glRenderbufferStorage
+inline void counted_glGetRenderbufferParameteriv(GLenum target, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetRenderbufferParameteriv); glGetRenderbufferParameteriv(target, pname, params); }
+#define glGetRenderbufferParameteriv counted_glGetRenderbufferParameteriv
+inline GLboolean counted_glIsFramebuffer(GLuint framebuffer) { GLCallTimer timer(GLCall_IsFramebuffer); return glIsFramebuffer(framebuffer); }
+#define glIsFramebuffer counted_glIsFramebuffer
+inline void counted_glBindFramebuffer(GLenum target, GLuint framebuffer) { GLCallTimer timer(GLCall_BindFramebuffer); glBindFramebuffer(target, framebuffer); }
+#define glBindFramebuffer counted_glBindFramebuffer
+inline void counted_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers) { GLCallTimer timer(GLCall_DeleteFramebuffers); glDeleteFramebuffers(n, framebuffers); }
+#define glDeleteFramebuffers counted_glDeleteFramebuffers
+inline void counted_glGenFramebuffers(GLsizei n, GLuint *framebuffers) { GLCallTimer timer(GLCall_GenFramebuffers); glGenFramebuffers(n, framebuffers); }
+#define glGenFramebuffers counted_glGenFramebuffers
+inline GLenum counted_glCheckFramebufferStatus(GLenum target) { GLCallTimer timer(GLCall_CheckFramebufferStatus); return glCheckFramebufferStatus(target); }
+#define glCheckFramebufferStatus counted_glCheckFramebufferStatus
+inline void counted_glFramebufferTexture1D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { GLCallTimer timer(GLCall_FramebufferTexture1D); glFramebufferTexture1D(target, attachment, textarget, texture, level); }
+#define glFramebufferTexture1D counted_glFramebufferTexture1D
+inline void counted_glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { GLCallTimer timer(GLCall_FramebufferTexture2D); glFramebufferTexture2D(target, attachment, textarget, texture, level); }
+#define glFramebufferTexture2D counted_glFramebufferTexture2D
+inline void counted_glFramebufferTexture3D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset) { GLCallTimer timer(GLCall_FramebufferTexture3D); glFramebufferTexture3D(target, attachment, textarget, texture, level, zoffset); }
+#define glFramebufferTexture3D counted_glFramebufferTexture3D
+inline void counted_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { GLCallTimer timer(GLCall_FramebufferRenderbuffer); glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer); }
+#define glFramebufferRenderbuffer counted_glFramebufferRenderbuffer
+inline void counted_glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetFramebufferAttachmentParameteriv); glGetFramebufferAttachmentParameteriv(target, attachment, pname, params); }
+#define glGetFramebufferAttachmentParameteriv counted_glGetFramebufferAttachmentParameteriv
+inline void counted_glGenerateMipmap(GLenum target) { GLCallTimer timer(GLCall_GenerateMipmap); glGenerateMipmap(target); }
+#define glGenerateMipmap counted_glGenerateMipmap
+inline void counted_glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) { GLCallTimer timer(GLCall_BlitFramebuffer); glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter); }
+#define glBlitFramebuffer counted_glBlitFramebuffer
+inline void counted_glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height) { GLCallTimer timer(GLCall_RenderbufferStorageMultisample); glRenderbufferStorageMultisample(target, samples, internalformat, width, height); }
+#define glRenderbufferStorageMultisample counted_glRenderbufferStorageMultisample
+inline void counted_glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer) { GLCallTimer timer(GLCall_FramebufferTextureLayer); glFramebufferTextureLayer(target, attachment, texture, level, layer); }
+#define glFramebufferTextureLayer counted_glFramebufferTextureLayer
+inline void * counted_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) { GLCallTimer timer(GLCall_MapBufferRange); return glMapBufferRange(target, offset, length, access); }
+#define glMapBufferRange counted_glMapBufferRange
+inline void counted_glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length) { GLCallTimer timer(GLCall_FlushMappedBufferRange); glFlushMappedBufferRange(target, offset, length); }
+#define glFlushMappedBufferRange counted_glFlushMappedBufferRange
+inline void counted_glBindVertexArray(GLuint array) { GLCallTimer timer(GLCall_BindVertexArray); glBindVertexArray(array); }
+#define glBindVertexArray counted_glBindVertexArray
+inline void counted_glDeleteVertexArrays(GLsizei n, const GLuint *arrays) { GLCallTimer timer(GLCall_DeleteVertexArrays); glDeleteVertexArrays(n, arrays); }
+#define glDeleteVertexArrays counted_glDeleteVertexArrays
+inline void counted_glGenVertexArrays(GLsizei n, GLuint *arrays) { GLCallTimer timer(GLCall_GenVertexArrays); glGenVertexArrays(n, arrays); }
+#define glGenVertexArrays counted_glGenVertexArrays
+inline GLboolean counted_glIsVertexArray(GLuint array) { GLCallTimer timer(GLCall_IsVertexArray); return glIsVertexArray(array); }
+#define glIsVertexArray counted_glIsVertexArray
+
+// GL_VERSION_3_1:
+inline void counted_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) { GLCallTimer timer(GLCall_DrawArraysInstanced); glDrawArraysInstanced(mode, first, count, instancecount); }
+#define glDrawArraysInstanced counted_glDrawArraysInstanced
+inline void counted_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount) { GLCallTimer timer(GLCall_DrawElementsInstanced); glDrawElementsInstanced(mode, count, type, indices, instancecount); }
+#define glDrawElementsInstanced counted_glDrawElementsInstanced
+inline void counted_glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) { GLCallTimer timer(GLCall_TexBuffer); glTexBuffer(target, internalformat, buffer); }
+#define glTexBuffer counted_glTexBuffer
+inline void counted_glPrimitiveRestartIndex(GLuint index) { GLCallTimer timer(GLCall_PrimitiveRestartIndex); glPrimitiveRestartIndex(index); }
+#define glPrimitiveRestartIndex counted_glPrimitiveRestartIndex
+inline void counted_glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) { GLCallTimer timer(GLCall_CopyBufferSubData); glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size); }
+#define glCopyBufferSubData counted_glCopyBufferSubData
+inline void counted_glGetUniformIndices(GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices) { GLCallTimer timer(GLCall_GetUniformIndices); glGetUniformIndices(program, uniformCount, uniformNames, uniformIndices); }
+#define glGetUniformIndices counted_glGetUniformIndices
+inline void counted_glGetActiveUniformsiv(GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetActiveUniformsiv); glGetActiveUniformsiv(program, uniformCount, uniformIndices, pname, params); }
+#define glGetActiveUniformsiv counted_glGetActiveUniformsiv
+inline void counted_glGetActiveUniformName(GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName) { GLCallTimer timer(GLCall_GetActiveUniformName); glGetActiveUniformName(program, uniformIndex, bufSize, length, uniformName); }
+#define glGetActiveUniformName counted_glGetActiveUniformName
+inline GLuint counted_glGetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName) { GLCallTimer timer(GLCall_GetUniformBlockIndex); return glGetUniformBlockIndex(program, uniformBlockName); }
+#define glGetUniformBlockIndex counted_glGetUniformBlockIndex
+inline void counted_glGetActiveUniformBlockiv(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetActiveUniformBlockiv); glGetActiveUniformBlockiv(program, uniformBlockIndex, pname, params); }
+#define glGetActiveUniformBlockiv counted_glGetActiveUniformBlockiv
+inline void counted_glGetActiveUniformBlockName(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName) { GLCallTimer timer(GLCall_GetActiveUniformBlockName); glGetActiveUniformBlockName(program, uniformBlockIndex, bufSize, length, uniformBlockName); }
+#define glGetActiveUniformBlockName counted_glGetActiveUniformBlockName
+inline void counted_glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) { GLCallTimer timer(GLCall_UniformBlockBinding); glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding); }
+#define glUniformBlockBinding counted_glUniformBlockBinding
+
+// GL_VERSION_3_2:
+inline void counted_glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) { GLCallTimer timer(GLCall_DrawElementsBaseVertex); glDrawElementsBaseVertex(mode, count, type, indices, basevertex); }
+#define glDrawElementsBaseVertex counted_glDrawElementsBaseVertex
+inline void counted_glDrawRangeElementsBaseVertex(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex) { GLCallTimer timer(GLCall_DrawRangeElementsBaseVertex); glDrawRangeElementsBaseVertex(mode, start, end, count, type, indices, basevertex); }
+#define glDrawRangeElementsBaseVertex counted_glDrawRangeElementsBaseVertex
+inline void counted_glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex) { GLCallTimer timer(GLCall_DrawElementsInstancedBaseVertex); glDrawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex); }
+#define glDrawElementsInstancedBaseVertex counted_glDrawElementsInstancedBaseVertex
+inline void counted_glMultiDrawElementsBaseVertex(GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex) { GLCallTimer timer(GLCall_MultiDrawElementsBaseVertex); glMultiDrawElementsBaseVertex(mode, count, type, indices, drawcount, basevertex); }
+#define glMultiDrawElementsBaseVertex counted_glMultiDrawElementsBaseVertex
+inline void counted_glProvokingVertex(GLenum mode) { GLCallTimer timer(GLCall_ProvokingVertex); glProvokingVertex(mode); }
+#define glProvokingVertex counted_glProvokingVertex
+inline GLsync counted_glFenceSync(GLenum condition, GLbitfield flags) { GLCallTimer timer(GLCall_FenceSync); return glFenceSync(condition, flags); }
+#define glFenceSync counted_glFenceSync
+inline GLboolean counted_glIsSync(GLsync sync) { GLCallTimer timer(GLCall_IsSync); return glIsSync(sync); }
+#define glIsSync counted_glIsSync
+inline void counted_glDeleteSync(GLsync sync) { GLCallTimer timer(GLCall_DeleteSync); glDeleteSync(sync); }
+#define glDeleteSync counted_glDeleteSync
+inline GLenum counted_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { GLCallTimer timer(GLCall_ClientWaitSync); return glClientWaitSync(sync, flags, timeout); }
+#define glClientWaitSync counted_glClientWaitSync
+inline void counted_glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { GLCallTimer timer(GLCall_WaitSync); glWaitSync(sync, flags, timeout); }
+#define glWaitSync counted_glWaitSync
+inline void counted_glGetInteger64v(GLenum pname, GLint64 *data) { GLCallTimer timer(GLCall_GetInteger64v); glGetInteger64v(pname, data); }
+#define glGetInteger64v counted_glGetInteger64v
+inline void counted_glGetSynciv(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values) { GLCallTimer timer(GLCall_GetSynciv); glGetSynciv(sync, pname, bufSize, length, values); }
+#define glGetSynciv counted_glGetSynciv
+inline void counted_glGetInteger64i_v(GLenum target, GLuint index, GLint64 *data) { GLCallTimer timer(GLCall_GetInteger64i_v); glGetInteger64i_v(target, index, data); }
+#define glGetInteger64i_v counted_glGetInteger64i_v
+inline void counted_glGetBufferParameteri64v(GLenum target, GLenum pname, GLint64 *params) { GLCallTimer timer(GLCall_GetBufferParameteri64v); glGetBufferParameteri64v(target, pname, params); }
+#define glGetBufferParameteri64v counted_glGetBufferParameteri64v
+inline void counted_glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level) { GLCallTimer timer(GLCall_FramebufferTexture); glFramebufferTexture(target, attachment, texture, level); }
+#define glFramebufferTexture counted_glFramebufferTexture
+inline void counted_glTexImage2DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations) { GLCallTimer timer(GLCall_TexImage2DMultisample); glTexImage2DMultisample(target, samples, internalformat, width, height, fixedsamplelocations); }
+#define glTexImage2DMultisample counted_glTexImage2DMultisample
+inline void counted_glTexImage3DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations) { GLCallTimer timer(GLCall_TexImage3DMultisample); glTexImage3DMultisample(target, samples, internalformat, width, height, depth, fixedsamplelocations); }
+#define glTexImage3DMultisample counted_glTexImage3DMultisample
+inline void counted_glGetMultisamplefv(GLenum pname, GLuint index, GLfloat *val) { GLCallTimer timer(GLCall_GetMultisamplefv); glGetMultisamplefv(pname, index, val); }
+#define glGetMultisamplefv counted_glGetMultisamplefv
+inline void counted_glSampleMaski(GLuint maskNumber, GLbitfield mask) { GLCallTimer timer(GLCall_SampleMaski); glSampleMaski(maskNumber, mask); }
+#define glSampleMaski counted_glSampleMaski
+
+// GL_VERSION_3_3:
+#ifndef _WIN32 //(gl_shims.hpp stops at 3.2)
+inline void counted_glBindFragDataLocationIndexed(GLuint program, GLuint colorNumber, GLuint index, const GLchar *name) { GLCallTimer timer(GLCall_BindFragDataLocationIndexed); glBindFragDataLocationIndexed(program, colorNumber, index, name); }
+#define glBindFragDataLocationIndexed counted_glBindFragDataLocationIndexed
+inline GLint counted_glGetFragDataIndex(GLuint program, const GLchar *name) { GLCallTimer timer(GLCall_GetFragDataIndex); return glGetFragDataIndex(program, name); }
+#define glGetFragDataIndex counted_glGetFragDataIndex
+inline void counted_glGenSamplers(GLsizei count, GLuint *samplers) { GLCallTimer timer(GLCall_GenSamplers); glGenSamplers(count, samplers); }
+#define glGenSamplers counted_glGenSamplers
+inline void counted_glDeleteSamplers(GLsizei count, const GLuint *samplers) { GLCallTimer timer(GLCall_DeleteSamplers); glDeleteSamplers(count, samplers); }
+#define glDeleteSamplers counted_glDeleteSamplers
+inline GLboolean counted_glIsSampler(GLuint sampler) { GLCallTimer timer(GLCall_IsSampler); return glIsSampler(sampler); }
+#define glIsSampler counted_glIsSampler
+inline void counted_glBindSampler(GLuint unit, GLuint sampler) { GLCallTimer timer(GLCall_BindSampler); glBindSampler(unit, sampler); }
+#define glBindSampler counted_glBindSampler
+inline void counted_glSamplerParameteri(GLuint sampler, GLenum pname, GLint param) { GLCallTimer timer(GLCall_SamplerParameteri); glSamplerParameteri(sampler, pname, param); }
+#define glSamplerParameteri counted_glSamplerParameteri
+inline void counted_glSamplerParameteriv(GLuint sampler, GLenum pname, const GLint *param) { GLCallTimer timer(GLCall_SamplerParameteriv); glSamplerParameteriv(sampler, pname, param); }
+#define glSamplerParameteriv counted_glSamplerParameteriv
+inline void counted_glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param) { GLCallTimer timer(GLCall_SamplerParameterf); glSamplerParameterf(sampler, pname, param); }
+#define glSamplerParameterf counted_glSamplerParameterf
+inline void counted_glSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat *param) { GLCallTimer timer(GLCall_SamplerParameterfv); glSamplerParameterfv(sampler, pname, param); }
+#define glSamplerParameterfv counted_glSamplerParameterfv
+inline void counted_glSamplerParameterIiv(GLuint sampler, GLenum pname, const GLint *param) { GLCallTimer timer(GLCall_SamplerParameterIiv); glSamplerParameterIiv(sampler, pname, param); }
+#define glSamplerParameterIiv counted_glSamplerParameterIiv
+inline void counted_glSamplerParameterIuiv(GLuint sampler, GLenum pname, const GLuint *param) { GLCallTimer timer(GLCall_SamplerParameterIuiv); glSamplerParameterIuiv(sampler, pname, param); }
+#define glSamplerParameterIuiv counted_glSamplerParameterIuiv
+inline void counted_glGetSamplerParameteriv(GLuint sampler, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetSamplerParameteriv); glGetSamplerParameteriv(sampler, pname, params); }
+#define glGetSamplerParameteriv counted_glGetSamplerParameteriv
+inline void counted_glGetSamplerParameterIiv(GLuint sampler, GLenum pname, GLint *params) { GLCallTimer timer(GLCall_GetSamplerParameterIiv); glGetSamplerParameterIiv(sampler, pname, params); }
+#define glGetSamplerParameterIiv counted_glGetSamplerParameterIiv
+inline void counted_glGetSamplerParameterfv(GLuint sampler, GLenum pname, GLfloat *params) { GLCallTimer timer(GLCall_GetSamplerParameterfv); glGetSamplerParameterfv(sampler, pname, params); }
+#define glGetSamplerParameterfv counted_glGetSamplerParameterfv
+inline void counted_glGetSamplerParameterIuiv(GLuint sampler, GLenum pname, GLuint *params) { GLCallTimer timer(GLCall_GetSamplerParameterIuiv); glGetSamplerParameterIuiv(sampler, pname, params); }
+#define glGetSamplerParameterIuiv counted_glGetSamplerParameterIuiv
+inline void counted_glQueryCounter(GLuint id, GLenum target) { GLCallTimer timer(GLCall_QueryCounter); glQueryCounter(id, target); }
+#define glQueryCounter counted_glQueryCounter
+inline void counted_glGetQueryObjecti64v(GLuint id, GLenum pname, GLint64 *params) { GLCallTimer timer(GLCall_GetQueryObjecti64v); glGetQueryObjecti64v(id, pname, params); }
+#define glGetQueryObjecti64v counted_glGetQueryObjecti64v
+inline void counted_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params) { GLCallTimer timer(GLCall_GetQueryObjectui64v); glGetQueryObjectui64v(id, pname, params); }
+#define glGetQueryObjectui64v counted_glGetQueryObjectui64v
+inline void counted_glVertexAttribDivisor(GLuint index, GLuint divisor) { GLCallTimer timer(GLCall_VertexAttribDivisor); glVertexAttribDivisor(index, divisor); }
+#define glVertexAttribDivisor counted_glVertexAttribDivisor
+inline void counted_glVertexAttribP1ui(GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLCallTimer timer(GLCall_VertexAttribP1ui); glVertexAttribP1ui(index, type, normalized, value); }
+#define glVertexAttribP1ui counted_glVertexAttribP1ui
+inline void counted_glVertexAttribP1uiv(GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLCallTimer timer(GLCall_VertexAttribP1uiv); glVertexAttribP1uiv(index, type, normalized, value); }
+#define glVertexAttribP1uiv counted_glVertexAttribP1uiv
+inline void counted_glVertexAttribP2ui(GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLCallTimer timer(GLCall_VertexAttribP2ui); glVertexAttribP2ui(index, type, normalized, value); }
+#define glVertexAttribP2ui counted_glVertexAttribP2ui
+inline void counted_glVertexAttribP2uiv(GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLCallTimer timer(GLCall_VertexAttribP2uiv); glVertexAttribP2uiv(index, type, normalized, value); }
+#define glVertexAttribP2uiv counted_glVertexAttribP2uiv
+inline void counted_glVertexAttribP3ui(GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLCallTimer timer(GLCall_VertexAttribP3ui); glVertexAttribP3ui(index, type, normalized, value); }
+#define glVertexAttribP3ui counted_glVertexAttribP3ui
+inline void counted_glVertexAttribP3uiv(GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLCallTimer timer(GLCall_VertexAttribP3uiv); glVertexAttribP3uiv(index, type, normalized, value); }
+#define glVertexAttribP3uiv counted_glVertexAttribP3uiv
+inline void counted_glVertexAttribP4ui(GLuint index, GLenum type, GLboolean normalized, GLuint value) { GLCallTimer timer(GLCall_VertexAttribP4ui); glVertexAttribP4ui(index, type, normalized, value); }
+#define glVertexAttribP4ui counted_glVertexAttribP4ui
+inline void counted_glVertexAttribP4uiv(GLuint index, GLenum type, GLboolean normalized, const GLuint *value) { GLCallTimer timer(GLCall_VertexAttribP4uiv); glVertexAttribP4uiv(index, type, normalized, value); }
+#define glVertexAttribP4uiv counted_glVertexAttribP4uiv
+#endif
@@ -0,0 +1,150 @@
+#include "gl_state.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+void GLState::use_program(GLuint program_) {
+	if (changed(UseProgram, program_ != program)) {
+		glUseProgram(program_);
+		program = program_;
+	}
+}
+
+void GLState::bind_vertex_array(GLuint vao) {
+	if (changed(BindVertexArray, vao != vertex_array)) {
+		glBindVertexArray(vao);
+		vertex_array = vao;
+	}
+}
+
+void GLState::bind_array_buffer(GLuint buffer) {
+	if (changed(BindBuffer, buffer != array_buffer)) {
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		array_buffer = buffer;
+	}
+}
+
+void GLState::bind_texture_2d(uint32_t unit, GLuint texture) {
+	if (changed(ActiveTexture, unit != active_unit)) {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		active_unit = unit;
+	}
+	if (unit >= MaxTextureUnits) { //not tracked
+		changed(BindTexture, true);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		return;
+	}
+	if (changed(BindTexture, texture != textures[unit])) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+		textures[unit] = texture;
+	}
+}
+
+void GLState::set_enabled(GLenum capability, bool enabled) {
+	Capability *found = nullptr;
+	for (uint32_t i = 0; i < capability_count; ++i) {
+		if (capabilities[i].name == capability) found = &capabilities[i];
+	}
+	if (found && !changed(EnableDisable, found->enabled != enabled)) return;
+	if (!found) {
+		changed(EnableDisable, true);
+		if (capability_count < MaxCapabilities) {
+			found = &capabilities[capability_count++];
+			found->name = capability;
+		}
+	}
+	if (enabled) glEnable(capability);
+	else glDisable(capability);
+	if (found) found->enabled = enabled;
+}
+
+void GLState::blend_func(GLenum source, GLenum destination) {
+	if (changed(BlendFunc, source != blend_source || destination != blend_destination)) {
+		glBlendFunc(source, destination);
+		blend_source = source;
+		blend_destination = destination;
+	}
+}
+
+void GLState::clear_color(glm::vec4 const &color) {
+	if (changed(ClearColor, !clear_color_known || color != clear_color_value)) {
+		glClearColor(color.r, color.g, color.b, color.a);
+		clear_color_value = color;
+		clear_color_known = true;
+	}
+}
+
+template< typename T >
+bool GLState::uniform_changed(GLint location, T const &value) {
+	static_assert(sizeof(T) <= sizeof(UniformValue::value), "uniform values fit in the cache");
+	if (program == Unknown) return changed(Uniform, true);
+	UniformValue *found = nullptr;
+	for (auto &entry : uniforms) {
+		if (entry.program == program && entry.location == location) found = &entry;
+	}
+	if (found && found->size == sizeof(T) && std::memcmp(found->value, &value, sizeof(T)) == 0) {
+		return changed(Uniform, false);
+	}
+	if (!found) {
+		uniforms.emplace_back();
+		found = &uniforms.back();
+		found->program = program;
+		found->location = location;
+	}
+	found->size = sizeof(T);
+	std::memcpy(found->value, &value, sizeof(T));
+	return changed(Uniform, true);
+}
+
+void GLState::uniform(GLint location, GLint value) {
+	if (uniform_changed(location, value)) {
+		glUniform1i(location, value);
+	}
+}
+
+void GLState::uniform(GLint location, glm::mat4 const &value) {
+	if (uniform_changed(location, value)) {
+		glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+	}
+}
+
+void GLState::array_buffer_data(void const *data, size_t size, GLenum usage) {
+	changed(BufferData, true);
+	glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+}
+
+void GLState::invalidate() {
+	program = Unknown;
+	vertex_array = Unknown;
+	array_buffer = Unknown;
+	active_unit = Unknown;
+	for (auto &texture : textures) {
+		texture = Unknown;
+	}
+	capability_count = 0;
+	blend_source = blend_destination = Unknown;
+	clear_color_known = false;
+	uniforms.clear();
+}
+
+void GLState::begin_frame() {
+	last_frame = frame;
+	frame = Counts();
+}
+
+void GLState::print_counts(Counts const &counts) {
+	static char const *names[CallKinds] = {
+		"program", "vao", "buffer", "active texture", "texture", "enable", "blend func", "clear color", "uniform", "buffer data"
+	};
+	uint32_t issued = 0, elided = 0;
+	for (uint32_t i = 0; i < CallKinds; ++i) {
+		issued += counts.issued[i];
+		elided += counts.elided[i];
+	}
+	std::printf("gl state calls: %u issued, %u elided (issued/elided:", issued, elided);
+	for (uint32_t i = 0; i < CallKinds; ++i) {
+		if (counts.issued[i] + counts.elided[i] == 0) continue;
+		std::printf(" %s %u/%u", names[i], counts.issued[i], counts.elided[i]);
+	}
+	std::printf(")\n");
+}
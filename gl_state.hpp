@@ -0,0 +1,113 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Shadow copy of the GL state the frame loop sets, in front of the GL calls
+ * that set it: a call that would not change anything is skipped.
+ *
+ * Tracked: the current program, vertex array, GL_ARRAY_BUFFER binding, active
+ * texture unit and the GL_TEXTURE_2D bound on each unit, enabled capabilities,
+ * blend function, clear color and uniform values per (program, location).
+ * Buffer contents are not tracked: the streamed vertices change every frame
+ * that gets drawn (a still picture is not sent to be drawn at all), so
+ * comparing them would only add a copy and a memcmp to each upload.
+ *
+ * Everything starts out unknown, so the first call of each kind is always
+ * issued. Code that changes GL state without going through this (e.g. setup
+ * code) should call invalidate() before the tracker is relied on again.
+ *
+ * Counts of issued and skipped ("elided") calls are kept per frame.
+ */
+
+struct GLState {
+	enum Call {
+		UseProgram = 0,
+		BindVertexArray,
+		BindBuffer,
+		ActiveTexture,
+		BindTexture,
+		EnableDisable,
+		BlendFunc,
+		ClearColor,
+		Uniform,
+		BufferData,
+		CallKinds
+	};
+
+	struct Counts {
+		uint32_t issued[CallKinds] = { };
+		uint32_t elided[CallKinds] = { };
+	};
+
+	GLState() { invalidate(); }
+
+	void use_program(GLuint program);
+	void bind_vertex_array(GLuint vao);
+	void bind_array_buffer(GLuint buffer);
+	//bind 'texture' to GL_TEXTURE_2D of texture unit 'unit' (leaves that unit active):
+	void bind_texture_2d(uint32_t unit, GLuint texture);
+	void set_enabled(GLenum capability, bool enabled);
+	void blend_func(GLenum source, GLenum destination);
+	void clear_color(glm::vec4 const &color);
+
+	//uniforms of the current program (set with use_program()):
+	void uniform(GLint location, GLint value);
+	void uniform(GLint location, glm::mat4 const &value);
+
+	//Fill the bound GL_ARRAY_BUFFER (set with bind_array_buffer()) with 'size' bytes
+	//of 'data' (always issued; counted with the rest):
+	void array_buffer_data(void const *data, size_t size, GLenum usage);
+
+	//forget everything (GL state was changed behind the tracker's back):
+	void invalidate();
+
+	//start counting a new frame (last_frame keeps the one before):
+	void begin_frame();
+	Counts frame;
+	Counts last_frame;
+
+	//print 'counts' as one line to stdout (printf, so it does not allocate):
+	static void print_counts(Counts const &counts);
+
+private:
+	static const GLuint Unknown = 0xffffffff;
+	enum { MaxTextureUnits = 4, MaxCapabilities = 8 };
+
+	bool changed(Call call, bool differs) {
+		(differs ? frame.issued : frame.elided)[call] += 1;
+		return differs;
+	}
+	template< typename T >
+	bool uniform_changed(GLint location, T const &value);
+
+	GLuint program = Unknown;
+	GLuint vertex_array = Unknown;
+	GLuint array_buffer = Unknown;
+	GLuint active_unit = Unknown;
+	GLuint textures[MaxTextureUnits];
+
+	struct Capability {
+		GLenum name;
+		bool enabled;
+	};
+	Capability capabilities[MaxCapabilities];
+	uint32_t capability_count = 0;
+
+	GLenum blend_source = Unknown, blend_destination = Unknown;
+	bool clear_color_known = false;
+	glm::vec4 clear_color_value;
+
+	struct UniformValue {
+		GLuint program;
+		GLint location;
+		uint32_t size; //bytes used of 'value'
+		unsigned char value[sizeof(glm::mat4)];
+	};
+	std::vector< UniformValue > uniforms;
+};
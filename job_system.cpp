@@ -0,0 +1,118 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+
+JobSystem::JobSystem(uint32_t threads) : queued(0) {
+	if (threads == 0) threads = std::thread::hardware_concurrency();
+	if (threads == 0) threads = 1;
+
+	for (uint32_t i = 0; i < threads; ++i) {
+		queues.emplace_back(new Queue);
+	}
+	//queue 0 belongs to the caller of parallel_for():
+	for (uint32_t i = 1; i < threads; ++i) {
+		workers.emplace_back(&JobSystem::worker, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard< std::mutex > lock(sleep_mutex);
+		quit = true;
+	}
+	wake.notify_all();
+	for (auto &t : workers) {
+		t.join();
+	}
+}
+
+void JobSystem::parallel_for(uint32_t count, uint32_t grain, RangeFn const &fn) {
+	if (count == 0) return;
+	if (grain == 0) grain = 1;
+
+	//not worth waking anyone for a single chunk:
+	if (count <= grain || queues.size() == 1) {
+		fn(0, count);
+		return;
+	}
+
+	uint32_t chunks = (count + grain - 1) / grain;
+	std::atomic< uint32_t > remaining(chunks);
+
+	//deal chunks round-robin so every worker starts with local work:
+	for (uint32_t c = 0; c < chunks; ++c) {
+		Task task;
+		task.fn = &fn;
+		task.begin = c * grain;
+		task.end = std::min(count, task.begin + grain);
+		task.remaining = &remaining;
+		Queue &q = *queues[c % queues.size()];
+		std::lock_guard< std::mutex > lock(q.mutex);
+		q.tasks.push_back(task);
+	}
+	//publish them only now, so a woken worker finds them there:
+	{
+		std::lock_guard< std::mutex > lock(sleep_mutex);
+		queued += int32_t(chunks);
+	}
+	wake.notify_all();
+
+	//help out until the whole batch has finished:
+	while (remaining.load() != 0) {
+		Task task;
+		if (pop(0, &task) || steal(0, &task)) {
+			run(task);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::pop(uint32_t self, Task *task) {
+	Queue &q = *queues[self];
+	std::lock_guard< std::mutex > lock(q.mutex);
+	if (q.head == q.tasks.size()) return false;
+	*task = q.tasks.back();
+	q.tasks.pop_back();
+	if (q.head == q.tasks.size()) {
+		q.tasks.clear();
+		q.head = 0;
+	}
+	queued -= 1;
+	return true;
+}
+
+bool JobSystem::steal(uint32_t self, Task *task) {
+	for (uint32_t i = 1; i < queues.size(); ++i) {
+		Queue &q = *queues[(self + i) % queues.size()];
+		std::lock_guard< std::mutex > lock(q.mutex);
+		if (q.head == q.tasks.size()) continue;
+		*task = q.tasks[q.head++];
+		if (q.head == q.tasks.size()) {
+			q.tasks.clear();
+			q.head = 0;
+		}
+		queued -= 1;
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::run(Task const &task) {
+	(*task.fn)(task.begin, task.end);
+	task.remaining->fetch_sub(1);
+}
+
+void JobSystem::worker(uint32_t self) {
+	while (true) {
+		Task task;
+		if (pop(self, &task) || steal(self, &task)) {
+			run(task);
+			continue;
+		}
+		std::unique_lock< std::mutex > lock(sleep_mutex);
+		//(taking a task lowers 'queued' without the lock: nobody waits for it to drop)
+		wake.wait(lock, [this](){ return quit || queued.load() > 0; });
+		if (quit) return;
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Small work-stealing job system.
+ *
+ * Every worker owns a deque: it pops its own work from the back and steals
+ * from the front of the others' when it runs dry. Threads that call
+ * parallel_for() share deque 0 and work alongside the pool until their batch
+ * is done, so parallel_for() acts as a join.
+ *
+ * parallel_for() may be called from several threads at once (at startup the
+ * atlas decode thread builds mips while the main thread runs): every task
+ * carries its own batch's counter, and a caller that helps out may run
+ * another caller's chunks, so a call can take longer than its own batch but
+ * always returns once that batch is done. A task must not call parallel_for().
+ * Once the queues have grown to the largest batch seen, it does not allocate.
+ */
+
+struct JobSystem {
+	//non-owning reference to a callable(begin, end); it only has to outlive the parallel_for() call
+	//(unlike std::function, wrapping a lambda never allocates):
+	struct RangeFn {
+		template< typename F, typename = typename std::enable_if< !std::is_same< typename std::decay< F >::type, RangeFn >::value >::type >
+		RangeFn(F const &fn) : object(&fn), call(&invoke< F >) { }
+		void operator()(uint32_t begin, uint32_t end) const { call(object, begin, end); }
+	private:
+		template< typename F >
+		static void invoke(void const *object, uint32_t begin, uint32_t end) {
+			(*static_cast< F const * >(object))(begin, end);
+		}
+		void const *object;
+		void (*call)(void const *, uint32_t, uint32_t);
+	};
+
+	//'threads' counts the calling thread; 0 picks std::thread::hardware_concurrency():
+	explicit JobSystem(uint32_t threads = 0);
+	~JobSystem();
+
+	JobSystem(JobSystem const &) = delete;
+	JobSystem &operator=(JobSystem const &) = delete;
+
+	//run fn over [0,count) in chunks of at most 'grain' items; returns when all chunks are done:
+	void parallel_for(uint32_t count, uint32_t grain, RangeFn const &fn);
+
+	uint32_t thread_count() const { return uint32_t(queues.size()); }
+
+private:
+	struct Task {
+		RangeFn const *fn;
+		uint32_t begin, end;
+		std::atomic< uint32_t > *remaining;
+	};
+	struct Queue {
+		std::mutex mutex;
+		std::vector< Task > tasks; //[head, size) are waiting; the owner takes the back, thieves the head
+		size_t head = 0;
+	};
+
+	bool pop(uint32_t self, Task *task);
+	bool steal(uint32_t self, Task *task);
+	void run(Task const &task);
+	void worker(uint32_t self);
+
+	std::vector< std::unique_ptr< Queue > > queues;
+	std::vector< std::thread > workers;
+
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	//tasks waiting in the deques; raised (under sleep_mutex, so a sleeping worker can't miss it)
+	//only after the tasks are pushed, so a thief may take it briefly below zero:
+	std::atomic< int32_t > queued;
+	bool quit = false;
+};
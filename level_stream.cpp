@@ -0,0 +1,533 @@
+#include "level_stream.hpp"
+#include "text_scan.hpp"
+#include "asset_pack.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#define LOG_ERROR( X ) std::cerr << X << std::endl
+
+static std::string chunk_filename(std::string const &directory, uint32_t index) {
+	return directory + "/chunk" + std::to_string(index) + ".txt";
+}
+
+bool load_level_chunk(std::string const &filename, uint32_t index, float chunk_width, LevelChunk *chunk) {
+	chunk->index = index;
+	chunk->platforms.clear();
+	chunk->enemies.clear();
+	chunk->lights.clear();
+	chunk->doors.clear();
+	chunk->ladders.clear();
+
+	TextScanner scan;
+	if (!scan.load(filename)) {
+		LOG_ERROR("  cannot open '" << filename << "'.");
+		return false;
+	}
+	float left = index * chunk_width;
+
+	auto vec2 = [&scan](glm::vec2 *v) {
+		return scan.number(&v->x) && scan.number(&v->y);
+	};
+	auto color = [&scan](glm::u8vec4 *c) {
+		uint32_t v[4];
+		if (!(scan.number(&v[0]) && scan.number(&v[1]) && scan.number(&v[2]) && scan.number(&v[3]))) return false;
+		if (v[0] > 255 || v[1] > 255 || v[2] > 255 || v[3] > 255) return false;
+		*c = glm::u8vec4(v[0], v[1], v[2], v[3]);
+		return true;
+	};
+
+	TextToken kind;
+	while (scan.next_line()) {
+		scan.word(&kind);
+
+		bool ok = false;
+		if (kind == "platform") {
+			PlatformSpec p;
+			ok = vec2(&p.pos) && vec2(&p.size);
+			p.pos.x += left;
+			chunk->platforms.emplace_back(p);
+		} else if (kind == "enemy") {
+			EnemySpec e;
+			ok = vec2(&e.pos) && vec2(&e.waypoints[0]) && vec2(&e.waypoints[1]) && vec2(&e.flashlight_size);
+			e.pos.x += left;
+			e.waypoints[0].x += left;
+			e.waypoints[1].x += left;
+			chunk->enemies.emplace_back(e);
+		} else if (kind == "light") {
+			LightSpec l;
+			ok = vec2(&l.pos) && vec2(&l.size) && scan.number(&l.dir);
+			//optional color, then softness:
+			if (ok && !scan.line_done()) ok = color(&l.color);
+			if (ok && !scan.line_done()) ok = scan.number(&l.softness) && l.softness >= 0.0f && l.softness <= 1.0f;
+			l.pos.x += left;
+			chunk->lights.emplace_back(l);
+		} else if (kind == "door") {
+			DoorSpec d;
+			ok = vec2(&d.pos);
+			d.pos.x += left;
+			chunk->doors.emplace_back(d);
+		} else if (kind == "ladder") {
+			LadderSpec l;
+			ok = vec2(&l.pos) && scan.number(&l.height);
+			l.pos.x += left;
+			chunk->ladders.emplace_back(l);
+		} else {
+			LOG_ERROR(scan.where() << ": unknown object '" << kind.str() << "'.");
+			return false;
+		}
+		if (!ok || !scan.line_done()) {
+			LOG_ERROR(scan.where() << ": malformed " << kind.str() << " record (found " << scan.found() << ").");
+			return false;
+		}
+	}
+	return true;
+}
+
+//"chunk<i>.txt" -> i (editor backups and temporary files don't match):
+static bool chunk_index_from_name(char const *name, uint32_t *index) {
+	if (strncmp(name, "chunk", 5) != 0) return false;
+	char const *at = name + 5;
+	if (*at < '0' || *at > '9') return false;
+	uint32_t value = 0;
+	while (*at >= '0' && *at <= '9') {
+		value = value * 10 + uint32_t(*at - '0');
+		++at;
+	}
+	if (strcmp(at, ".txt") != 0) return false;
+	*index = value;
+	return true;
+}
+
+LevelStream::LevelStream() : reloads_waiting(false) {
+	worker = std::thread(&LevelStream::worker_main, this);
+
+#ifdef __linux__
+	watch_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+	if (watch_fd < 0 || pipe(watch_wake) != 0) {
+		LOG_ERROR("Not watching level files for changes (" << strerror(errno) << ").");
+		if (watch_fd >= 0) close(watch_fd);
+		watch_fd = -1;
+	} else {
+		watcher = std::thread(&LevelStream::watcher_main, this);
+	}
+#endif
+}
+
+LevelStream::~LevelStream() {
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		quit = true;
+	}
+	wake.notify_all();
+	worker.join();
+
+#ifdef __linux__
+	if (watcher.joinable()) {
+		char stop = 0;
+		while (write(watch_wake[1], &stop, 1) < 0 && errno == EINTR) { }
+		watcher.join();
+		close(watch_wake[0]);
+		close(watch_wake[1]);
+		close(watch_fd);
+	}
+#endif
+}
+
+//read the level header in 'directory':
+static bool load_level_header(std::string const &directory, float *width, uint32_t *count, LevelCounts *totals) {
+	std::string filename = directory + "/level.txt";
+	TextScanner scan;
+	if (!scan.load(filename)) {
+		LOG_ERROR("  cannot open '" << filename << "'.");
+		return false;
+	}
+	*width = 0.0f;
+	*count = 0;
+	*totals = LevelCounts();
+	TextToken key;
+	while (scan.next_line()) {
+		scan.word(&key);
+		bool ok = false;
+		if (key == "chunk_width") {
+			ok = scan.number(width);
+		} else if (key == "chunks") {
+			ok = scan.number(count);
+		} else if (key == "objects") {
+			ok = scan.number(&totals->platforms) && scan.number(&totals->enemies) && scan.number(&totals->lights)
+				&& scan.number(&totals->doors) && scan.number(&totals->ladders);
+		}
+		if (!ok || !scan.line_done()) {
+			LOG_ERROR(scan.where() << ": bad or unknown entry '" << key.str() << "' (found " << scan.found() << ").");
+			return false;
+		}
+	}
+	if (!(*width > 0.0f)) {
+		LOG_ERROR(filename << ": expecting 'chunk_width <width>' and 'chunks <count>'.");
+		return false;
+	}
+	return true;
+}
+
+bool prefetch_level(std::string const &directory, uint32_t chunks) {
+	float width;
+	uint32_t count;
+	LevelCounts totals;
+	if (!load_level_header(directory, &width, &count, &totals)) return false;
+	//(open() parses them; touching one byte per page is enough to bring them in)
+	bool ok = true;
+	for (uint32_t i = 0; i < std::min(chunks, count); ++i) {
+		AssetBytes bytes;
+		if (!load_asset(chunk_filename(directory, i), &bytes)) {
+			ok = false;
+			continue;
+		}
+		char const volatile *data = bytes.data;
+		for (size_t at = 0; at < bytes.size; at += 4096) {
+			(void)data[at];
+		}
+	}
+	return ok;
+}
+
+bool LevelStream::open(std::string const &directory_) {
+	float width;
+	uint32_t count;
+	LevelCounts totals;
+	if (!load_level_header(directory_, &width, &count, &totals)) return false;
+
+	directory = directory_;
+	chunks.clear();
+	loaded.clear();
+	resident.clear();
+	pinned.clear();
+	pending.clear();
+	failed.clear();
+	chunk_width = width;
+	chunk_count = count;
+	chunks.resize(chunk_count);
+	counts = totals;
+	pin_next = true;
+
+	{ //anything still queued or loaded belongs to the previous level:
+		std::lock_guard< std::mutex > lock(mutex);
+		++generation;
+		requests.clear();
+		finished.clear();
+		finished_failed.clear();
+		loader_directory = directory;
+		loader_chunk_width = chunk_width;
+		reloads.clear();
+		header_dirty = false;
+
+#ifdef __linux__
+		if (watch_fd >= 0) {
+			if (watch_dir >= 0) inotify_rm_watch(watch_fd, watch_dir);
+			watch_dir = -1;
+		}
+		//levels read from the asset pack don't change under us:
+		if (watch_fd >= 0 && !asset_pack_in_use()) {
+			watch_dir = inotify_add_watch(watch_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watch_dir < 0) {
+				LOG_ERROR("Not watching '" << directory << "' for changes (" << strerror(errno) << ").");
+			}
+		}
+#endif
+	}
+	return true;
+}
+
+static bool contains(std::vector< uint32_t > const &list, uint32_t index) {
+	return std::find(list.begin(), list.end(), index) != list.end();
+}
+
+static void remove(std::vector< uint32_t > *list, uint32_t index) {
+	list->erase(std::remove(list->begin(), list->end(), index), list->end());
+}
+
+void LevelStream::update(float lo, float hi, std::vector< LevelChunk const * > *arrived, std::vector< uint32_t > *evicted) {
+	arrived->clear();
+	evicted->clear();
+	if (chunk_count == 0) return;
+
+	auto chunk_at = [this](float x) {
+		float c = std::floor(x / chunk_width);
+		return int32_t(std::max(0.0f, std::min(c, float(chunk_count - 1))));
+	};
+	int32_t need_lo = chunk_at(lo), need_hi = chunk_at(hi);
+	int32_t want_lo = chunk_at(lo - margin * chunk_width), want_hi = chunk_at(hi + margin * chunk_width);
+	int32_t keep_lo = want_lo - 1, keep_hi = want_hi + 1;
+	auto outside = [&](uint32_t index) {
+		return int32_t(index) < keep_lo || int32_t(index) > keep_hi;
+	};
+
+	//evict chunks that fell out of the window (pinned data stays loaded):
+	for (size_t l = 0; l < loaded.size(); ) {
+		uint32_t index = loaded[l];
+		if (outside(index)) {
+			if (contains(resident, index)) {
+				remove(&resident, index);
+				evicted->emplace_back(index);
+			}
+			if (!contains(pinned, index)) {
+				chunks[index] = LevelChunk();
+				loaded[l] = loaded.back();
+				loaded.pop_back();
+				continue;
+			}
+		}
+		++l;
+	}
+
+	//bring back loaded chunks, and queue loads for missing ones (the ones in view jump the line):
+	bool requested = false;
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		for (int32_t i = want_lo; i <= want_hi; ++i) {
+			uint32_t index = uint32_t(i);
+			if (contains(resident, index) || contains(pending, index) || contains(failed, index)) continue;
+			if (contains(loaded, index)) {
+				resident.emplace_back(index);
+				arrived->emplace_back(&chunks[index]);
+				continue;
+			}
+			pending.emplace_back(index);
+			if (i >= need_lo && i <= need_hi) {
+				requests.push_back(Request{generation, index});
+			} else {
+				requests.insert(requests.begin(), Request{generation, index});
+			}
+			requested = true;
+		}
+	}
+	if (requested) wake.notify_one();
+
+	//take what the loader has finished, waiting while anything in view is missing
+	//(or anything in the window, when the level was just opened):
+	int32_t wait_lo = (pin_next ? want_lo : need_lo), wait_hi = (pin_next ? want_hi : need_hi);
+	if (!pending.empty()) {
+		std::unique_lock< std::mutex > lock(mutex);
+		while (true) {
+			for (auto &chunk : finished) {
+				uint32_t index = chunk.index;
+				remove(&pending, index);
+				if (outside(index) || contains(loaded, index)) continue;
+				chunks[index] = std::move(chunk);
+				loaded.emplace_back(index);
+				resident.emplace_back(index);
+				arrived->emplace_back(&chunks[index]);
+			}
+			finished.clear();
+			for (uint32_t index : finished_failed) {
+				remove(&pending, index);
+				if (contains(failed, index)) continue;
+				failed.emplace_back(index);
+				LOG_ERROR("Chunk " << index << " of '" << directory << "' failed to load; leaving it out until its file is saved again.");
+			}
+			finished_failed.clear();
+
+			//(a chunk that failed is not waited for -- it won't arrive)
+			bool missing = false;
+			for (int32_t i = wait_lo; i <= wait_hi; ++i) {
+				if (!contains(resident, uint32_t(i)) && !contains(failed, uint32_t(i))) missing = true;
+			}
+			if (!missing) break;
+			done.wait(lock);
+		}
+	}
+
+	if (pin_next) {
+		pinned = resident;
+		pin_next = false;
+	}
+}
+
+void LevelStream::restart(std::vector< uint32_t > *evicted) {
+	*evicted = resident;
+	resident.clear();
+}
+
+//the specs are plain floats, so comparing bytes compares values:
+template< typename T >
+static bool same_specs(std::vector< T > const &a, std::vector< T > const &b) {
+	return a.size() == b.size() && (a.empty() || memcmp(&a[0], &b[0], sizeof(T) * a.size()) == 0);
+}
+
+void LevelStream::take_reloads(std::vector< ChunkReload > *reloaded, bool *header_changed) {
+	reloaded->clear();
+	*header_changed = false;
+	if (!reloads_waiting.load(std::memory_order_acquire)) return;
+
+	std::lock_guard< std::mutex > lock(mutex);
+	reloads_waiting.store(false, std::memory_order_relaxed);
+	*header_changed = header_dirty;
+	header_dirty = false;
+	for (auto &chunk : reloads) {
+		uint32_t index = chunk.index;
+		if (contains(failed, index)) {
+			//fixed: the next update() requests it like any other missing chunk
+			remove(&failed, index);
+			continue;
+		}
+		if (!contains(loaded, index)) continue;
+		LevelChunk &old = chunks[index];
+		uint32_t changed = 0;
+		if (!same_specs(old.platforms, chunk.platforms)) changed |= ChunkPlatforms;
+		if (!same_specs(old.enemies, chunk.enemies)) changed |= ChunkEnemies;
+		if (!same_specs(old.lights, chunk.lights)) changed |= ChunkLights;
+		if (!same_specs(old.doors, chunk.doors)) changed |= ChunkDoors;
+		if (!same_specs(old.ladders, chunk.ladders)) changed |= ChunkLadders;
+		if (changed == 0) continue;
+		old = std::move(chunk);
+		if (contains(resident, index)) {
+			reloaded->emplace_back(ChunkReload{&old, changed});
+		}
+	}
+	reloads.clear();
+}
+
+void LevelStream::merged_platforms(std::vector< PlatformSpec > *platforms) const {
+	platforms->clear();
+	for (uint32_t index : resident) {
+		LevelChunk const &chunk = chunks[index];
+		platforms->insert(platforms->end(), chunk.platforms.begin(), chunk.platforms.end());
+	}
+	//sort by row, then left edge, so pieces of one platform end up adjacent:
+	std::sort(platforms->begin(), platforms->end(), [](PlatformSpec const &a, PlatformSpec const &b) {
+		if (a.pos.y != b.pos.y) return a.pos.y < b.pos.y;
+		if (a.size.y != b.size.y) return a.size.y < b.size.y;
+		return a.pos.x - 0.5f * a.size.x < b.pos.x - 0.5f * b.size.x;
+	});
+
+	const float touch = 1e-4f;
+	size_t out = 0;
+	for (size_t i = 0; i < platforms->size(); ++i) {
+		PlatformSpec const &p = (*platforms)[i];
+		if (out > 0) {
+			PlatformSpec &prev = (*platforms)[out - 1];
+			float prev_right = prev.pos.x + 0.5f * prev.size.x;
+			float left = p.pos.x - 0.5f * p.size.x;
+			if (prev.pos.y == p.pos.y && prev.size.y == p.size.y && left <= prev_right + touch) {
+				float prev_left = prev.pos.x - 0.5f * prev.size.x;
+				float right = std::max(prev_right, p.pos.x + 0.5f * p.size.x);
+				prev.pos.x = 0.5f * (prev_left + right);
+				prev.size.x = right - prev_left;
+				continue;
+			}
+		}
+		(*platforms)[out++] = p;
+	}
+	platforms->resize(out);
+}
+
+void LevelStream::worker_main() {
+	std::unique_lock< std::mutex > lock(mutex);
+	while (true) {
+		while (!quit && requests.empty()) {
+			wake.wait(lock);
+		}
+		if (quit) break;
+
+		Request request = requests.back();
+		requests.pop_back();
+		std::string filename = chunk_filename(loader_directory, request.index);
+		float width = loader_chunk_width;
+
+		lock.unlock();
+		LevelChunk chunk;
+		bool ok = load_level_chunk(filename, request.index, width, &chunk);
+		lock.lock();
+
+		if (request.generation == generation) {
+			//(a broken chunk is still answered, so nothing waits on it forever)
+			if (ok) {
+				finished.emplace_back(std::move(chunk));
+			} else {
+				finished_failed.emplace_back(request.index);
+			}
+			done.notify_all();
+		}
+	}
+}
+
+void LevelStream::watcher_main() {
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+	std::vector< uint32_t > edited;
+	while (true) {
+		pollfd fds[2];
+		fds[0].fd = watch_fd;
+		fds[0].events = POLLIN;
+		fds[1].fd = watch_wake[0];
+		fds[1].events = POLLIN;
+		if (poll(fds, 2, -1) < 0) {
+			if (errno == EINTR) continue;
+			LOG_ERROR("Stopped watching level files (" << strerror(errno) << ").");
+			break;
+		}
+		if (fds[1].revents != 0) break;
+
+		uint32_t request_generation;
+		int dir;
+		std::string dir_name;
+		float width;
+		{
+			std::lock_guard< std::mutex > lock(mutex);
+			request_generation = generation;
+			dir = watch_dir;
+			dir_name = loader_directory;
+			width = loader_chunk_width;
+		}
+
+		//one save can show up as several events; gather them before parsing anything:
+		edited.clear();
+		bool header = false;
+		while (true) {
+			ssize_t got = read(watch_fd, buffer, sizeof(buffer));
+			if (got <= 0) break;
+			for (char const *at = buffer; at < buffer + got; ) {
+				inotify_event const *event = reinterpret_cast< inotify_event const * >(at);
+				at += sizeof(inotify_event) + event->len;
+				if (event->wd != dir || event->len == 0) continue;
+				uint32_t index;
+				if (strcmp(event->name, "level.txt") == 0) {
+					header = true;
+				} else if (chunk_index_from_name(event->name, &index) && !contains(edited, index)) {
+					edited.emplace_back(index);
+				}
+			}
+		}
+
+		uint32_t parsed = 0;
+		for (uint32_t index : edited) {
+			LevelChunk chunk;
+			//a file caught half-written (or with a typo) is skipped; the next save brings it in:
+			if (!load_level_chunk(chunk_filename(dir_name, index), index, width, &chunk)) continue;
+			std::lock_guard< std::mutex > lock(mutex);
+			if (request_generation != generation) break;
+			reloads.emplace_back(std::move(chunk));
+			reloads_waiting.store(true, std::memory_order_release);
+			++parsed;
+		}
+		if (header) {
+			std::lock_guard< std::mutex > lock(mutex);
+			if (request_generation == generation) {
+				header_dirty = true;
+				reloads_waiting.store(true, std::memory_order_release);
+			}
+		}
+		if (parsed != 0 || header) {
+			std::cout << "Reloaded " << parsed << " chunk file(s)" << (header ? " and level.txt" : "") << " from '" << dir_name << "'." << std::endl;
+		}
+	}
+#endif
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Levels as a row of fixed-width chunks, streamed in around the camera.
+ *
+ * A level directory holds "level.txt":
+ *   chunk_width <width>
+ *   chunks <count>
+ *   objects <platforms> <enemies> <lights> <doors> <ladders>   (optional: totals over all chunks)
+ * and one "chunk<i>.txt" per chunk, one object per line ('#' starts a comment):
+ *   platform <x> <y> <width> <height>
+ *   enemy <x> <y> <waypoint0 x> <waypoint0 y> <waypoint1 x> <waypoint1 y> <flashlight width> <flashlight height>
+ *   light <x> <y> <width> <height> <dir (multiples of PI)> [<r> <g> <b> <a (0-255)> [<softness (0-1)>]]
+ *   door <x> <y>
+ *   ladder <x> <y> <height>
+ *
+ * x coordinates in a chunk file are relative to the chunk's left edge; chunk i
+ * covers [i * width, (i + 1) * width) of the level. An object belongs to the
+ * chunk holding its position, so platforms longer than a chunk are authored as
+ * one piece per chunk; merged_platforms() glues touching pieces back together.
+ *
+ * Chunks that are evicted and later streamed back in return in their authored state.
+ * A chunk file that does not parse is reported and left out (the rest of the
+ * level streams as usual) until it is saved again or the level is reopened.
+ *
+ * Files are read through load_asset(), so they may come from the asset pack.
+ * Otherwise, on Linux, the level directory is watched (inotify) while it is open: a saved
+ * chunk file is re-parsed on the watcher thread and handed over by
+ * take_reloads(), along with which kinds of object in it changed.
+ */
+
+struct PlatformSpec {
+	glm::vec2 pos;
+	glm::vec2 size;
+};
+
+struct EnemySpec {
+	glm::vec2 pos;
+	glm::vec2 waypoints[2];
+	glm::vec2 flashlight_size;
+};
+
+struct LightSpec {
+	glm::vec2 pos;
+	glm::vec2 size;
+	float dir; //multiples of PI
+	glm::u8vec4 color = glm::u8vec4(0xdf, 0xe2, 0x74, 0x88); //straight (not premultiplied) alpha
+	float softness = 0.0f; //fraction of the cone's width and length spent fading out; 0 is a hard edge
+};
+
+struct DoorSpec {
+	glm::vec2 pos;
+};
+
+struct LadderSpec {
+	glm::vec2 pos;
+	float height;
+};
+
+//one chunk's objects, in level coordinates:
+struct LevelChunk {
+	uint32_t index = 0;
+	std::vector< PlatformSpec > platforms;
+	std::vector< EnemySpec > enemies;
+	std::vector< LightSpec > lights;
+	std::vector< DoorSpec > doors;
+	std::vector< LadderSpec > ladders;
+};
+
+//kinds of object in a chunk, as bits:
+enum ChunkContents {
+	ChunkPlatforms = (1 << 0),
+	ChunkEnemies = (1 << 1),
+	ChunkLights = (1 << 2),
+	ChunkDoors = (1 << 3),
+	ChunkLadders = (1 << 4),
+	ChunkAll = (1 << 5) - 1,
+};
+
+//a resident chunk whose file changed on disk:
+struct ChunkReload {
+	LevelChunk const *chunk; //new data, owned by the stream
+	uint32_t changed;        //ChunkContents bits that differ from the old data
+};
+
+//object totals for a whole level, from its header (all zero if not given):
+struct LevelCounts {
+	uint32_t platforms = 0;
+	uint32_t enemies = 0;
+	uint32_t lights = 0;
+	uint32_t doors = 0;
+	uint32_t ladders = 0;
+};
+
+bool load_level_chunk(std::string const &filename, uint32_t index, float chunk_width, LevelChunk *chunk);
+
+//Read (without parsing) the header and first 'chunks' chunk files of the level in
+//'directory', so the files are warm (in the page cache, or the mapped pack's pages
+//faulted in) when the level is opened. Safe to call from any thread:
+bool prefetch_level(std::string const &directory, uint32_t chunks);
+
+struct LevelStream {
+	LevelStream();
+	~LevelStream();
+
+	LevelStream(LevelStream const &) = delete;
+	LevelStream &operator=(LevelStream const &) = delete;
+
+	//switch to the level in 'directory' (drops every chunk of the previous level;
+	//if the header can't be read the previous level is kept):
+	bool open(std::string const &directory);
+
+	float chunk_width = 10.0f;
+	uint32_t chunk_count = 0;
+	LevelCounts counts;
+	float length() const { return chunk_width * chunk_count; }
+
+	//chunks kept resident past each side of the view:
+	uint32_t margin = 1;
+
+	//Stream for a view covering [lo, hi] along x. Chunks the view overlaps are
+	//waited for (normally they were prefetched already); chunks within 'margin'
+	//of it are requested from the loader thread and arrive on a later call.
+	//Chunks more than one chunk outside of that are evicted.
+	//The first call after open() waits for the whole window and pins it, for restart().
+	//'arrived' points at chunk data owned by the stream, valid until the next call.
+	//Chunk files are parsed on the loader thread; once its lists have grown, update() does not allocate.
+	void update(float lo, float hi, std::vector< LevelChunk const * > *arrived, std::vector< uint32_t > *evicted);
+
+	//Evict everything; the next update() brings pinned (and still loaded) chunks back without file access:
+	void restart(std::vector< uint32_t > *evicted);
+
+	//Hand over edits to the level's files since the last call (between frames).
+	//Edited chunks with data in memory are replaced; 'reloaded' lists the resident
+	//ones that actually changed. Others are read fresh when they stream in.
+	//'header_changed' means level.txt was saved and the level should be reopened.
+	//Cheap (no locking) when nothing was edited.
+	void take_reloads(std::vector< ChunkReload > *reloaded, bool *header_changed);
+
+	//platforms of all resident chunks, with touching pieces of the same height merged:
+	void merged_platforms(std::vector< PlatformSpec > *platforms) const;
+
+private:
+	struct Request {
+		uint32_t generation;
+		uint32_t index;
+	};
+
+	void worker_main();
+	void watcher_main();
+
+	//all of these stay about the size of the window:
+	std::string directory;
+	std::vector< LevelChunk > chunks; //one slot per chunk, filled for 'loaded' ones
+	std::vector< uint32_t > loaded;   //chunks with data: resident and pinned ones
+	std::vector< uint32_t > resident; //chunks whose objects are in the game
+	std::vector< uint32_t > pinned;   //chunks whose data is kept for restart()
+	std::vector< uint32_t > pending;  //requested from the loader, not yet arrived
+	std::vector< uint32_t > failed;   //chunks whose file did not parse; not requested again until it is saved (or the level reopened)
+	bool pin_next = false;
+
+	//shared with the loader thread:
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	std::vector< Request > requests; //taken from the back
+	std::vector< LevelChunk > finished;
+	std::vector< uint32_t > finished_failed; //requests whose file did not parse
+	std::string loader_directory;
+	float loader_chunk_width = 10.0f;
+	uint32_t generation = 0;
+	bool quit = false;
+
+	std::thread worker;
+
+	//file watching (shared with the watcher thread, under 'mutex'):
+	std::vector< LevelChunk > reloads;
+	bool header_dirty = false;
+	std::atomic< bool > reloads_waiting;
+	int watch_fd = -1;      //inotify instance
+	int watch_dir = -1;     //watch on the open level's directory
+	int watch_wake[2] = { -1, -1 }; //pipe that stops the watcher
+	std::thread watcher;
+};
@@ -1,4 +1,5 @@
 #include "load_save_png.hpp"
+#include "asset_pack.hpp"
 
 #include <png.h>
 
@@ -12,11 +13,12 @@
 using std::vector;
 
 bool load_png(std::string filename, unsigned int *width, unsigned int *height, std::vector< uint32_t > *data, OriginLocation origin) {
-	std::ifstream file(filename.c_str(), std::ios::binary);
-	if (!file) {
+	AssetBytes bytes;
+	if (!load_asset(filename, &bytes)) {
 		LOG_ERROR("  cannot open file.");
 		return false;
 	}
+	AssetStream file(bytes);
 	return load_png(file, width, height, data, origin);
 }
 
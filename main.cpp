@@ -1,25 +1,60 @@
 // ADAPTED FROM JIM MCCANN'S BASE1 CODE FOR 15-466 COMPUTER GAME PROGRAMMING
 
 #include "load_save_png.hpp"
+#include "sprite_atlas.hpp"
+#include "block_compress.hpp"
+#include "mip_chain.hpp"
+#include "sound_field.hpp"
+#include "job_system.hpp"
+#include "level_stream.hpp"
+#include "arena.hpp"
+#include "alloc_tracker.hpp"
+#include "asset_pack.hpp"
+#include "wav_clip.hpp"
+#include "startup_timeline.hpp"
+#include "program_cache.hpp"
+#include "gl_state.hpp"
+#include "gl_call_counters.hpp"
+#include "render_queue.hpp"
+#include "triple_buffer.hpp"
+#include "sprite_batch.hpp"
 #include "GL.hpp"
 
 #include <SDL2/SDL.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <ctime>
+#include <future>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <iomanip>
+#include <random>
 #include <fstream>
 using namespace std;
 
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3 //from GL_EXT_texture_compression_s3tc
+#endif
+
 const float PI = 3.1415f;
-static GLuint compile_shader(GLenum type, std::string const &source);
-static GLuint link_program(GLuint vertex_shader, GLuint fragment_shader);
+//an atlas page read from disk, ready to upload:
+struct AtlasPageData {
+	bool loaded = false;            //false if neither the .ctex nor the png could be used
+	CompressedTexture compressed;   //the page's .ctex copy (levels empty if not used)...
+	std::vector< MipLevel > chain;  //...or its png, premultiplied, with mips
+};
+static bool load_atlas_page(AtlasPage const &page, bool try_compressed, JobSystem *jobs, AtlasPageData *data);
+static void upload_compressed_texture(CompressedTexture const &texture);
+static SDL_AudioSpec clip_spec(WavClip const &clip);
 
 float dot(glm::vec2 a, glm::vec2 b) {
 	return (a.x * b.x + a.y * b.y);
@@ -44,67 +79,84 @@ static const char *STEP_MUSIC_PATH =
 "../sounds/step.wav";
 
 struct AudioData {
-	Uint8 *pos;
+	Uint8 const *pos;
 	Uint32 length;
-	Uint8 *init_pos;
+	Uint8 const *init_pos;
 	Uint32 init_length;
 };
 
+//pushed by playTone when a clip has played to its end, so an idle main loop wakes up to handle it:
+static Uint32 clip_finished_event = Uint32(-1);
+
+//----------------- Sprites ----------------------------------------------
+//every sprite the game draws, looked up by name once, after the atlas manifest is
+//loaded (load_game_sprites()); the structs below copy theirs from here:
+static struct GameSprites {
+	SpriteInfo sound_ring;
+	SpriteInfo background;
+	SpriteInfo hints[6];
+	SpriteInfo player[9];
+	SpriteInfo numbers[10];
+	SpriteInfo enemy[5];
+	SpriteInfo enemy_alert;
+	SpriteInfo door;
+	SpriteInfo ladder;
+	SpriteInfo platform;
+	SpriteInfo level_select_title;
+	SpriteInfo level_highlights[5];
+	SpriteInfo levels[5];
+	SpriteInfo menus[3];
+	SpriteInfo menus_selected[3];
+} game_sprites;
+
+static void load_game_sprites() {
+	GameSprites &s = game_sprites;
+	s.sound_ring = atlas_sprite("sound_ring");
+	s.background = atlas_sprite("background");
+	static char const *hint_names[6] = { "hint_walk", "hint_run", "hint_menu", "hint_climb", "hint_hide", "hint_mouse" };
+	for (uint32_t i = 0; i < 6; ++i) s.hints[i] = atlas_sprite(hint_names[i]);
+	for (uint32_t i = 0; i < 9; ++i) s.player[i] = atlas_sprite("player_" + std::to_string(i));
+	for (uint32_t i = 0; i < 10; ++i) s.numbers[i] = atlas_sprite("number_" + std::to_string(i));
+	for (uint32_t i = 0; i < 5; ++i) s.enemy[i] = atlas_sprite("enemy_" + std::to_string(i));
+	s.enemy_alert = atlas_sprite("enemy_alert");
+	s.door = atlas_sprite("door");
+	s.ladder = atlas_sprite("ladder");
+	s.platform = atlas_sprite("platform");
+	s.level_select_title = atlas_sprite("level_select_title");
+	for (uint32_t i = 0; i < 5; ++i) s.level_highlights[i] = atlas_sprite("level_highlight_" + std::to_string(i));
+	for (uint32_t i = 0; i < 5; ++i) s.levels[i] = atlas_sprite("level_" + std::to_string(i));
+	static char const *menu_names[3] = { "menu_play", "menu_quit", "menu_back" };
+	for (uint32_t i = 0; i < 3; ++i) {
+		s.menus[i] = atlas_sprite(menu_names[i]);
+		s.menus_selected[i] = atlas_sprite(std::string(menu_names[i]) + "_selected");
+	}
+}
+
 //----------------- Structs ----------------------------------------------
 struct CameraInfo{
 	glm::vec2 pos = glm::vec2(6.0f, 2.5f);
 	glm::vec2 size = glm::vec2(12.0f, 8.0f);
 };
 
-struct SpriteInfo {
-	glm::vec2 min_uv;
-	glm::vec2 max_uv;
-	glm::vec2 origin;
-};
-
 struct MouseInfo{
 	glm::vec2 pos = glm::vec2(0.0f);
 	glm::vec2 size = glm::vec2(6.0f);
 
-	SpriteInfo sprite_throw = {
-		glm::vec2(4900.0f/7000.0f, (5500.0f - 1900.0f) / 5500.0f),
-		glm::vec2(5300.0f/7000.0f, (5500.0f - 1500.0f) / 5500.0f),
-	};
+	SpriteInfo sprite_throw = game_sprites.sound_ring;
 
 	float remaining_time = 0.0f;
 };
 
 struct Background{
-	SpriteInfo background = {
-		glm::vec2(   0.0f/7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-		glm::vec2( 200.0f/7000.0f, (5500.0f - 2200.0f) / 5500.0f),
-	};
+	SpriteInfo background = game_sprites.background;
 
 	SpriteInfo hints[6] = {
-		{
-			glm::vec2( 6400.0f/7000.0f, (5500.0f - 2300.0f) / 5500.0f),
-			glm::vec2( 6700.0f/7000.0f, (5500.0f - 1900.0f) / 5500.0f),
-		}, // walk
-		{
-			glm::vec2( 6000.0f/7000.0f, (5500.0f - 2200.0f) / 5500.0f),
-			glm::vec2( 6300.0f/7000.0f, (5500.0f - 1900.0f) / 5500.0f),
-		}, // Run
-		{
-			glm::vec2( 6000.0f/7000.0f, (5500.0f - 2400.0f) / 5500.0f),
-			glm::vec2( 6300.0f/7000.0f, (5500.0f - 2200.0f) / 5500.0f),
-		}, // Menu
-		{
-			glm::vec2( 6000.0f/7000.0f, (5500.0f - 2600.0f) / 5500.0f),
-			glm::vec2( 6300.0f/7000.0f, (5500.0f - 2400.0f) / 5500.0f),
-		}, // Climb
-		{
-			glm::vec2( 6000.0f/7000.0f, (5500.0f - 2800.0f) / 5500.0f),
-			glm::vec2( 6300.0f/7000.0f, (5500.0f - 2600.0f) / 5500.0f),
-		}, // Hide
-		{
-			glm::vec2( 5400.0f/7000.0f, (5500.0f - 1900.0f) / 5500.0f),
-			glm::vec2( 6600.0f/7000.0f, (5500.0f - 1300.0f) / 5500.0f),
-		}, // mouse
+		game_sprites.hints[0], // walk
+		game_sprites.hints[1], // Run
+		game_sprites.hints[2], // Menu
+		game_sprites.hints[3], // Climb
+		game_sprites.hints[4], // Hide
+		game_sprites.hints[5], // mouse
 	};
 };
 
@@ -119,85 +171,28 @@ struct PlayerInfo{
 	int animation_count;
 
 	SpriteInfo sprite_animations[9] = {
-		{
-			glm::vec2(1100.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(1500.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(1500.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(1900.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(1900.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(2300.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(2300.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(2700.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(2700.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(3100.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3100.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(3500.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3500.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(3900.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3900.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(4300.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(700.0f / 7000.0f, (5500.0f - 2000.0f) / 5500.0f),
-			glm::vec2(1100.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-		},
+		game_sprites.player[0],
+		game_sprites.player[1],
+		game_sprites.player[2],
+		game_sprites.player[3],
+		game_sprites.player[4],
+		game_sprites.player[5],
+		game_sprites.player[6],
+		game_sprites.player[7],
+		game_sprites.player[8],
 	};
 
   SpriteInfo numbers[10] = {
-		{
-			glm::vec2(3900.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(4110.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(4110.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(4320.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(4320.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(4530.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(4530.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(4740.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(4740.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(4950.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(4940.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(5140.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(5140.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(5330.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(5320.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(5555.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(5560.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(5690.0f / 7000.0f, 290.0f / 5500.0f),
-		},
-		{
-			glm::vec2(5690.0f / 7000.0f, 55.0f / 5500.0f),
-			glm::vec2(5900.0f / 7000.0f, 290.0f / 5500.0f),
-		},
+		game_sprites.numbers[0],
+		game_sprites.numbers[1],
+		game_sprites.numbers[2],
+		game_sprites.numbers[3],
+		game_sprites.numbers[4],
+		game_sprites.numbers[5],
+		game_sprites.numbers[6],
+		game_sprites.numbers[7],
+		game_sprites.numbers[8],
+		game_sprites.numbers[9],
 	};
 
 	bool face_right = false;
@@ -222,13 +217,9 @@ struct Light {
 	glm::vec2 size = glm::vec2(0.0f, 0.0f);
 	float dir = PI * 1.5f;
 	bool light_on = true;
-	glm::u8vec4 color = glm::u8vec4(0xff, 0xff, 0xff, 0xff);
-
-	SpriteInfo sprite = {
-		glm::vec2(1945.0f/3503.0f, 1289.0f/1689.0f),
-		glm::vec2(2585.0f/3503.0f, 1.0f),
-		glm::vec2(0.0f, 0.0f),
-	};
+	uint32_t chunk = 0; //level chunk a stage light was streamed in with
+	glm::u8vec4 color = glm::u8vec4(0xdf, 0xe2, 0x74, 0x88); //straight (not premultiplied) alpha
+	float softness = 0.0f; //fraction of the cone's width and length spent fading out; 0 is a hard edge
 
 	glm::vec2 vectors [3] = { glm::vec2(pos.x, 
 			pos.y + (0.5f * size.y)),
@@ -237,6 +228,51 @@ struct Light {
 		glm::vec2(pos.x + (0.5f * -size.x),
 				pos.y + (0.5f * -size.y)) };
 
+	//derived geometry, valid once update() has run with the light on:
+	glm::vec2 bbox_min = glm::vec2(0.0f);
+	glm::vec2 bbox_max = glm::vec2(0.0f);
+	glm::vec2 normals [3] = { glm::vec2(0.0f), glm::vec2(0.0f), glm::vec2(0.0f) }; //inward, normals[i] is for edge vectors[i] -> vectors[(i+1)%3]
+	bool dirty = true;
+
+	//setters mark the cone dirty only when something actually moved:
+	void set_pos(glm::vec2 const &pos_) {
+		if (pos_ != pos) { pos = pos_; dirty = true; }
+	}
+	void set_size(glm::vec2 const &size_) {
+		if (size_ != size) { size = size_; dirty = true; }
+	}
+	void set_dir(float dir_) {
+		if (dir_ != dir) { dir = dir_; dirty = true; }
+	}
+
+	//rebuild the cone only if it changed; lights that are off stay dirty until switched back on
+	void update() {
+		if (!dirty || !light_on) return;
+		rotate();
+
+		bbox_min = glm::min(vectors[0], glm::min(vectors[1], vectors[2]));
+		bbox_max = glm::max(vectors[0], glm::max(vectors[1], vectors[2]));
+
+		glm::vec2 e1 = vectors[1] - vectors[0];
+		glm::vec2 e2 = vectors[2] - vectors[0];
+		float winding = (e1.x * e2.y - e1.y * e2.x) < 0.0f ? -1.0f : 1.0f;
+		for (int i = 0; i < 3; i++) {
+			glm::vec2 edge = vectors[(i + 1) % 3] - vectors[i];
+			normals[i] = winding * glm::vec2(-edge.y, edge.x);
+		}
+		dirty = false;
+	}
+
+	//point-in-cone test against the cached geometry (call update() first)
+	bool contains(glm::vec2 const &at) const {
+		if (!light_on) return false;
+		if (at.x < bbox_min.x || at.x > bbox_max.x || at.y < bbox_min.y || at.y > bbox_max.y) return false;
+		for (int i = 0; i < 3; i++) {
+			if (dot(normals[i], at - vectors[i]) < 0.0f) return false;
+		}
+		return true;
+	}
+
 	void rotate() {
 		if (dir == 0.0f) {
 			vectors[0] = glm::vec2(pos.x + (0.5f + -size.y), 
@@ -298,60 +334,39 @@ struct Enemy {
 	int animation_count;
 	int animation_delay;
 
+	uint32_t chunk = 0; //level chunk this enemy was streamed in with
+
 	void update_pos() {
 		if (face_right) {
-			flashlight.dir = 0.0f;
-			flashlight.pos = pos + right_flashlight_offset;
+			flashlight.set_dir(0.0f);
+			flashlight.set_pos(pos + right_flashlight_offset);
 		}
 		else {
-			flashlight.dir = PI;
-			flashlight.pos = pos + left_flashlight_offset;
+			flashlight.set_dir(PI);
+			flashlight.set_pos(pos + left_flashlight_offset);
 		}
 
 	}
 
 	SpriteInfo sprite_animations[5] = {
-		{
-			glm::vec2(   0.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2( 400.0f / 7000.0f, (5500.0f -   0.0f) / 5500.0f),
-		},
-		{
-			glm::vec2( 400.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2( 800.0f / 7000.0f, (5500.0f -    0.0f) / 5500.0f),
-		},
-		{
-			glm::vec2( 800.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(1200.0f / 7000.0f, (5500.0f -    0.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(1200.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(1600.0f / 7000.0f, (5500.0f -    0.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(1600.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(2000.0f / 7000.0f, (5500.0f -    0.0f) / 5500.0f),
-		},
+		game_sprites.enemy[0],
+		game_sprites.enemy[1],
+		game_sprites.enemy[2],
+		game_sprites.enemy[3],
+		game_sprites.enemy[4],
 	};
 
-	SpriteInfo alert = {
-		glm::vec2(2600.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-		glm::vec2(2800.0f / 7000.0f, (5500.0f - 900.0f) / 5500.0f),
-	};
+	SpriteInfo alert = game_sprites.enemy_alert;
 };
 
 struct Door {
 	glm::vec2 pos = glm::vec2(0.0f);
 	glm::vec2 size = glm::vec2(1.0f, 1.5f);
 	bool in_use = false;
+	uint32_t chunk = 0; //level chunk this door was streamed in with
 
-	SpriteInfo sprite_empty = {
-		glm::vec2(2400.0f / 7000.0f, (5500.0f - 800.0f) / 5500.0f),
-		glm::vec2(2900.0f / 7000.0f, (5500.0f - 0.0f) / 5500.0f),
-	};
-	SpriteInfo sprite_used = {
-		glm::vec2(0.0f, 481.0f/1689.0f),
-		glm::vec2(740.0f/3503.0f, 1.0f),
-	};
+	SpriteInfo sprite_empty = game_sprites.door;
+	SpriteInfo sprite_used = game_sprites.door; //(the atlas has no separate art for an occupied door)
 };
 
 struct Ladder {
@@ -359,11 +374,9 @@ struct Ladder {
 	glm::vec2 size = glm::vec2(1.0f, 1.5f);
 	bool in_use = false;
 	bool player_collision = false;
+	uint32_t chunk = 0; //level chunk this ladder was streamed in with
 
-	SpriteInfo sprite_empty = {
-		glm::vec2(200.0f / 7000.0f, (5500.0f - 2600.0f) / 5500.0f),
-		glm::vec2(600.0f / 7000.0f, (5500.0f - 1400.0f) / 5500.0f),
-	};
+	SpriteInfo sprite_empty = game_sprites.ladder;
 	void detect_collision(glm::vec2 player_pos, glm::vec2 player_size) {
 		if (((player_pos.y + player_size.y / 2.0f) <= (pos.y + size.y/2.0f)) &&
 				((player_pos.y - player_size.y / 2.0f) >= (pos.y - size.y/2.0f))) {
@@ -385,10 +398,7 @@ struct Platform {
 	glm::vec2 size = glm::vec2(20.0f, 0.5f);
 	bool player_collision = false;
 
-	SpriteInfo sprite = {
-		glm::vec2(0.0f / 7000.0f, (5500.0f - 1300.0f) / 5500.0f),
-		glm::vec2(2400.0f / 7000.0f, (5500.0f - 800.0f) / 5500.0f),
-	};
+	SpriteInfo sprite = game_sprites.platform;
 	void detect_collision(glm::vec2 player_pos, glm::vec2 player_size) {
 		if (((player_pos.y + player_size.y / 2.0f) >= (pos.y + size.y/2.0f)) &&
 				((player_pos.y - player_size.y / 2.0f) <= (pos.y + size.y/2.0f))) {
@@ -409,10 +419,7 @@ struct Air_Platform {
 	glm::vec2 pos = glm::vec2(10.0f, 1.4f);
 	glm::vec2 size = glm::vec2(5.0f, 0.5f);
 
-	SpriteInfo sprite = {
-		glm::vec2(0.0f / 7000.0f, (5500.0f - 1300.0f) / 5500.0f),
-		glm::vec2(2400.0f / 7000.0f, (5500.0f - 800.0f) / 5500.0f),
-	};
+	SpriteInfo sprite = game_sprites.platform;
 };
 
 struct MenuesInfo {
@@ -420,532 +427,257 @@ struct MenuesInfo {
 	int selected_menu;
 	int selected_level;
 
-	SpriteInfo levels_select = {
-			glm::vec2(4000.0f / 7000.0f, (5500.0f - 5000.0f) / 5500.0f),
-			glm::vec2(6000.0f / 7000.0f, (5500.0f - 4700.0f) / 5500.0f),
-	};
+	SpriteInfo levels_select = game_sprites.level_select_title;
 
 	SpriteInfo levels_highlighted[5] = {
-		{
-			glm::vec2(3100.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-			glm::vec2(3700.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3700.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-			glm::vec2(4300.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(4300.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-			glm::vec2(4900.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(4900.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-			glm::vec2(5500.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(5500.0f / 7000.0f, (5500.0f - 1200.0f) / 5500.0f),
-			glm::vec2(6100.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-		},
+		game_sprites.level_highlights[0],
+		game_sprites.level_highlights[1],
+		game_sprites.level_highlights[2],
+		game_sprites.level_highlights[3],
+		game_sprites.level_highlights[4],
 	};
 
 	SpriteInfo levels[5] = {
-		{
-			glm::vec2(3100.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(3700.0f / 7000.0f, (5500.0f -  200.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3700.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(4300.0f / 7000.0f, (5500.0f -  200.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(4300.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(4900.0f / 7000.0f, (5500.0f -  200.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(4900.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(5500.0f / 7000.0f, (5500.0f -  200.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(5500.0f / 7000.0f, (5500.0f -  700.0f) / 5500.0f),
-			glm::vec2(6100.0f / 7000.0f, (5500.0f -  200.0f) / 5500.0f),
-		},
+		game_sprites.levels[0],
+		game_sprites.levels[1],
+		game_sprites.levels[2],
+		game_sprites.levels[3],
+		game_sprites.levels[4],
 	};
 
 	SpriteInfo menus[3] = {
-		{
-			glm::vec2(3900.0f / 7000.0f, (5500.0f - 2650.0f) / 5500.0f),
-			glm::vec2(4900.0f / 7000.0f, (5500.0f - 2150.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(3900.0f / 7000.0f, (5500.0f - 4200.0f) / 5500.0f),
-			glm::vec2(4900.0f / 7000.0f, (5500.0f - 3700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(2800.0f / 7000.0f, (5500.0f - 3600.0f) / 5500.0f),
-			glm::vec2(3800.0f / 7000.0f, (5500.0f - 3200.0f) / 5500.0f),
-		},
+		game_sprites.menus[0],
+		game_sprites.menus[1],
+		game_sprites.menus[2],
 	};
 
 	SpriteInfo menus_selected[3] = {
-		{
-			glm::vec2(5000.0f / 7000.0f, (5500.0f - 2650.0f) / 5500.0f),
-			glm::vec2(6000.0f / 7000.0f, (5500.0f - 2150.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(5000.0f / 7000.0f, (5500.0f - 4200.0f) / 5500.0f),
-			glm::vec2(6000.0f / 7000.0f, (5500.0f - 3700.0f) / 5500.0f),
-		},
-		{
-			glm::vec2(2900.0f / 7000.0f, (5500.0f - 2500.0f) / 5500.0f),
-			glm::vec2(3900.0f / 7000.0f, (5500.0f - 2100.0f) / 5500.0f),
-		},
+		game_sprites.menus_selected[0],
+		game_sprites.menus_selected[1],
+		game_sprites.menus_selected[2],
 	};
 };
 
-static void playTone(void *userdata, Uint8 *stream, int streamlength);
-
-void readSizes(int level,
-		void *sizes_p){
-
-	int *sizes = reinterpret_cast<int*>(sizes_p);
-
-	const int num_variables = 5;
-	int x;
-	ifstream inFile;
-
-	std::string prefix = "level";
-	std::string level_str = std::to_string(level);
-	std::string suffix = "/num_objects.txt";
-
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
-	}
-
-	for (int i = 0; i < num_variables; i++){
-		inFile >> x;
-		sizes[i] = x;
-	}
-
-	inFile.close();
-}
-
-void readLevel(int level,
-		void *sizes_p,
-		void* plat_pos_x_p, void* plat_pos_y_p, void* plat_size_x_p, void* plat_size_y_p,
-		void* enem_pos_x_p, void* enem_pos_y_p, void* enem_w1_x_p, void* enem_w1_y_p, void* enem_w2_x_p, void* enem_w2_y_p, void* enem_fs_x_p, void* enem_fs_y_p,
-		void* lights_pos_x_p, void* lights_pos_y_p, void* lights_size_x_p, void* lights_size_y_p, void* lights_dir_p,
-		void* doors_pos_x_p, void* doors_pos_y_p,
-		void* ladders_pos_x_p, void* ladders_pos_y_p, void* ladders_height_p){
-
-	int *sizes = reinterpret_cast<int*>(sizes_p);
-
-	//platforms
-	float *plat_pos_x = reinterpret_cast<float*>(plat_pos_x_p);
-	float *plat_pos_y = reinterpret_cast<float*>(plat_pos_y_p);
-	float *plat_size_x = reinterpret_cast<float*>(plat_size_x_p);
-	float *plat_size_y = reinterpret_cast<float*>(plat_size_y_p);
-
-	//enemies
-	float *enem_pos_x = reinterpret_cast<float*>(enem_pos_x_p);
-	float *enem_pos_y = reinterpret_cast<float*>(enem_pos_y_p);
-	float *enem_w1_x = reinterpret_cast<float*>(enem_w1_x_p);
-	float *enem_w1_y = reinterpret_cast<float*>(enem_w1_y_p);
-	float *enem_w2_x = reinterpret_cast<float*>(enem_w2_x_p);
-	float *enem_w2_y = reinterpret_cast<float*>(enem_w2_y_p);
-	float *enem_fs_x = reinterpret_cast<float*>(enem_fs_x_p);
-	float *enem_fs_y = reinterpret_cast<float*>(enem_fs_y_p);
-
-	//lights
-	float *lights_pos_x = reinterpret_cast<float*>(lights_pos_x_p);
-	float *lights_pos_y = reinterpret_cast<float*>(lights_pos_y_p);
-	float *lights_size_x = reinterpret_cast<float*>(lights_size_x_p);
-	float *lights_size_y = reinterpret_cast<float*>(lights_size_y_p);
-	float *lights_dir = reinterpret_cast<float*>(lights_dir_p);
-
-	//doors
-	float *doors_pos_x = reinterpret_cast<float*>(doors_pos_x_p);
-	float *doors_pos_y = reinterpret_cast<float*>(doors_pos_y_p);
-
-	//ladders
-	float *ladders_pos_x = reinterpret_cast<float*>(ladders_pos_x_p);
-	float *ladders_pos_y = reinterpret_cast<float*>(ladders_pos_y_p);
-	float *ladders_height = reinterpret_cast<float*>(ladders_height_p);
-
-	float y;
-	ifstream inFile;
-
-	//initialize the number of objects per things in level
-	int num_lights = sizes[0];
-	int num_plats = sizes[1];
-	int num_enemies = sizes[2];
-	int num_doors = sizes[3];
-	int num_ladders = sizes[4];
-
-	//grab platform info
-	std::string prefix = "level";
-	std::string level_str = std::to_string(level);
-	std::string suffix = "/plats.txt";
-
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
-	}
-
-	for (int i = 0; i < num_plats; i++){
-		inFile >> y;
-		plat_pos_x[i] = y;
-		inFile >> y;
-		plat_pos_y[i] = y;
-		inFile >> y;
-		plat_size_x[i] = y;
-		inFile >> y;
-		plat_size_y[i] = y;
-	}
-
-	inFile.close();
-
-	//grab enemy info
-	suffix = "/enemies.txt";
-
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
-	}
-
-	for (int i = 0; i < num_enemies; i++){
-		inFile >> y;
-		enem_pos_x[i] = y;
-		inFile >> y;
-		enem_pos_y[i] = y;
-		inFile >> y;
-		enem_w1_x[i] = y;
-		inFile >> y;
-		enem_w1_y[i] = y;
-		inFile >> y;
-		enem_w2_x[i] = y;
-		inFile >> y;
-		enem_w2_y[i] = y;
-		inFile >> y;
-		enem_fs_x[i] = y;
-		inFile >> y;
-		enem_fs_y[i] = y;
-	}
+//----------------- Input Actions ----------------------------------------
+/* Keys are looked up in a scancode-indexed table of action masks, so every
+ * key event costs one array access. Actions accumulate into per-frame bitsets
+ * which the gameplay pass reads once per tick.
+ */
+enum Action {
+	ACTION_MENU_UP = 0,
+	ACTION_MENU_DOWN,
+	ACTION_MENU_LEFT,
+	ACTION_MENU_RIGHT,
+	ACTION_SELECT,
+	ACTION_MENU,
+	ACTION_MOVE_LEFT,
+	ACTION_MOVE_RIGHT,
+	ACTION_CLIMB_UP,
+	ACTION_CLIMB_DOWN,
+	ACTION_RUN,
+	ACTION_INTERACT,
+	ACTION_QUIT,
+};
 
-	inFile.close();
+struct ActionState {
+	Uint32 key_actions[SDL_NUM_SCANCODES] = {};
 
-	//grab lights info
-	suffix = "/lights.txt";
+	Uint32 held = 0;
+	Uint32 pressed = 0;   //went down this frame, key repeats included
+	Uint32 triggered = 0; //went down this frame, first press only
+	Uint32 released = 0;  //went up this frame and is still up
 
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
+	void bind(SDL_Keycode key, Uint32 actions) {
+		SDL_Scancode code = SDL_GetScancodeFromKey(key);
+		if (code != SDL_SCANCODE_UNKNOWN) {
+			key_actions[code] |= actions;
+		}
 	}
 
-	for (int i = 0; i < num_lights; i++){
-		inFile >> y;
-		lights_pos_x[i] = y;
-		inFile >> y;
-		lights_pos_y[i] = y;
-		inFile >> y;
-		lights_size_x[i] = y;
-		inFile >> y;
-		lights_size_y[i] = y;
-		inFile >> y;
-		lights_dir[i] = y;
+	void begin_frame() {
+		pressed = 0;
+		triggered = 0;
+		released = 0;
 	}
 
-	inFile.close();
-
-	//grab doors info
-	suffix = "/doors.txt";
-
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
+	void handle_event(SDL_Event const &evt) {
+		Uint32 mask = key_actions[evt.key.keysym.scancode];
+		if (evt.key.state == SDL_PRESSED) {
+			//(released and pressed again before the tick ran -- e.g. events queued up during
+			//a level load -- is still held; the release must not stop what the press started)
+			held |= mask;
+			pressed |= mask;
+			released &= ~mask;
+			if (evt.key.repeat == 0) {
+				triggered |= mask;
+			}
+		} else {
+			held &= ~mask;
+			released |= mask;
+		}
 	}
 
-	for (int i = 0; i < num_doors; i++){
-		inFile >> y;
-		doors_pos_x[i] = y;
-		inFile >> y;
-		doors_pos_y[i] = y;
-	}
+	bool was_pressed(Action action) const { return (pressed & (1u << action)) != 0; }
+	bool was_triggered(Action action) const { return (triggered & (1u << action)) != 0; }
+	bool was_released(Action action) const { return (released & (1u << action)) != 0; }
+};
 
-	inFile.close();
+//----------------- World Events -----------------------------------------
+/* Outcomes that replace or restart the level are queued while the tick runs
+ * and applied once after the update pass, so nothing is reloaded while the
+ * object vectors are being walked.
+ */
+enum WorldEventType {
+	//ordered by precedence, most drastic first:
+	WORLD_RETURN_TO_MENU = 0,
+	WORLD_START_LEVEL,
+	WORLD_LEVEL_COMPLETE,
+	WORLD_CAUGHT,
+};
 
-	//grab ladder info
-	suffix = "/ladders.txt";
+struct WorldEvent {
+	WorldEventType type;
+	int level;
+};
 
-	inFile.open(prefix + level_str + suffix);
-	if (!inFile) {
-		cout << "Unable to open file";
-		exit(1); // terminate with error
-	}
+static void playTone(void *userdata, Uint8 *stream, int streamlength);
 
-	for (int i = 0; i < num_ladders; i++){
-		inFile >> y;
-		ladders_pos_x[i] = y;
-		inFile >> y;
-		ladders_pos_y[i] = y;
-		inFile >> y;
-		ladders_height[i] = y;
-	}
+int main(int argc, char **argv) {
+	//startup stages are timed from here (see --startup-report):
+	StartupTimeline startup;
 
-	inFile.close();
-}
+	//Configuration:
+	struct {
+		std::string title = "Game1: Text/Tiles";
+		glm::uvec2 size = glm::uvec2(1200, 800);
+	} config;
 
-void loadLevel(int level,
-		void* Vector_Platforms_p,
-		void* Vector_Doors_p,
-		void* Vector_Lights_p,
-		void* Vector_Enemies_p,
-		void* Vector_Ladders_p){
-
-	std::vector< Platform >* Vector_Platforms_point = reinterpret_cast< std::vector< Platform > *>(Vector_Platforms_p);
-	std::vector< Door >* Vector_Doors_point = reinterpret_cast< std::vector< Door > *>(Vector_Doors_p);
-	std::vector< Light >* Vector_Lights_point = reinterpret_cast< std::vector< Light > *>(Vector_Lights_p);
-	std::vector< Enemy >* Vector_Enemies_point = reinterpret_cast< std::vector< Enemy > *>(Vector_Enemies_p);
-	std::vector< Ladder >* Vector_Ladders_point = reinterpret_cast< std::vector< Ladder > *>(Vector_Ladders_p);
-
-	//---- Level Loading ----
-	/* Levels will be imported from outside code / txt file. Levels will define
-	 * object initialization, as well as the variables attached to each object.
-	 */
-
-	const int num_variables = 5;
-
-	int sizes[num_variables];
-
-	readSizes(level, reinterpret_cast<void*>(sizes));
-
-	// printf("read sizes successful\n");
-
-	//initialize the number of objects per things in level
-	int num_lights = sizes[0];
-	int num_plats = sizes[1];
-	int num_enemies = sizes[2];
-	int num_doors = sizes[3];
-	int num_ladders = sizes[4];
-
-	float* plat_pos_x;
-	float* plat_pos_y;
-	float* plat_size_x;
-	float* plat_size_y;
-	plat_pos_x = new float[num_plats];
-	plat_pos_y = new float[num_plats];
-	plat_size_x = new float[num_plats];
-	plat_size_y = new float[num_plats];
-
-	float* enem_pos_x;
-	float* enem_pos_y;
-	float* enem_w1_x;
-	float* enem_w1_y;
-	float* enem_w2_x;
-	float* enem_w2_y;
-	float* enem_fs_x;
-	float* enem_fs_y;
-	enem_pos_x = new float[num_enemies];
-	enem_pos_y = new float[num_enemies];
-	enem_w1_x = new float[num_enemies];
-	enem_w1_y = new float[num_enemies];
-	enem_w2_x = new float[num_enemies];
-	enem_w2_y = new float[num_enemies];
-	enem_fs_x = new float[num_enemies];
-	enem_fs_y = new float[num_enemies];
-
-	float* lights_pos_x;
-	float* lights_pos_y;
-	float* lights_size_x;
-	float* lights_size_y;
-	float* lights_dir;
-	lights_pos_x = new float[num_lights];
-	lights_pos_y = new float[num_lights];
-	lights_size_x = new float[num_lights];
-	lights_size_y = new float[num_lights];
-	lights_dir = new float[num_lights];
-
-	float* doors_pos_x;
-	float* doors_pos_y;
-	doors_pos_x = new float[num_doors];
-	doors_pos_y = new float[num_doors];
-
-	float* ladders_pos_x;
-	float* ladders_pos_y;
-	float* ladders_height;
-	ladders_pos_x = new float[num_ladders];
-	ladders_pos_y = new float[num_ladders];
-	ladders_height = new float[num_ladders];
-
-	readLevel(level,
-			reinterpret_cast<void*>(sizes),
-			reinterpret_cast<void*>(plat_pos_x), reinterpret_cast<void*>(plat_pos_y), reinterpret_cast<void*>(plat_size_x), reinterpret_cast<void*>(plat_size_y),
-			reinterpret_cast<void*>(enem_pos_x), reinterpret_cast<void*>(enem_pos_y), reinterpret_cast<void*>(enem_w1_x), reinterpret_cast<void*>(enem_w1_y), 
-			reinterpret_cast<void*>(enem_w2_x), reinterpret_cast<void*>(enem_w2_y), reinterpret_cast<void*>(enem_fs_x), reinterpret_cast<void*>(enem_fs_y),
-			reinterpret_cast<void*>(lights_pos_x), reinterpret_cast<void*>(lights_pos_y), reinterpret_cast<void*>(lights_size_x), reinterpret_cast<void*>(lights_size_y), reinterpret_cast<void*>(lights_dir),
-			reinterpret_cast<void*>(doors_pos_x), reinterpret_cast<void*>(doors_pos_y),
-			reinterpret_cast<void*>(ladders_pos_x), reinterpret_cast<void*>(ladders_pos_y), reinterpret_cast<void*>(ladders_height));
-
-	// printf("read level successful\n");
-
-
-	/***** done importing level, start initializing *****/
-
-	Platform* platforms;
-	Light* lights;
-	Enemy* enemies;
-	Door* door;
-	Ladder* ladders;
-
-	platforms = new Platform[num_plats];
-	lights = new Light[num_lights];
-	enemies = new Enemy[num_enemies];
-	door = new Door[num_doors];
-	ladders = new Ladder[num_ladders];
-
-	for (int i = 0; i < num_plats; i++) {
-		(*Vector_Platforms_point).emplace_back(platforms[i]);
-	}
-	for (int i = 0; i < num_lights; i++) {
-		(*Vector_Lights_point).emplace_back(lights[i]);
-	}
-	for (int i = 0; i < num_enemies; i++) {
-		(*Vector_Enemies_point).emplace_back(enemies[i]);
-	}
-	for (int i = 0; i < num_doors; i++) {
-		(*Vector_Doors_point).emplace_back(door[i]);
+	//--alloc-check <frames>: replay scripted input for that many frames and
+	//fail if any of them allocates after warm-up (needs -DALLOC_TRACKING):
+	uint32_t alloc_check_frames = 0;
+	//--startup-report: print how long each startup stage took, and on which thread, once the first frame is up:
+	bool startup_report = false;
+	//--gl-stats: print how many GL state calls a frame issued and how many were skipped as redundant (every 60 frames);
+	//with -DGL_CALL_COUNTERS, also the calls and time per GL entry point over those frames:
+	bool gl_stats = false;
+	//--sim-rate <hz>: simulation ticks per second (the simulation no longer runs at the display's rate;
+	//sprite animations step once per tick, and were made for 60):
+	uint32_t sim_rate = 60;
+	//--frame-timing: print simulation and render rates and input-to-display latency (every second):
+	bool frame_timing = false;
+	//--upload-bench <sprites>: time uploading that many sprites' vertices (in this build's Vertex format) and exit:
+	uint32_t upload_bench_sprites = 0;
+	//--cpu-usage: print the CPU time used per minute (e.g. to check that a menu left open idles;
+	//std::clock(), so process CPU time -- except on Windows, where it is wall time):
+	bool cpu_usage = false;
+	for (int a = 1; a < argc; ++a) {
+		std::string arg = argv[a];
+		if (arg == "--alloc-check" && a + 1 < argc) {
+			alloc_check_frames = uint32_t(std::max(1, atoi(argv[++a])));
+		} else if (arg == "--startup-report") {
+			startup_report = true;
+		} else if (arg == "--gl-stats") {
+			gl_stats = true;
+		} else if (arg == "--sim-rate" && a + 1 < argc) {
+			sim_rate = uint32_t(std::max(1, atoi(argv[++a])));
+		} else if (arg == "--frame-timing") {
+			frame_timing = true;
+		} else if (arg == "--cpu-usage") {
+			cpu_usage = true;
+		} else if (arg == "--upload-bench" && a + 1 < argc) {
+			upload_bench_sprites = uint32_t(std::max(1, atoi(argv[++a])));
+		} else {
+			std::cerr << "usage: " << argv[0] << " [--alloc-check <frames>] [--startup-report] [--gl-stats] [--sim-rate <hz>] [--frame-timing] [--cpu-usage] [--upload-bench <sprites>]" << std::endl;
+			return 1;
+		}
 	}
-	for (int i = 0; i < num_ladders; i++) {
-		(*Vector_Ladders_point).emplace_back(ladders[i]);
+	if (alloc_check_frames != 0 && !alloc_tracking_enabled()) {
+		std::cerr << "--alloc-check needs a build with -DALLOC_TRACKING (make ALLOC_TRACKING=1)." << std::endl;
+		return 1;
 	}
 
+	//------------  initialization ------------
 
-	//---- Set Object Variables ---
-
-	//Platforms
-	for (int i = 0; i < num_plats; i++) {
-		(*Vector_Platforms_point)[i].pos = glm::vec2(plat_pos_x[i], plat_pos_y[i]);
-		(*Vector_Platforms_point)[i].size = glm::vec2(plat_size_x[i], plat_size_y[i]);
-	}
+	//CPU-side loading (sounds, atlas pages, the first level's files) runs on worker
+	//threads while this thread brings up SDL, the window and GL; the results are
+	//picked up -- and uploaded -- once there is a context to upload them to.
 
-	//Enemies
-	for (int i = 0; i < num_enemies; i++) {
-		(*Vector_Enemies_point)[i].pos = glm::vec2(enem_pos_x[i], enem_pos_y[i]);
-		(*Vector_Enemies_point)[i].waypoints[0] = glm::vec2(enem_w1_x[i], enem_w1_y[i]);
-		(*Vector_Enemies_point)[i].waypoints[1] = glm::vec2(enem_w2_x[i], enem_w2_y[i]);
-		(*Vector_Enemies_point)[i].flashlight.size = glm::vec2(enem_fs_x[i], enem_fs_y[i]);
-		(*Vector_Enemies_point)[i].update_pos();
-		(*Vector_Enemies_point)[i].flashlight.rotate();
+	//Data files come from assets.pack when there is one (see asset_pack.hpp):
+	AssetPack asset_pack;
+	StartupTimeline::Stage pack_stage(&startup, "asset pack");
+	if (asset_pack.open("assets.pack")) {
+		std::cout << "Using assets.pack (" << asset_pack.size() << " files)." << std::endl;
+		use_asset_pack(&asset_pack);
 	}
+	pack_stage.end();
 
-	//Lights
-	for (int i = 0; i < num_lights; i++) {
-		(*Vector_Lights_point)[i].pos = glm::vec2(lights_pos_x[i], lights_pos_y[i]);
-		(*Vector_Lights_point)[i].size = glm::vec2(lights_size_x[i], lights_size_y[i]);
-		(*Vector_Lights_point)[i].dir = PI * lights_dir[i];
+	//sprite atlas (packed pages if pack_atlas has been run, the hand-laid-out sheet otherwise):
+	AtlasManifest atlas;
+	StartupTimeline::Stage manifest_stage(&startup, "atlas manifest");
+	if (!load_atlas_manifest("atlas.manifest", &atlas) && !load_atlas_manifest("atlas_source.manifest", &atlas)) {
+		std::cerr << "Failed to load atlas manifest." << std::endl;
+		exit(1);
 	}
+	use_atlas_manifest(atlas);
+	load_game_sprites();
+	manifest_stage.end();
 
-	//Doors
-	for (int i = 0; i < num_doors; i++) {
-		(*Vector_Doors_point)[i].pos = glm::vec2(doors_pos_x[i], doors_pos_y[i]);
-	}
+	//worker pool for mip generation and per-enemy AI (one thread per hardware core, main thread included)
+	JobSystem jobs;
 
-	//Ladders
-	for (int i = 0; i < num_ladders; i++) {
-		(*Vector_Ladders_point)[i].pos = glm::vec2(ladders_pos_x[i], ladders_pos_y[i]);
-		(*Vector_Ladders_point)[i].size = glm::vec2(1.0f, ladders_height[i]);
+	//Sounds play straight from their (mapped) files, see wav_clip.hpp:
+	//SDL Background Audio
+	WavClip wavClip;
+	//alert audio
+	WavClip alertClip;
+	//door audio
+	WavClip doorClip;
+	//ladder audio
+	WavClip ladderClip;
+	//ornament audio
+	WavClip ornClip;
+	//step audio
+	WavClip stepClip;
+
+	//(the name of the first sound that failed to load, or nullptr:)
+	std::future< char const * > sounds_loaded = std::async(std::launch::async, [&]() -> char const * {
+		StartupTimeline::Stage stage(&startup, "load sounds");
+		if (!wavClip.load(BG_MUSIC_PATH)) return "back ground music";
+		if (!alertClip.load(ALERT_MUSIC_PATH)) return "alert music";
+		if (!doorClip.load(DOOR_MUSIC_PATH)) return "door music";
+		if (!ladderClip.load(LADDER_MUSIC_PATH)) return "ladder music";
+		if (!ornClip.load(ORNAMENT_PATH)) return "ornament sound";
+		if (!stepClip.load(STEP_MUSIC_PATH)) return "step sound";
+		return nullptr;
+	});
+
+	//atlas pages are decoded in order on one worker (which alone uses 'jobs' until they are done):
+	std::vector< std::promise< AtlasPageData > > atlas_page_data(atlas.pages.size());
+	std::vector< std::future< AtlasPageData > > atlas_page_ready;
+	for (auto &page : atlas_page_data) {
+		atlas_page_ready.emplace_back(page.get_future());
 	}
+	std::future< void > atlas_decoded = std::async(std::launch::async, [&]() {
+		for (uint32_t p = 0; p < atlas.pages.size(); ++p) {
+			StartupTimeline::Stage stage(&startup, "decode " + atlas.pages[p].file);
+			AtlasPageData data;
+			load_atlas_page(atlas.pages[p], true, &jobs, &data);
+			atlas_page_data[p].set_value(std::move(data));
+		}
+	});
 
-	// printf("finished initialization\n");
-
-
-	//free memory (initialization is done, we don't need these variable sized arrays)
-
-	delete [] platforms;  // Free memory allocated for the a array.
-	platforms = NULL;     // Be sure the deallocated memory isn't used.
-	delete [] lights;  // Free memory allocated for the a array.
-	lights = NULL;     // Be sure the deallocated memory isn't used.
-	delete [] enemies;  // Free memory allocated for the a array.
-	enemies = NULL;     // Be sure the deallocated memory isn't used.
-	delete [] door;  // Free memory allocated for the a array.
-	door = NULL;     // Be sure the deallocated memory isn't used.
-	delete [] ladders;  // Free memory allocated for the a array.
-	ladders = NULL;     // Be sure the deallocated memory isn't used.
-
-	delete [] plat_pos_x;
-	delete [] plat_pos_y;
-	delete [] plat_size_x;
-	delete [] plat_size_y;
-
-	plat_pos_x = NULL;
-	plat_pos_y = NULL;
-	plat_size_x = NULL;
-	plat_size_y = NULL;
-
-	delete [] enem_pos_x;
-	delete [] enem_pos_y;
-	delete [] enem_w1_x;
-	delete [] enem_w1_y;
-	delete [] enem_w2_x;
-	delete [] enem_w2_y;
-	delete [] enem_fs_x;
-	delete [] enem_fs_y;
-
-	enem_pos_x = NULL;
-	enem_pos_y = NULL;
-	enem_w1_x = NULL;
-	enem_w1_y = NULL;
-	enem_w2_x = NULL;
-	enem_w2_y = NULL;
-	enem_fs_x = NULL;
-	enem_fs_y = NULL;
-
-	delete [] lights_pos_x;
-	delete [] lights_pos_y;
-	delete [] lights_size_x;
-	delete [] lights_size_y;
-	delete [] lights_dir;
-
-	lights_pos_x = NULL;
-	lights_pos_y = NULL;
-	lights_size_x = NULL;
-	lights_size_y = NULL;
-	lights_dir = NULL;
-
-	delete [] doors_pos_x;
-	delete [] doors_pos_y;
-
-	doors_pos_x = NULL;
-	doors_pos_y = NULL;
-
-	delete [] ladders_pos_x;
-	delete [] ladders_pos_y;
-	delete [] ladders_height;
-
-	ladders_pos_x = NULL;
-	ladders_pos_y = NULL;
-	ladders_height = NULL;
-
-	// printf("finished freeing\n");
-}
-
-int main(int argc, char **argv) {
-	//Configuration:
-	struct {
-		std::string title = "Game1: Text/Tiles";
-		glm::uvec2 size = glm::uvec2(1200, 800);
-	} config;
-
-	//------------  initialization ------------
+	//the level select starts on level 0; read its first view's worth of chunks (and margin) ahead:
+	std::future< bool > level_prefetched = std::async(std::launch::async, [&]() {
+		StartupTimeline::Stage stage(&startup, "prefetch level0");
+		return prefetch_level("level0", 3);
+	});
 
 	//Initialize SDL library:
+	StartupTimeline::Stage sdl_stage(&startup, "SDL init");
 	SDL_Init(SDL_INIT_VIDEO);
 	SDL_Init(SDL_INIT_AUDIO);
+	clip_finished_event = SDL_RegisterEvents(1);
+	sdl_stage.end();
 
 	//Ask for an OpenGL context version 3.3, core profile, enable debug:
 	SDL_GL_ResetAttributes();
@@ -962,6 +694,7 @@ int main(int argc, char **argv) {
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
 	//create window:
+	StartupTimeline::Stage window_stage(&startup, "window + GL context");
 	SDL_Window *window = SDL_CreateWindow(
 			config.title.c_str(),
 			SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
@@ -999,116 +732,348 @@ int main(int argc, char **argv) {
 		}
 	}
 
+	window_stage.end();
+
 	//Hide mouse cursor (note: showing can be useful for debugging):
 	//SDL_ShowCursor(SDL_DISABLE);
 
-	//SDL Background Audio
-	SDL_AudioSpec wavSpec;
-	Uint8 *wavStart;
-	Uint32 wavLength;
-	//alert audio
-	SDL_AudioSpec alertSpec;
-	Uint8 *alertStart;
-	Uint32 alertLength;
-	//door audio
-	SDL_AudioSpec doorSpec;
-	Uint8 *doorStart;
-	Uint32 doorLength;
-	//ladder audio
-	SDL_AudioSpec ladderSpec;
-	Uint8 *ladderStart;
-	Uint32 ladderLength;
-	//ornament audio
-	SDL_AudioSpec ornSpec;
-	Uint8 *ornStart;
-	Uint32 ornLength;
-	//step audio
-	SDL_AudioSpec stepSpec;
-	Uint8 *stepStart;
-	Uint32 stepLength;
+	//------------ opengl objects / game assets ------------
 
-	if (SDL_LoadWAV(BG_MUSIC_PATH, &wavSpec, &wavStart, &wavLength) == NULL) {
-		std::cerr << "Failed to load back ground music" << std::endl;
-		exit(1);
+	//block-compressed textures are used when the driver can sample them:
+	bool supports_s3tc = false;
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; ++i) {
+			char const *name = reinterpret_cast< char const * >(glGetStringi(GL_EXTENSIONS, i));
+			if (name && strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) {
+				supports_s3tc = true;
+			}
+		}
 	}
-	if (SDL_LoadWAV(ALERT_MUSIC_PATH, &alertSpec, &alertStart, &alertLength) == NULL) {
-		std::cerr << "Failed to load alert music" << std::endl;
-		exit(1);
+
+	//shaders compile (or load from the cache) while the atlas is still decoding:
+	StartupTimeline::Stage shader_stage(&startup, "shaders");
+
+	//linked programs are kept as driver binaries in shader_cache/ (see program_cache.hpp):
+	ProgramCache program_cache("shader_cache");
+
+	//shader program:
+	GLuint program = 0;
+	GLuint program_Position = 0;
+	GLuint program_TexCoord = 0;
+	GLuint program_Color = 0;
+	GLuint program_mvp = 0;
+	GLuint program_tex = 0;
+	{ //compile shader program:
+		char const *vertex_source =
+				"#version 330\n"
+				"uniform mat4 mvp;\n"
+				"in vec4 Position;\n"
+				"in vec2 TexCoord;\n"
+				"in vec4 Color;\n"
+				"out vec2 texCoord;\n"
+				"out vec4 color;\n"
+				"void main() {\n"
+				"	gl_Position = mvp * Position;\n"
+				"	color = Color;\n"
+				"	texCoord = TexCoord;\n"
+				"}\n";
+
+		char const *fragment_source =
+				"#version 330\n"
+				"uniform sampler2D tex;\n"
+				"in vec4 color;\n"
+				"in vec2 texCoord;\n"
+				"out vec4 fragColor;\n"
+				"void main() {\n"
+				"	fragColor = texture(tex, texCoord) * vec4(color.rgb * color.a, color.a);\n" //textures are premultiplied
+				"}\n";
+
+		program = program_cache.program(vertex_source, fragment_source);
+
+		//look up attribute locations:
+		program_Position = glGetAttribLocation(program, "Position");
+		if (program_Position == -1U) throw std::runtime_error("no attribute named Position");
+		program_TexCoord = glGetAttribLocation(program, "TexCoord");
+		if (program_TexCoord == -1U) throw std::runtime_error("no attribute named TexCoord");
+		program_Color = glGetAttribLocation(program, "Color");
+		if (program_Color == -1U) throw std::runtime_error("no attribute named Color");
+
+		//look up uniform locations:
+		program_mvp = glGetUniformLocation(program, "mvp");
+		if (program_mvp == -1U) throw std::runtime_error("no uniform named mvp");
+		program_tex = glGetUniformLocation(program, "tex");
+		if (program_tex == -1U) throw std::runtime_error("no uniform named tex");
 	}
-	if (SDL_LoadWAV(DOOR_MUSIC_PATH, &doorSpec, &doorStart, &doorLength) == NULL) {
-		std::cerr << "Failed to load door music" << std::endl;
-		exit(1);
+
+	//light cone program: falloff is computed per fragment, no texture needed
+	GLuint cone_program = 0;
+	GLuint cone_program_Position = 0;
+	GLuint cone_program_Cone = 0;
+	GLuint cone_program_Color = 0;
+	GLuint cone_program_mvp = 0;
+	{ //compile cone program:
+		char const *vertex_source =
+				"#version 330\n"
+				"uniform mat4 mvp;\n"
+				"in vec4 Position;\n"
+				"in vec3 Cone;\n" //(along axis, across axis, softness)
+				"in vec4 Color;\n"
+				"out vec3 cone;\n"
+				"out vec4 color;\n"
+				"void main() {\n"
+				"	gl_Position = mvp * Position;\n"
+				"	color = Color;\n"
+				"	cone = Cone;\n"
+				"}\n";
+
+		char const *fragment_source =
+				"#version 330\n"
+				"in vec3 cone;\n"
+				"in vec4 color;\n"
+				"out vec4 fragColor;\n"
+				//1 inside, fading to 0 over the last 'soft' of the way to x = 1:
+				"float fade(float x, float soft) {\n"
+				"	return (soft > 0.0 ? 1.0 - smoothstep(1.0 - soft, 1.0, x) : 1.0);\n"
+				"}\n"
+				"void main() {\n"
+				"	float along = cone.x;\n"
+				"	float across = abs(cone.y) / max(along, 1e-4);\n"
+				"	float alpha = color.a * fade(across, cone.z) * fade(along, cone.z);\n"
+				"	fragColor = vec4(color.rgb * alpha, alpha);\n" //premultiplied, like the sprites
+				"}\n";
+
+		cone_program = program_cache.program(vertex_source, fragment_source);
+
+		//look up attribute locations:
+		cone_program_Position = glGetAttribLocation(cone_program, "Position");
+		if (cone_program_Position == -1U) throw std::runtime_error("no attribute named Position");
+		cone_program_Cone = glGetAttribLocation(cone_program, "Cone");
+		if (cone_program_Cone == -1U) throw std::runtime_error("no attribute named Cone");
+		cone_program_Color = glGetAttribLocation(cone_program, "Color");
+		if (cone_program_Color == -1U) throw std::runtime_error("no attribute named Color");
+
+		//look up uniform locations:
+		cone_program_mvp = glGetUniformLocation(cone_program, "mvp");
+		if (cone_program_mvp == -1U) throw std::runtime_error("no uniform named mvp");
 	}
-	if (SDL_LoadWAV(LADDER_MUSIC_PATH, &ladderSpec, &ladderStart, &ladderLength) == NULL) {
-		std::cerr << "Failed to load ladder music" << std::endl;
-		exit(1);
+
+	shader_stage.end();
+	if (program_cache.misses != 0 && !program_cache.binaries_supported()) {
+		std::cout << "NOTE: driver has no program binary formats; shaders are compiled at every start." << std::endl;
 	}
-	if (SDL_LoadWAV(ORNAMENT_PATH, &ornSpec, &ornStart, &ornLength) == NULL) {
-		std::cerr << "Failed to load ornament sound" << std::endl;
-		exit(1);
+
+	//vertex buffers, one per vertex format (sprites, light cones):
+	GLuint sprite_buffer = 0;
+	GLuint cone_buffer = 0;
+	{ //create vertex buffers
+		glGenBuffers(1, &sprite_buffer);
+		glGenBuffers(1, &cone_buffer);
+	}
+
+	//Sprite vertex positions are relative to an origin that comes with each frame's vertices
+	//(the camera position with COMPACT_VERTICES, else (0,0)), in units of 1 / Vertex::position_scale()
+	//(layout and sizes in sprite_batch.hpp):
+	typedef SpriteVertex Vertex;
+
+	//vertex array object for sprites:
+	GLuint sprite_vao = 0;
+	{ //create sprite_vao and set up binding:
+		glGenVertexArrays(1, &sprite_vao);
+		glBindVertexArray(sprite_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, sprite_buffer);
+#ifdef COMPACT_VERTICES
+		glVertexAttribPointer(program_Position, 2, GL_SHORT, GL_FALSE, sizeof(Vertex), (GLbyte *)0);
+		glVertexAttribPointer(program_TexCoord, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::i16vec2));
+		glVertexAttribPointer(program_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::i16vec2) + sizeof(glm::u16vec2));
+#else
+		glVertexAttribPointer(program_Position, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLbyte *)0);
+		glVertexAttribPointer(program_TexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::vec2));
+		glVertexAttribPointer(program_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::vec2) + sizeof(glm::vec2));
+#endif
+		glEnableVertexAttribArray(program_Position);
+		glEnableVertexAttribArray(program_TexCoord);
+		glEnableVertexAttribArray(program_Color);
+	}
+
+	struct ConeVertex {
+		ConeVertex(glm::vec2 const &Position_, glm::vec3 const &Cone_, glm::u8vec4 const &Color_) :
+			Position(Position_), Cone(Cone_), Color(Color_) { }
+		glm::vec2 Position;
+		glm::vec3 Cone;
+		glm::u8vec4 Color;
+	};
+	static_assert(sizeof(ConeVertex) == 24, "ConeVertex is nicely packed.");
+
+	//vertex array object for light cones:
+	GLuint cone_vao = 0;
+	{ //create cone_vao and set up binding:
+		glGenVertexArrays(1, &cone_vao);
+		glBindVertexArray(cone_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, cone_buffer);
+		glVertexAttribPointer(cone_program_Position, 2, GL_FLOAT, GL_FALSE, sizeof(ConeVertex), (GLbyte *)0);
+		glVertexAttribPointer(cone_program_Cone, 3, GL_FLOAT, GL_FALSE, sizeof(ConeVertex), (GLbyte *)0 + sizeof(glm::vec2));
+		glVertexAttribPointer(cone_program_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ConeVertex), (GLbyte *)0 + sizeof(glm::vec2) + sizeof(glm::vec3));
+		glEnableVertexAttribArray(cone_program_Position);
+		glEnableVertexAttribArray(cone_program_Cone);
+		glEnableVertexAttribArray(cone_program_Color);
 	}
-	if (SDL_LoadWAV(STEP_MUSIC_PATH, &stepSpec, &stepStart, &stepLength) == NULL) {
-		std::cerr << "Failed to load step sound" << std::endl;
+
+	if (upload_bench_sprites != 0) {
+		//sprites scattered over the view, six strip vertices each (as the frame loop makes them):
+		std::vector< Vertex > verts;
+		verts.reserve(upload_bench_sprites * 6);
+		std::mt19937 mt(0x15466);
+		std::uniform_real_distribution< float > unit(0.0f, 1.0f);
+		for (uint32_t i = 0; i < upload_bench_sprites; ++i) {
+			glm::vec2 at = glm::vec2(unit(mt) - 0.5f, unit(mt) - 0.5f) * glm::vec2(12.0f, 8.0f);
+			glm::vec2 uv = glm::vec2(unit(mt), unit(mt)) * 0.9f;
+			glm::u8vec4 tint = glm::u8vec4(0xff, 0xff, 0xff, 0xff);
+			verts.emplace_back(at, uv, tint);
+			verts.emplace_back(verts.back());
+			verts.emplace_back(at + glm::vec2(0.0f, 0.5f), uv + glm::vec2(0.0f, 0.1f), tint);
+			verts.emplace_back(at + glm::vec2(0.5f, 0.0f), uv + glm::vec2(0.1f, 0.0f), tint);
+			verts.emplace_back(at + glm::vec2(0.5f, 0.5f), uv + glm::vec2(0.1f, 0.1f), tint);
+			verts.emplace_back(verts.back());
+		}
+		size_t bytes = sizeof(Vertex) * verts.size();
+
+		glBindVertexArray(sprite_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, sprite_buffer);
+		for (uint32_t i = 0; i < 10; ++i) { //warm up (buffer allocation, driver paths)
+			glBufferData(GL_ARRAY_BUFFER, bytes, verts.data(), GL_STREAM_DRAW);
+		}
+		glFinish();
+		uint32_t const uploads = 200;
+		auto before = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < uploads; ++i) {
+			glBufferData(GL_ARRAY_BUFFER, bytes, verts.data(), GL_STREAM_DRAW);
+			glFinish();
+		}
+		auto after = std::chrono::high_resolution_clock::now();
+		double seconds = std::chrono::duration< double >(after - before).count();
+		std::cout << "upload bench: " << upload_bench_sprites << " sprites, " << sizeof(Vertex) << "-byte vertices: "
+			<< std::fixed << std::setprecision(1) << (bytes / 1024.0) << " KiB per upload, "
+			<< std::setprecision(3) << (seconds * 1000.0 / uploads) << " ms per upload, "
+			<< std::setprecision(1) << (bytes * double(uploads) / seconds / (1024.0 * 1024.0)) << " MiB/s" << std::endl;
+
+		SDL_GL_DeleteContext(context);
+		SDL_DestroyWindow(window);
+		SDL_Quit();
+		return 0;
+	}
+
+	//textures, one per atlas page, uploaded as the worker hands each one over:
+	std::vector< GLuint > atlas_tex(atlas.pages.size(), 0);
+
+	for (uint32_t p = 0; p < atlas.pages.size(); ++p) { //upload texture for page 'p':
+		AtlasPageData data = atlas_page_ready[p].get();
+		if (data.compressed.format == BlockBC3 && !data.compressed.levels.empty() && !supports_s3tc) {
+			//the worker could not know; decode the png here instead (without 'jobs', which the worker may still be using):
+			StartupTimeline::Stage stage(&startup, "decode " + atlas.pages[p].file + " (no s3tc)");
+			load_atlas_page(atlas.pages[p], false, nullptr, &data);
+		}
+		if (!data.loaded) {
+			std::cerr << "Failed to load texture." << std::endl;
+			exit(1);
+		}
+		StartupTimeline::Stage stage(&startup, "upload " + atlas.pages[p].file);
+
+		//create a texture object:
+		glGenTextures(1, &atlas_tex[p]);
+		//bind texture object to GL_TEXTURE_2D:
+		glBindTexture(GL_TEXTURE_2D, atlas_tex[p]);
+
+		if (!data.compressed.levels.empty()) {
+			//the compressed copy made by compress_texture (it carries its own mip chain):
+			upload_compressed_texture(data.compressed);
+		} else {
+			//upload texture data from chain:
+			for (uint32_t i = 0; i < data.chain.size(); ++i) {
+				glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, data.chain[i].width, data.chain[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.chain[i].pixels.data());
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, data.chain.size() - 1);
+		}
+		//set texture sampling parameters:
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+	atlas_decoded.get();
+
+	//sounds:
+	if (char const *failed = sounds_loaded.get()) {
+		std::cerr << "Failed to load " << failed << std::endl;
 		exit(1);
 	}
+	StartupTimeline::Stage audio_stage(&startup, "audio devices");
 
 	AudioData audioData;
-	audioData.pos = wavStart;
-	audioData.length = wavLength;
+	audioData.pos = wavClip.samples;
+	audioData.length = wavClip.length;
 
-	audioData.init_pos = wavStart;
-	audioData.init_length = wavLength;
+	audioData.init_pos = wavClip.samples;
+	audioData.init_length = wavClip.length;
 
+	SDL_AudioSpec wavSpec = clip_spec(wavClip);
 	wavSpec.callback = playTone;
 	wavSpec.userdata = &audioData;
 
 	AudioData doorData;
-	doorData.pos = doorStart;
-	doorData.length = doorLength;
+	doorData.pos = doorClip.samples;
+	doorData.length = doorClip.length;
 
-	doorData.init_pos = doorStart;
-	doorData.init_length = doorLength;
+	doorData.init_pos = doorClip.samples;
+	doorData.init_length = doorClip.length;
 
+	SDL_AudioSpec doorSpec = clip_spec(doorClip);
 	doorSpec.callback = playTone;
 	doorSpec.userdata = &doorData;
 
 	AudioData ladderData;
-	ladderData.pos = ladderStart;
-	ladderData.length = ladderLength;
+	ladderData.pos = ladderClip.samples;
+	ladderData.length = ladderClip.length;
 
-	ladderData.init_pos = ladderStart;
-	ladderData.init_length = ladderLength;
+	ladderData.init_pos = ladderClip.samples;
+	ladderData.init_length = ladderClip.length;
 
+	SDL_AudioSpec ladderSpec = clip_spec(ladderClip);
 	ladderSpec.callback = playTone;
 	ladderSpec.userdata = &ladderData;
 
 	AudioData ornData;
-	ornData.pos = ornStart;
-	ornData.length = ornLength;
+	ornData.pos = ornClip.samples;
+	ornData.length = ornClip.length;
 
-	ornData.init_pos = ornStart;
-	ornData.init_length = ornLength;
+	ornData.init_pos = ornClip.samples;
+	ornData.init_length = ornClip.length;
 
+	SDL_AudioSpec ornSpec = clip_spec(ornClip);
 	ornSpec.callback = playTone;
 	ornSpec.userdata = &ornData;
 
 	AudioData alertData;
-	alertData.pos = alertStart;
-	alertData.length = alertLength;
+	alertData.pos = alertClip.samples;
+	alertData.length = alertClip.length;
 
-	alertData.init_pos = alertStart;
-	alertData.init_length = alertLength;
+	alertData.init_pos = alertClip.samples;
+	alertData.init_length = alertClip.length;
 
+	SDL_AudioSpec alertSpec = clip_spec(alertClip);
 	alertSpec.callback = playTone;
 	alertSpec.userdata = &alertData;
 
 	AudioData stepData;
-	stepData.pos = stepStart;
-	stepData.length = stepLength;
+	stepData.pos = stepClip.samples;
+	stepData.length = stepClip.length;
 
-	stepData.init_pos = stepStart;
-	stepData.init_length = stepLength;
+	stepData.init_pos = stepClip.samples;
+	stepData.init_length = stepClip.length;
 
+	SDL_AudioSpec stepSpec = clip_spec(stepClip);
 	stepSpec.callback = playTone;
 	stepSpec.userdata = &stepData;
 
@@ -1140,137 +1105,7 @@ int main(int argc, char **argv) {
 		std::cerr << "Failed to grab a device (alert)" << std::endl;
 		exit(1);
 	}
-
-
-	//------------ opengl objects / game assets ------------
-
-	//texture:
-	GLuint tex = 0;
-	glm::uvec2 tex_size = glm::uvec2(0,0);
-
-	{ //load texture 'tex':
-		std::vector< uint32_t > data;
-		if (!load_png("atlas.png", &tex_size.x, &tex_size.y, &data, LowerLeftOrigin)) {
-			std::cerr << "Failed to load texture." << std::endl;
-			exit(1);
-		}
-		//create a texture object:
-		glGenTextures(1, &tex);
-		//bind texture object to GL_TEXTURE_2D:
-		glBindTexture(GL_TEXTURE_2D, tex);
-		//upload texture data from data:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex_size.x, tex_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
-		//set texture sampling parameters:
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-
-
-	// separate texture specifically for lights
-	GLuint tex2 = 0;
-	glm::uvec2 tex2_size = glm::uvec2(0,0);
-
-	{ //load texture 'tex2':
-		std::vector< uint32_t > data;
-		if (!load_png("light.png", &tex2_size.x, &tex2_size.y, &data, LowerLeftOrigin)) {
-			std::cerr << "Failed to load texture." << std::endl;
-			exit(1);
-		}
-		//create a texture object:
-		glGenTextures(1, &tex2);
-		//bind texture object to GL_TEXTURE_2D:
-		glBindTexture(GL_TEXTURE_2D, tex2);
-		//upload texture data from data:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex2_size.x, tex2_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
-		//set texture sampling parameters:
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	}
-
-	//shader program:
-	GLuint program = 0;
-	GLuint program_Position = 0;
-	GLuint program_TexCoord = 0;
-	GLuint program_Color = 0;
-	GLuint program_mvp = 0;
-	GLuint program_tex = 0;
-	{ //compile shader program:
-		GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER,
-				"#version 330\n"
-				"uniform mat4 mvp;\n"
-				"in vec4 Position;\n"
-				"in vec2 TexCoord;\n"
-				"in vec4 Color;\n"
-				"out vec2 texCoord;\n"
-				"out vec4 color;\n"
-				"void main() {\n"
-				"	gl_Position = mvp * Position;\n"
-				"	color = Color;\n"
-				"	texCoord = TexCoord;\n"
-				"}\n"
-				);
-
-		GLuint fragment_shader = compile_shader(GL_FRAGMENT_SHADER,
-				"#version 330\n"
-				"uniform sampler2D tex;\n"
-				"in vec4 color;\n"
-				"in vec2 texCoord;\n"
-				"out vec4 fragColor;\n"
-				"void main() {\n"
-				"	fragColor = texture(tex, texCoord) * color;\n"
-				"}\n"
-				);
-
-		program = link_program(fragment_shader, vertex_shader);
-
-		//look up attribute locations:
-		program_Position = glGetAttribLocation(program, "Position");
-		if (program_Position == -1U) throw std::runtime_error("no attribute named Position");
-		program_TexCoord = glGetAttribLocation(program, "TexCoord");
-		if (program_TexCoord == -1U) throw std::runtime_error("no attribute named TexCoord");
-		program_Color = glGetAttribLocation(program, "Color");
-		if (program_Color == -1U) throw std::runtime_error("no attribute named Color");
-
-		//look up uniform locations:
-		program_mvp = glGetUniformLocation(program, "mvp");
-		if (program_mvp == -1U) throw std::runtime_error("no uniform named mvp");
-		program_tex = glGetUniformLocation(program, "tex");
-		if (program_tex == -1U) throw std::runtime_error("no uniform named tex");
-	}
-
-	//vertex buffer:
-	GLuint buffer = 0;
-	{ //create vertex buffer
-		glGenBuffers(1, &buffer);
-		glBindBuffer(GL_ARRAY_BUFFER, buffer);
-	}
-
-	struct Vertex {
-		Vertex(glm::vec2 const &Position_, glm::vec2 const &TexCoord_, glm::u8vec4 const &Color_) :
-			Position(Position_), TexCoord(TexCoord_), Color(Color_) { }
-		glm::vec2 Position;
-		glm::vec2 TexCoord;
-		glm::u8vec4 Color;
-	};
-	static_assert(sizeof(Vertex) == 20, "Vertex is nicely packed.");
-
-	//vertex array object:
-	GLuint vao = 0;
-	{ //create vao and set up binding:
-		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
-		glVertexAttribPointer(program_Position, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLbyte *)0);
-		glVertexAttribPointer(program_TexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::vec2));
-		glVertexAttribPointer(program_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLbyte *)0 + sizeof(glm::vec2) + sizeof(glm::vec2));
-		glEnableVertexAttribArray(program_Position);
-		glEnableVertexAttribArray(program_TexCoord);
-		glEnableVertexAttribArray(program_Color);
-	}
+	audio_stage.end();
 
 	//------------ structs and variables ------------
 
@@ -1292,11 +1127,13 @@ int main(int argc, char **argv) {
 
 	int level = 0;
 
-	std::vector< Platform > Vector_Platforms = {};
-	std::vector< Door > Vector_Doors = {};
-	std::vector< Light > Vector_Lights = {};
-	std::vector< Enemy > Vector_Enemies = {};
-	std::vector< Ladder > Vector_Ladders = {};
+	//the current level's objects all live in one arena, released at once when the level is left
+	Arena level_arena;
+	ArenaVector< Platform > Vector_Platforms{ ArenaAllocator< Platform >(&level_arena) };
+	ArenaVector< Door > Vector_Doors{ ArenaAllocator< Door >(&level_arena) };
+	ArenaVector< Light > Vector_Lights{ ArenaAllocator< Light >(&level_arena) };
+	ArenaVector< Enemy > Vector_Enemies{ ArenaAllocator< Enemy >(&level_arena) };
+	ArenaVector< Ladder > Vector_Ladders{ ArenaAllocator< Ladder >(&level_arena) };
 
 	//to start the game, we don't load the first level, we instead load the main menu page
 	bool in_menu = true;
@@ -1308,6 +1145,7 @@ int main(int argc, char **argv) {
 
 	player.animation_count = 9;
 	player.animation_delay = 0;
+	player.projectiles_pos.reserve(player.num_projectiles);
 
 	//create variables associated with these 2 different screens
 	//for menu
@@ -1324,7 +1162,7 @@ int main(int argc, char **argv) {
 
 	//const float ceiling_height = 10.0f;
 	const float floor_height = 0.25f;
-	const float level_end = 40.0f;
+	float level_end = 40.0f; //set from the level's chunk count when it is entered
 	//for tutorial level, fix later but it looks like it works idk u tell me
 	//const float air_plat_height = 2.0f;
 
@@ -1336,15 +1174,517 @@ int main(int argc, char **argv) {
 	//debugging
 	bool caught = false;
 
+	//world changes queued during a tick (see "apply world events" below)
+	std::vector< WorldEvent > world_events;
+
+	//the current level's chunks are streamed in around the camera
+	LevelStream level_stream;
+	std::vector< LevelChunk const * > arrived_chunks;
+	std::vector< uint32_t > evicted_chunks;
+	std::vector< ChunkReload > reloaded_chunks;
+	std::vector< PlatformSpec > platform_specs;
+
+	//remove the objects of the given kinds (ChunkContents bits) that came from any of 'chunks':
+	auto remove_chunk_objects = [&](std::vector< uint32_t > const &chunks, uint32_t kinds) {
+		auto listed = [&chunks](uint32_t chunk) {
+			return std::find(chunks.begin(), chunks.end(), chunk) != chunks.end();
+		};
+		if (kinds & ChunkDoors) {
+			Vector_Doors.erase(std::remove_if(Vector_Doors.begin(), Vector_Doors.end(), [&](Door const &o) { return listed(o.chunk); }), Vector_Doors.end());
+		}
+		if (kinds & ChunkLights) {
+			Vector_Lights.erase(std::remove_if(Vector_Lights.begin(), Vector_Lights.end(), [&](Light const &o) { return listed(o.chunk); }), Vector_Lights.end());
+		}
+		if (kinds & ChunkEnemies) {
+			Vector_Enemies.erase(std::remove_if(Vector_Enemies.begin(), Vector_Enemies.end(), [&](Enemy const &o) { return listed(o.chunk); }), Vector_Enemies.end());
+		}
+		if (kinds & ChunkLadders) {
+			Vector_Ladders.erase(std::remove_if(Vector_Ladders.begin(), Vector_Ladders.end(), [&](Ladder const &o) { return listed(o.chunk); }), Vector_Ladders.end());
+		}
+	};
+
+	//add the objects of the given kinds from 'chunk' (platforms are handled by rebuild_platforms):
+	auto add_chunk_objects = [&](LevelChunk const &chunk, uint32_t kinds) {
+		if (kinds & ChunkEnemies) {
+			for (EnemySpec const &spec : chunk.enemies) {
+				Vector_Enemies.emplace_back();
+				Enemy &enemy = Vector_Enemies.back();
+				enemy.chunk = chunk.index;
+				enemy.pos = spec.pos;
+				enemy.waypoints[0] = spec.waypoints[0];
+				enemy.waypoints[1] = spec.waypoints[1];
+				enemy.flashlight.set_size(spec.flashlight_size);
+				enemy.update_pos();
+				enemy.flashlight.update();
+			}
+		}
+		if (kinds & ChunkLights) {
+			for (LightSpec const &spec : chunk.lights) {
+				Vector_Lights.emplace_back();
+				Light &light = Vector_Lights.back();
+				light.chunk = chunk.index;
+				light.set_pos(spec.pos);
+				light.set_size(spec.size);
+				light.set_dir(PI * spec.dir);
+				light.color = spec.color;
+				light.softness = spec.softness;
+				light.update();
+			}
+		}
+		if (kinds & ChunkDoors) {
+			for (DoorSpec const &spec : chunk.doors) {
+				Vector_Doors.emplace_back();
+				Vector_Doors.back().chunk = chunk.index;
+				Vector_Doors.back().pos = spec.pos;
+			}
+		}
+		if (kinds & ChunkLadders) {
+			for (LadderSpec const &spec : chunk.ladders) {
+				Vector_Ladders.emplace_back();
+				Vector_Ladders.back().chunk = chunk.index;
+				Vector_Ladders.back().pos = spec.pos;
+				Vector_Ladders.back().size = glm::vec2(1.0f, spec.height);
+			}
+		}
+	};
+
+	//platforms carry no state, so they are rebuilt (with chunk seams merged away):
+	auto rebuild_platforms = [&]() {
+		level_stream.merged_platforms(&platform_specs);
+		Vector_Platforms.clear();
+		for (PlatformSpec const &spec : platform_specs) {
+			Vector_Platforms.emplace_back();
+			Vector_Platforms.back().pos = spec.pos;
+			Vector_Platforms.back().size = spec.size;
+		}
+	};
+
+	//bring the objects in line with the chunks resident for the current camera:
+	auto stream_level = [&]() {
+		float half_view = 0.5f * camera.size.x;
+		level_stream.update(camera.pos.x - half_view, camera.pos.x + half_view, &arrived_chunks, &evicted_chunks);
+		if (arrived_chunks.empty() && evicted_chunks.empty()) return;
+
+		remove_chunk_objects(evicted_chunks, ChunkAll);
+		for (LevelChunk const *arrived : arrived_chunks) {
+			add_chunk_objects(*arrived, ChunkAll);
+		}
+		rebuild_platforms();
+	};
+
+	//reset player statuses
+	auto reset_player = [&]() {
+		player.pos = default_player_pos;
+		player.vel = default_player_vel;
+
+		on_platform = false;
+		on_ladder = false;
+		check_on_ladder = false;
+
+		player.face_right = false;
+		player.jumping = false;
+		player.shifting = false;
+		player.behind_door = false;
+		player.aiming = false;
+		player.visible = false; 
+
+		player.num_projectiles = 9;
+	};
+
+	//empty the level but keep its storage (for restarts):
+	auto clear_level = [&]() {
+		Vector_Platforms.clear();
+		Vector_Doors.clear();
+		Vector_Lights.clear();
+		Vector_Enemies.clear();
+		Vector_Ladders.clear();
+	};
+
+	//hand the level's storage back to the arena and rewind it:
+	auto release_level = [&]() {
+		ArenaVector< Platform >(Vector_Platforms.get_allocator()).swap(Vector_Platforms);
+		ArenaVector< Door >(Vector_Doors.get_allocator()).swap(Vector_Doors);
+		ArenaVector< Light >(Vector_Lights.get_allocator()).swap(Vector_Lights);
+		ArenaVector< Enemy >(Vector_Enemies.get_allocator()).swap(Vector_Enemies);
+		ArenaVector< Ladder >(Vector_Ladders.get_allocator()).swap(Vector_Ladders);
+		level_arena.reset();
+	};
+
+	auto enter_level = [&](int next) {
+		reset_player();
+
+		level = next;
+
+		release_level();
+		if (!level_stream.open("level" + std::to_string(level))) {
+			cout << "Unable to open file";
+			exit(1); // terminate with error
+		}
+		level_end = level_stream.length();
+
+		//size everything from the level header so streaming never reallocates:
+		LevelCounts const &counts = level_stream.counts;
+		level_arena.reserve(
+			counts.platforms * sizeof(Platform) + counts.doors * sizeof(Door) + counts.lights * sizeof(Light)
+			+ counts.enemies * sizeof(Enemy) + counts.ladders * sizeof(Ladder) + 5 * alignof(std::max_align_t));
+		Vector_Platforms.reserve(counts.platforms);
+		Vector_Doors.reserve(counts.doors);
+		Vector_Lights.reserve(counts.lights);
+		Vector_Enemies.reserve(counts.enemies);
+		Vector_Ladders.reserve(counts.ladders);
+
+		//the player starts at the left edge, where the camera is clamped:
+		camera.pos.x = 6.0f;
+		stream_level();
+
+		Arena::Stats const &stats = level_arena.stats();
+		std::cout << "Level " << level << ": " << stats.allocations << " allocation(s), "
+			<< stats.bytes << " of " << stats.capacity << " bytes in " << stats.blocks << " block(s) for "
+			<< counts.platforms << " platforms, " << counts.enemies << " enemies, " << counts.lights << " lights, "
+			<< counts.doors << " doors, " << counts.ladders << " ladders." << std::endl;
+	};
+
+	auto restart_level = [&]() {
+		reset_player();
+
+		//the starting chunks were kept from the load, no file access
+		clear_level();
+		level_stream.restart(&evicted_chunks);
+		camera.pos.x = 6.0f;
+		stream_level();
+	};
+
+	//apply level files edited on disk; only the kinds of object that changed in a
+	//chunk are replaced, so everything else (and the player) keeps its state.
+	//Returns true if anything was applied.
+	auto reload_level = [&]() {
+		bool header_changed = false;
+		level_stream.take_reloads(&reloaded_chunks, &header_changed);
+		if (header_changed) {
+			//new chunk width or count: reopen the level around the player
+			if (level_stream.open("level" + std::to_string(level))) {
+				level_end = level_stream.length();
+				clear_level();
+				stream_level();
+			}
+			return true;
+		}
+		if (reloaded_chunks.empty()) return false;
+
+		bool platforms_changed = false;
+		for (ChunkReload const &reload : reloaded_chunks) {
+			evicted_chunks.assign(1, reload.chunk->index);
+			remove_chunk_objects(evicted_chunks, reload.changed);
+			add_chunk_objects(*reload.chunk, reload.changed);
+			platforms_changed = platforms_changed || (reload.changed & ChunkPlatforms);
+		}
+		if (platforms_changed) {
+			rebuild_platforms();
+		}
+		return true;
+	};
+
+	//noise routing (storage is reused every tick)
+	std::vector< NoiseEvent > noises;
+	ListenerGrid enemy_ears;
+	ListenerGrid light_bulbs;
+
+	//key bindings
+	ActionState actions;
+	actions.bind(SDLK_w, (1u << ACTION_MENU_UP) | (1u << ACTION_CLIMB_UP));
+	actions.bind(SDLK_UP, (1u << ACTION_MENU_UP));
+	actions.bind(SDLK_s, (1u << ACTION_MENU_DOWN) | (1u << ACTION_CLIMB_DOWN));
+	actions.bind(SDLK_DOWN, (1u << ACTION_MENU_DOWN));
+	actions.bind(SDLK_a, (1u << ACTION_MENU_LEFT) | (1u << ACTION_MOVE_LEFT));
+	actions.bind(SDLK_LEFT, (1u << ACTION_MENU_LEFT));
+	actions.bind(SDLK_d, (1u << ACTION_MENU_RIGHT) | (1u << ACTION_MOVE_RIGHT));
+	actions.bind(SDLK_RIGHT, (1u << ACTION_MENU_RIGHT));
+	actions.bind(SDLK_RETURN, (1u << ACTION_SELECT));
+	actions.bind(SDLK_m, (1u << ACTION_MENU));
+	actions.bind(SDLK_LSHIFT, (1u << ACTION_RUN));
+	actions.bind(SDLK_SPACE, (1u << ACTION_INTERACT));
+	actions.bind(SDLK_ESCAPE, (1u << ACTION_QUIT));
+
+	//true if the player (at 'at') fits inside any ladder
+	auto touching_ladder = [&Vector_Ladders, &player](glm::vec2 const &at) {
+		bool touching = false;
+		for (Ladder& ladder : Vector_Ladders){
+			ladder.detect_collision(at, player.size);
+			touching = touching || ladder.player_collision;
+		}
+		return touching;
+	};
+
 	//------------ game loop ------------
 
-	//Start audio playback
-	SDL_PauseAudioDevice(audioDevice, 0);
+	//Start audio playback
+	SDL_PauseAudioDevice(audioDevice, 0);
+
+	//draw order: a sprite's layer puts it above everything in lower layers; within a
+	//layer, sprites are grouped by material and atlas page (see render_queue.hpp):
+	enum RenderLayer : uint32_t {
+		LayerDoors = 0,
+		LayerLadders,
+		LayerPlayer,
+		LayerEnemies, //(and their alert marks)
+		LayerHints,
+		LayerMenus,
+		LayerPlatforms,
+		LayerSounds,
+		LayerUI,
+		LayerLights, //light cones, on top of everything (as they have always been drawn)
+	};
+	enum RenderMaterial : uint32_t {
+		MaterialSprite = 0, //'program', Vertex, premultiplied alpha
+		MaterialCone, //'cone_program', ConeVertex, premultiplied alpha
+	};
+
+	//per-frame draw storage, reused so drawing does not allocate once it has grown:
+	RenderQueue render_queue; //one command per sprite or cone; payload: index into sprite_records / cone_verts
+	std::vector< SpriteRecord > sprite_records; //one per sprite, in submission order
+	std::vector< Vertex > sprite_verts; //six strip vertices per sprite record (made by emit_sprites)
+	std::vector< ConeVertex > cone_verts; //five strip vertices per cone, in submission order
+	struct DrawBatch {
+		uint32_t material;
+		uint32_t texture; //atlas page
+		GLint first;
+		GLsizei count;
+	};
+
+	//everything the render thread needs to draw one simulation tick:
+	struct RenderSnapshot {
+		uint32_t tick = 0;
+		glm::vec4 clear_color;
+		CameraInfo camera;
+		glm::vec2 sprite_origin = glm::vec2(0.0f); //what sprite_verts' positions are relative to
+		std::vector< Vertex > sprite_verts; //sorted into draw order (what gets uploaded)
+		std::vector< ConeVertex > cone_verts;
+		std::vector< DrawBatch > batches;
+		//the oldest input not known to be on screen yet: its SDL timestamp, and the tick that first saw it:
+		bool has_input = false;
+		Uint32 input_time = 0;
+		uint32_t input_tick = 0;
+	};
+	//simulation -> render thread (the render thread always draws the newest):
+	TripleBuffer< RenderSnapshot > snapshots;
+	//ticks simulated so far, and the newest tick the render thread has presented:
+	std::atomic< uint32_t > sim_ticks(0);
+	std::atomic< uint32_t > presented_tick(0);
+
+	//count heap allocations per frame and phase (only with -DALLOC_TRACKING),
+	//for simulation ticks (this thread) and rendered frames (the render thread):
+	FrameAllocTracker frame_allocs;
+	FrameAllocTracker render_allocs;
+
+	//feed a key to the actions as if it came from SDL (for --alloc-check):
+	auto script_key = [&actions](SDL_Keycode key, bool down) {
+		SDL_Event key_evt;
+		memset(&key_evt, 0, sizeof(key_evt));
+		key_evt.type = (down ? SDL_KEYDOWN : SDL_KEYUP);
+		key_evt.key.state = (down ? SDL_PRESSED : SDL_RELEASED);
+		key_evt.key.keysym.sym = key;
+		key_evt.key.keysym.scancode = SDL_GetScancodeFromKey(key);
+		actions.handle_event(key_evt);
+	};
+
+	//(startup's GL calls are not part of any frame)
+	gl_call_counters_reset();
+
+	//------------ render thread ------------
+
+	//From here on the GL context belongs to the render thread: it draws the newest
+	//snapshot and swaps (waiting for vsync there), while this thread handles input
+	//and runs the simulation at its own rate.
+	SDL_GL_MakeCurrent(window, nullptr);
+	std::thread render_thread([&]() {
+		SDL_GL_MakeCurrent(window, context);
+
+		//the frame's GL state changes go through this, which skips the redundant ones:
+		GLState gl;
+		//camera transform, rebuilt when the camera moves:
+		glm::mat4 mvp;
+		glm::mat4 sprite_mvp; //(for positions relative to the snapshot's sprite_origin, in Vertex units)
+		CameraInfo mvp_camera;
+		mvp_camera.size = glm::vec2(0.0f); //(no camera has this size, so the first frame builds it)
+		glm::vec2 mvp_sprite_origin = glm::vec2(0.0f);
+
+		//--frame-timing, over the last second:
+		auto timing_start = std::chrono::steady_clock::now();
+		uint32_t timing_frames = 0;
+		uint32_t timing_ticks = sim_ticks.load();
+		uint32_t latency_count = 0;
+		Uint32 latency_total = 0, latency_max = 0;
+		uint32_t last_input_tick = 0;
+
+		while (RenderSnapshot const *snapshot = snapshots.acquire()) {
+			render_allocs.begin_frame();
+			render_allocs.phase("submit");
+			gl.begin_frame();
+			gl.clear_color(snapshot->clear_color);
+			glClear(GL_COLOR_BUFFER_BIT);
+			gl.set_enabled(GL_BLEND, true);
+			gl.blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); //premultiplied alpha
+
+			CameraInfo const &camera = snapshot->camera;
+			if (camera.pos != mvp_camera.pos || camera.size != mvp_camera.size || snapshot->sprite_origin != mvp_sprite_origin) {
+				glm::vec2 scale = 2.0f / camera.size;
+				glm::vec2 offset = scale * -camera.pos;
+				mvp = glm::mat4(
+						glm::vec4(scale.x, 0.0f, 0.0f, 0.0f),
+						glm::vec4(0.0f, scale.y, 0.0f, 0.0f),
+						glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+						glm::vec4(offset.x, offset.y, 0.0f, 1.0f)
+						);
+				glm::vec2 sprite_scale = scale / Vertex::position_scale();
+				glm::vec2 sprite_offset = scale * (snapshot->sprite_origin - camera.pos);
+				sprite_mvp = glm::mat4(
+						glm::vec4(sprite_scale.x, 0.0f, 0.0f, 0.0f),
+						glm::vec4(0.0f, sprite_scale.y, 0.0f, 0.0f),
+						glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+						glm::vec4(sprite_offset.x, sprite_offset.y, 0.0f, 1.0f)
+						);
+				mvp_camera = camera;
+				mvp_sprite_origin = snapshot->sprite_origin;
+			}
+
+			if (!snapshot->sprite_verts.empty()) {
+				gl.bind_array_buffer(sprite_buffer);
+				gl.array_buffer_data(&snapshot->sprite_verts[0], sizeof(Vertex) * snapshot->sprite_verts.size(), GL_STREAM_DRAW);
+			}
+			if (!snapshot->cone_verts.empty()) {
+				gl.bind_array_buffer(cone_buffer);
+				gl.array_buffer_data(&snapshot->cone_verts[0], sizeof(ConeVertex) * snapshot->cone_verts.size(), GL_STREAM_DRAW);
+			}
+
+			for (auto const &batch : snapshot->batches) {
+				if (batch.material == MaterialCone) {
+					gl.use_program(cone_program);
+					gl.uniform(cone_program_mvp, mvp);
+					gl.bind_vertex_array(cone_vao);
+				} else {
+					gl.use_program(program);
+					gl.uniform(program_tex, 0);
+					gl.uniform(program_mvp, sprite_mvp);
+					gl.bind_vertex_array(sprite_vao);
+					gl.bind_texture_2d(0, atlas_tex[batch.texture]);
+				}
+				glDrawArrays(GL_TRIANGLE_STRIP, batch.first, batch.count);
+			}
+
+			render_allocs.phase("swap");
+			SDL_GL_SwapWindow(window);
+			presented_tick.store(snapshot->tick);
+			render_allocs.end_frame();
+
+			//input to display: from the event's timestamp to the return of the swap that first shows its effect:
+			if (snapshot->has_input && snapshot->input_tick != last_input_tick) {
+				Uint32 latency = SDL_GetTicks() - snapshot->input_time;
+				latency_count += 1;
+				latency_total += latency;
+				latency_max = std::max(latency_max, latency);
+				last_input_tick = snapshot->input_tick;
+			}
+
+			if (startup_report) {
+				startup.first_frame();
+				startup.report();
+				startup_report = false;
+			}
+			if (gl_stats && render_allocs.frame % 60 == 0) {
+				GLState::print_counts(gl.frame);
+				gl_call_counters_report(60);
+			}
+			timing_frames += 1;
+			if (frame_timing) {
+				auto now = std::chrono::steady_clock::now();
+				float seconds = std::chrono::duration< float >(now - timing_start).count();
+				if (seconds >= 1.0f) {
+					uint32_t ticks = sim_ticks.load();
+					printf("frame timing: %.1f simulation ticks/s, %.1f frames/s, input to display %.1f ms average, %u ms max (%u inputs)\n",
+						(ticks - timing_ticks) / seconds, timing_frames / seconds,
+						latency_count ? float(latency_total) / latency_count : 0.0f, latency_max, latency_count);
+					timing_start = now;
+					timing_frames = 0;
+					timing_ticks = ticks;
+					latency_count = 0;
+					latency_total = latency_max = 0;
+				}
+			}
+		}
+
+		SDL_GL_MakeCurrent(window, nullptr);
+	});
+
+	//------------ simulation ------------
+
+	//Every tick advances the game by the same step; the clock only decides when
+	//ticks run (behind by less than max_lag, they run back to back to catch up):
+	float const tick_seconds = 1.0f / float(sim_rate);
+	auto const tick_period = std::chrono::duration_cast< std::chrono::steady_clock::duration >(std::chrono::duration< double >(1.0 / sim_rate));
+	auto const max_lag = std::chrono::milliseconds(250);
+	auto next_tick = std::chrono::steady_clock::now();
+	uint32_t tick = 0;
+	//the oldest input whose effect is not known to be on screen (see RenderSnapshot):
+	bool input_pending = false;
+	Uint32 input_time = 0;
+	uint32_t input_tick = 0;
+
+	//A tick whose picture is the same as the last one sent is not sent (the render thread
+	//sleeps and the frame on screen stays up). In the menus, or while aiming (which freezes
+	//the world), a picture that stays the same for a quarter second puts this thread to
+	//sleep until an event arrives: input, a window event, a clip ending (see playTone),
+	//or the idle timeout, which keeps slow time-driven changes going.
+	auto snapshot_hash = [](RenderSnapshot const &snapshot) -> uint64_t {
+		uint64_t hash = 0xcbf29ce484222325ULL; //64-bit FNV-1a
+		auto add = [&hash](void const *data, size_t size) {
+			uint8_t const *bytes = reinterpret_cast< uint8_t const * >(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+			}
+		};
+		add(&snapshot.clear_color, sizeof(snapshot.clear_color));
+		add(&snapshot.camera, sizeof(snapshot.camera));
+		add(&snapshot.sprite_origin, sizeof(snapshot.sprite_origin));
+		add(snapshot.sprite_verts.data(), sizeof(Vertex) * snapshot.sprite_verts.size());
+		add(snapshot.cone_verts.data(), sizeof(ConeVertex) * snapshot.cone_verts.size());
+		add(snapshot.batches.data(), sizeof(DrawBatch) * snapshot.batches.size());
+		return hash;
+	};
+	uint64_t sent_hash = 0;
+	bool redraw = true; //send the next picture even if it is unchanged (e.g. the window was exposed)
+	uint32_t still_ticks = 0;
+	uint32_t const idle_after_ticks = std::max(1u, sim_rate / 4);
+	int const idle_timeout_ms = 250;
+
+	//--cpu-usage, over the last minute:
+	auto usage_start = std::chrono::steady_clock::now();
+	std::clock_t usage_cpu_start = std::clock();
+	uint32_t usage_ticks = 0, usage_sent = 0, usage_idle_waits = 0;
 
 	bool should_quit = false;
 	while (true) {
+		frame_allocs.begin_frame();
+		tick += 1;
+		if (input_pending && presented_tick.load() >= input_tick) {
+			input_pending = false;
+		}
+
+		//level files edited since the last frame, applied before anything walks the objects:
+		frame_allocs.phase("reload");
+		if (!in_menu && reload_level()) {
+			frame_allocs.excuse_frame();
+		}
+
+		frame_allocs.phase("input");
+
 		static SDL_Event evt;
+		actions.begin_frame();
 		while (SDL_PollEvent(&evt) == 1) {
+			if (!input_pending && (evt.type == SDL_MOUSEMOTION || evt.type == SDL_MOUSEBUTTONDOWN || evt.type == SDL_KEYDOWN || evt.type == SDL_KEYUP)) {
+				input_pending = true;
+				input_time = evt.common.timestamp;
+				input_tick = tick;
+			}
 			//handle input:
 			if (evt.type == SDL_MOUSEMOTION) {
 				mouse.pos.x = ((evt.motion.x + 0.5f) / float(config.size.x) * 2.0f - 1.0f) * 0.5f * camera.size.x + camera.pos.x;
@@ -1366,337 +1706,180 @@ int main(int argc, char **argv) {
 					}
 				}
 			} 
-			else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_ESCAPE) {
-				should_quit = true;
-			} 
 			else if (evt.type == SDL_KEYDOWN || evt.type == SDL_KEYUP) {
-				if (evt.key.keysym.sym == SDLK_w) {
-					if (in_menu && evt.key.state == SDL_PRESSED){
-						if (!in_level_select){
-							play_highlighted = !play_highlighted;
-						}
-						else{
-							back_button_highlighted = !back_button_highlighted;
-						}
-					}
-
-					if (!in_menu && !on_ladder && !player.aiming && evt.key.state == SDL_PRESSED) {
-						//climb onto the ladder
-						for (Ladder& ladder : Vector_Ladders){
-							ladder.detect_collision(player.pos, player.size);
-							on_ladder = on_ladder || ladder.player_collision;
-						}
-
-						if (on_ladder){
-							/****** add "player climbing" sprite *******/
-						}
-					}
+				actions.handle_event(evt);
+			} 
+			else if (evt.type == SDL_WINDOWEVENT) {
+				redraw = true;
+			}
+			else if (evt.type == SDL_QUIT) {
+				should_quit = true;
+				break;
+			}
+		}
 
-					if (!in_menu && on_ladder && evt.key.state == SDL_PRESSED) {
-						check_on_ladder = false;
+		if (alloc_check_frames != 0) {
+			//scripted replay: start the first level, then run right and back left in turns
+			uint32_t frame = frame_allocs.frame;
+			if (frame == 0) {
+				world_events.push_back(WorldEvent{WORLD_START_LEVEL, 0});
+			} else if (frame == 1) {
+				script_key(SDLK_LSHIFT, true);
+			}
+			if (frame % 900 == 1) {
+				script_key(SDLK_a, false);
+				script_key(SDLK_d, true);
+			} else if (frame % 900 == 601) {
+				script_key(SDLK_d, false);
+				script_key(SDLK_a, true);
+			}
+			if (frame >= alloc_check_frames) {
+				should_quit = true;
+			}
+		}
 
-						//check if player will remain on ladder
-						for (Ladder& ladder : Vector_Ladders){
-							ladder.detect_collision(glm::vec2(player.pos.x, player.pos.y + 0.02f), player.size);
-							check_on_ladder = check_on_ladder || ladder.player_collision;
-						}
+		//apply input actions (once per tick) --------------------------------------
+		if (actions.was_pressed(ACTION_QUIT)) {
+			should_quit = true;
+		}
 
-						if (check_on_ladder){
-							//climb the actual ladder
-							SDL_PauseAudioDevice(ladderDevice, 0);
-							player.pos.y += 0.1f;
-						}
-					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_UP) {
-					if (in_menu && evt.key.state == SDL_PRESSED){
-						if (!in_level_select){
-							play_highlighted = !play_highlighted;
-						}
-						else{
-							back_button_highlighted = !back_button_highlighted;
-						}
-					}
-				} 
-				//selection using the return key
-				else if (evt.key.keysym.sym == SDLK_RETURN) {
-					if (in_menu && evt.key.state == SDL_PRESSED){
-						if (!in_level_select){
-							if (play_highlighted){
-								in_level_select = true;
-								back_button_highlighted = false;
-							} else{
-								should_quit = true;
-							}
-						}else{
-							if (back_button_highlighted){
-								in_level_select = false;
-							}else{
-								//load the level in this case
-
-								//exit main menu and level select
-								in_menu = false;
-								in_level_select = false;
-
-								//reset player statuses
-								player.pos = default_player_pos;
-								player.vel = default_player_vel;
-
-								on_platform = false;
-								on_ladder = false;
-								check_on_ladder = false;
-
-								player.face_right = false;
-								player.jumping = false;
-								player.shifting = false;
-								player.behind_door = false;
-								player.aiming = false;
-								player.visible = false; 
-
-								player.num_projectiles = 9;
-
-								level = level_highlighted;
-
-								Vector_Platforms = {};
-								Vector_Doors = {};
-								Vector_Lights = {};
-								Vector_Enemies = {};
-								Vector_Ladders = {};
-
-								loadLevel(level,
-										reinterpret_cast<void*>(&Vector_Platforms),
-										reinterpret_cast<void*>(&Vector_Doors),
-										reinterpret_cast<void*>(&Vector_Lights),
-										reinterpret_cast<void*>(&Vector_Enemies),
-										reinterpret_cast<void*>(&Vector_Ladders));
-							}
-						}
+		//testing ability to return to main menu
+		if (actions.was_pressed(ACTION_MENU)) {
+			world_events.push_back(WorldEvent{WORLD_RETURN_TO_MENU, 0});
+		}
+		else if (in_menu) {
+			if (actions.was_pressed(ACTION_MENU_UP)) {
+				if (!in_level_select){
+					play_highlighted = !play_highlighted;
+				}
+				else{
+					back_button_highlighted = !back_button_highlighted;
+				}
+			}
+			if (actions.was_pressed(ACTION_MENU_DOWN)) {
+				if (!in_level_select){
+					play_highlighted = !play_highlighted;
+				}else{
+					back_button_highlighted = !back_button_highlighted;
+				}
+			}
+			if (in_level_select && !back_button_highlighted) {
+				if (actions.was_pressed(ACTION_MENU_LEFT)) {
+					if (level_highlighted == 0){
+						level_highlighted = num_unlocked;
 					}
-				} 
-				//testing ability to return to main menu
-				else if (evt.key.keysym.sym == SDLK_m) {
-					//go to menu
-					in_menu = true;
-					in_level_select = false;
-					play_highlighted = true;
-
-					//reset player statuses
-					player.pos = default_player_pos;
-					player.vel = default_player_vel;
-
-					on_platform = false;
-					on_ladder = false;
-					check_on_ladder = false;
-
-					player.face_right = false;
-					player.jumping = false;
-					player.shifting = false;
-
-					//we set player behind door as a hack to "remove" player while we're in the main menu
-					player.behind_door = true;
-
-					player.aiming = false;
-					player.visible = false; 
-
-					player.num_projectiles = 9;
-
-					//reset to level 0 just in case (shouldn't matter though)
-					level = 0;
-
-					Vector_Platforms = {};
-					Vector_Doors = {};
-					Vector_Lights = {};
-					Vector_Enemies = {};
-					Vector_Ladders = {};
-				} 
-				else if (evt.key.keysym.sym == SDLK_a) {
-					if (evt.key.state == SDL_PRESSED) {
-						if (in_menu){
-							if (in_level_select){
-								if (!back_button_highlighted){
-									if (level_highlighted == 0){
-										level_highlighted = num_unlocked;
-									}
-									else{
-										level_highlighted -= 1;
-									}
-								}
-							}
-						}
-						else{
-							if (player.shifting) {
-								player.vel.x = -2.0f;
-								player.face_right = false;
-							} else {
-								player.vel.x = -1.0f;
-								player.face_right = false;
-							}
-							if (on_ladder){
-								on_ladder = false;
-							}
-						}
-					} else {
-						if (player.vel.x == -1.0f || player.vel.x == -2.0f) {
-							player.vel.x = 0.0f;
-						}
+					else{
+						level_highlighted -= 1;
 					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_LEFT) {
-					if (evt.key.state == SDL_PRESSED) {
-						if (in_menu){
-							if (in_level_select){
-								if (!back_button_highlighted){
-									if (level_highlighted == 0){
-										level_highlighted = num_unlocked;
-									}
-									else{
-										level_highlighted -= 1;
-									}
-								}
-							}
-						}
+				}
+				if (actions.was_pressed(ACTION_MENU_RIGHT)) {
+					if (level_highlighted == num_unlocked){
+						level_highlighted = 0;
 					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_d) {
-					if (evt.key.state == SDL_PRESSED) {
-						if (in_menu){
-							if (in_level_select){
-								if (!back_button_highlighted){
-									if (level_highlighted == num_unlocked){
-										level_highlighted = 0;
-									}
-									else{
-										level_highlighted += 1;
-									}
-								}
-							}
-						}
-						else{
-							if (player.shifting) {
-								player.vel.x = 2.0f;
-								player.face_right = true;
-							} else {
-								player.vel.x = 1.0f;
-								player.face_right = true;
-							}
-							if (on_ladder){
-								on_ladder = false;
-							}
-						}
-
-					} else {
-						if (player.vel.x == 1.0f || player.vel.x == 2.0f) {
-							player.vel.x = 0.0f;
-						}
+					else{
+						level_highlighted += 1;
 					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_RIGHT) {
-					if (evt.key.state == SDL_PRESSED) {
-						if (in_menu){
-							if (in_level_select){
-								if (!back_button_highlighted){
-									if (level_highlighted == num_unlocked){
-										level_highlighted = 0;
-									}
-									else{
-										level_highlighted += 1;
-									}
-								}
-							}
-						}
+				}
+			}
+			//selection using the return key
+			if (actions.was_pressed(ACTION_SELECT)) {
+				if (!in_level_select){
+					if (play_highlighted){
+						in_level_select = true;
+						back_button_highlighted = false;
+					} else{
+						should_quit = true;
 					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_s) {
-					if (in_menu && evt.key.state == SDL_PRESSED){
-						if (!in_level_select){
-							play_highlighted = !play_highlighted;
-						}else{
-							back_button_highlighted = !back_button_highlighted;
-						}
+				}else{
+					if (back_button_highlighted){
+						in_level_select = false;
+					}else{
+						//load the level in this case
+						world_events.push_back(WorldEvent{WORLD_START_LEVEL, level_highlighted});
 					}
+				}
+			}
+		}
+		else {
+			if (actions.was_pressed(ACTION_MOVE_LEFT)) {
+				player.vel.x = player.shifting ? -2.0f : -1.0f;
+				player.face_right = false;
+				on_ladder = false;
+			}
+			if (actions.was_pressed(ACTION_MOVE_RIGHT)) {
+				player.vel.x = player.shifting ? 2.0f : 1.0f;
+				player.face_right = true;
+				on_ladder = false;
+			}
 
-					if (!in_menu && !on_ladder && !player.aiming && evt.key.state == SDL_PRESSED) {
-						//climb onto the ladder
-						for (Ladder& ladder : Vector_Ladders){
-							ladder.detect_collision(player.pos, player.size);
-							on_ladder = on_ladder || ladder.player_collision;
-						}
-
-						if (on_ladder){
-							/****** add "player climbing" sprite *******/
-						}
-					}
+			//ladders are scanned at most once per direction per tick, however many
+			//key repeats arrived since the last frame
+			bool climb_up = actions.was_pressed(ACTION_CLIMB_UP);
+			bool climb_down = actions.was_pressed(ACTION_CLIMB_DOWN);
+			if ((climb_up || climb_down) && !on_ladder && !player.aiming) {
+				//climb onto the ladder
+				on_ladder = touching_ladder(player.pos);
+			}
+			if (on_ladder && climb_up) {
+				//check if player will remain on ladder
+				check_on_ladder = touching_ladder(glm::vec2(player.pos.x, player.pos.y + 0.02f));
+				if (check_on_ladder){
+					//climb the actual ladder
+					SDL_PauseAudioDevice(ladderDevice, 0);
+					player.pos.y += 0.1f;
+				}
+			}
+			if (on_ladder && climb_down) {
+				//check if player will remain on ladder
+				check_on_ladder = touching_ladder(glm::vec2(player.pos.x, player.pos.y - 0.02f));
+				if (check_on_ladder){
+					//climb the actual ladder
+					player.pos.y -= 0.1f;
+				}
+			}
+		}
 
-					if (!in_menu && evt.key.state == SDL_PRESSED) {
-						if (on_ladder){
-							check_on_ladder = false;
+		if (actions.was_released(ACTION_MOVE_LEFT)) {
+			if (player.vel.x == -1.0f || player.vel.x == -2.0f) {
+				player.vel.x = 0.0f;
+			}
+		}
+		if (actions.was_released(ACTION_MOVE_RIGHT)) {
+			if (player.vel.x == 1.0f || player.vel.x == 2.0f) {
+				player.vel.x = 0.0f;
+			}
+		}
 
-							//check if player will remain on ladder
-							for (Ladder& ladder : Vector_Ladders){
-								ladder.detect_collision(glm::vec2(player.pos.x, player.pos.y - 0.02f), player.size);
-								check_on_ladder = check_on_ladder || ladder.player_collision;
-							}
+		if (actions.was_pressed(ACTION_RUN)) {
+			if (player.vel.x == 1.0f) {
+				player.face_right = true;
+				player.vel.x = 2.0f;
+			} else if (player.vel.x == -1.0f) {
+				player.face_right = false;
+				player.vel.x = -2.0f;
+			}
+			player.shifting = true;
+		}
+		if (actions.was_released(ACTION_RUN)) {
+			if (player.vel.x == 2.0f) {
+				player.face_right = true;
+				player.vel.x = 1.0f;
+			} else if (player.vel.x == -2.0f) {
+				player.face_right = false;
+				player.vel.x = -1.0f;
+			}
+			player.shifting = false;
+		}
 
-							if (check_on_ladder){
-								//climb the actual ladder
-								player.pos.y -= 0.1f;
-							}
-						}
-					} else {
-						if (player.vel.x == 1.0f || player.vel.x == 2.0f) {
-							player.vel.x = 0.0f;
-						}
-					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_DOWN) {
-					if (in_menu && evt.key.state == SDL_PRESSED){
-						if (!in_level_select){
-							play_highlighted = !play_highlighted;
-						}else{
-							back_button_highlighted = !back_button_highlighted;
-						}
-					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_LSHIFT) {
-					if (evt.key.state == SDL_PRESSED) {
-						if (player.vel.x == 1.0f) {
-							player.face_right = true;
-							player.vel.x = 2.0f;
-						} else if (player.vel.x == -1.0f) {
-							player.face_right = false;
-							player.vel.x = -2.0f;
-						}
-						player.shifting = true;
-					} else {
-						if (player.vel.x == 2.0f) {
-							player.face_right = true;
-							player.vel.x = 1.0f;
-						} else if (player.vel.x == -2.0f) {
-							player.face_right = false;
-							player.vel.x = -1.0f;
-						}
-						player.shifting = false;
-					}
-				} 
-				else if (evt.key.keysym.sym == SDLK_SPACE) {
-					// handle space press
-					// check interractable state
-					if (evt.type == SDL_KEYDOWN && evt.key.repeat == 0) {
-						for (Door& door : Vector_Doors){
-							if (player.pos.x + player.size.x / 2 < door.pos.x + door.size.x / 2
-									&& player.pos.x - player.size.x / 2 > door.pos.x - door.size.x / 2
-									&& player.pos.y + player.size.y / 2 < door.pos.y + door.size.y / 2) {
-								SDL_PauseAudioDevice(doorDevice, 0);
-								player.behind_door = !player.behind_door;
-							}
-						}
-					}	
+		// check interractable state
+		if (actions.was_triggered(ACTION_INTERACT)) {
+			for (Door& door : Vector_Doors){
+				if (player.pos.x + player.size.x / 2 < door.pos.x + door.size.x / 2
+						&& player.pos.x - player.size.x / 2 > door.pos.x - door.size.x / 2
+						&& player.pos.y + player.size.y / 2 < door.pos.y + door.size.y / 2) {
+					SDL_PauseAudioDevice(doorDevice, 0);
+					player.behind_door = !player.behind_door;
 				}
-			} 
-
-			else if (evt.type == SDL_QUIT) {
-				should_quit = true;
-				break;
 			}
 		}
 
@@ -1710,53 +1893,20 @@ int main(int argc, char **argv) {
 
 		if (should_quit) break;
 
-		auto current_time = std::chrono::high_resolution_clock::now();
-		static auto previous_time = current_time;
-		float elapsed = std::chrono::duration< float >(current_time - previous_time).count();
-		previous_time = current_time;
-
-		auto check_visibility = [&player](Light &light) {
-			//will have this loop through all lights
-			if (!light.light_on)
-				return false;
-
-			glm::vec2 A = light.vectors[0];
-			glm::vec2 B = light.vectors[1];
-			glm::vec2 C = light.vectors[2];
-
-			glm::vec2 v0 = C - A;
-			glm::vec2 v1 = B - A;
-			glm::vec2 v2 = player.pos - A;
-
-			// Compute dot products
-			float dot00 = dot(v0, v0);
-			float dot01 = dot(v0, v1);
-			float dot02 = dot(v0, v2);
-			float dot11 = dot(v1, v1);
-			float dot12 = dot(v1, v2);
-
-			// Compute barycentric coordinates
-			float invDenom = 1.0f / (dot00 * dot11 - dot01 * dot01);
-			float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
-			float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
-
-			// Check if point is in triangle
-			//return (u >= 0) && (v >= 0) && (u + v < 1)
-			if ((u >= 0.0f) && (v >= 0.0f) && (u + v < 1.0f))
-				return true;
-			return false;
-		};
+		frame_allocs.phase("update");
+
+		float const elapsed = tick_seconds;
 
 		if (!player.aiming) { //update game state:
 			bool isVisible = false;
 			//check if player is in light
 			for (Light& light : Vector_Lights) {
-				light.rotate();
-				isVisible = isVisible || check_visibility(light);
+				light.update();
+				isVisible = isVisible || light.contains(player.pos);
 			}
 			for (Enemy& enemy : Vector_Enemies) {
-				enemy.flashlight.rotate();
-				isVisible = isVisible || check_visibility(enemy.flashlight);
+				enemy.flashlight.update();
+				isVisible = isVisible || enemy.flashlight.contains(player.pos);
 			}
 			if ((!player.behind_door) && (isVisible)) {
 				player.visible = true;
@@ -1810,249 +1960,228 @@ int main(int argc, char **argv) {
 				camera.pos.x = level_end - 6.0f;
 			}
 
+			//stream level chunks around the camera's new position
+			if (!in_menu) {
+				stream_level();
+			}
+
 			//have the camera vertically follow the player (for level 1)
 			//camera.pos.y = 2.5f + (player.pos.y - 1.0f);
 
 			//enemy update --------------------------------------------------------------
-			int counter = 0;
-			for (Enemy& enemies : Vector_Enemies) {
-				counter += 1;
-				if (!enemies.alerted) {
-					if (!enemies.walking) {
-						enemies.remaining_wait -= elapsed;
-						if (enemies.remaining_wait <= 0.0f) {
-							enemies.walking = true;
-							enemies.face_right = !enemies.face_right;
-							enemies.curr_index = (enemies.curr_index + 1) % 2;
-							if (enemies.face_right) {
-								enemies.vel.x = 1.0f;
-							} else {
-								enemies.vel.x = -1.0f;
+			//enemies only write to themselves here; effects on shared state are
+			//collected in flags and applied once all chunks have joined
+			std::atomic< bool > enemy_spotted_player(false);
+			std::atomic< bool > enemy_caught_player(false);
+			jobs.parallel_for(uint32_t(Vector_Enemies.size()), 256, [&](uint32_t begin, uint32_t end) {
+				for (uint32_t e = begin; e < end; ++e) {
+					Enemy &enemies = Vector_Enemies[e];
+					if (!enemies.alerted) {
+						if (!enemies.walking) {
+							enemies.remaining_wait -= elapsed;
+							if (enemies.remaining_wait <= 0.0f) {
+								enemies.walking = true;
+								enemies.face_right = !enemies.face_right;
+								enemies.curr_index = (enemies.curr_index + 1) % 2;
+								if (enemies.face_right) {
+									enemies.vel.x = 1.0f;
+								} else {
+									enemies.vel.x = -1.0f;
+								}
+							}
+						} else {
+							enemies.pos += enemies.vel * elapsed;
+							if ((enemies.face_right && enemies.pos.x > enemies.waypoints[enemies.curr_index].x) ||
+									(!enemies.face_right && enemies.pos.x < enemies.waypoints[enemies.curr_index].x)) {
+								enemies.face_right = enemies.waypoints[enemies.curr_index].x > 
+									enemies.waypoints[(enemies.curr_index + 1) % 2].x;
+								enemies.pos = enemies.waypoints[enemies.curr_index];
+								enemies.remaining_wait = enemies.wait_timers[enemies.curr_index];
+								enemies.walking = false;
+								enemies.vel.x = 0.0f;
+								enemies.update_pos();
 							}
 						}
 					} else {
-						enemies.pos += enemies.vel * elapsed;
-						if ((enemies.face_right && enemies.pos.x > enemies.waypoints[enemies.curr_index].x) ||
-								(!enemies.face_right && enemies.pos.x < enemies.waypoints[enemies.curr_index].x)) {
-							enemies.face_right = enemies.waypoints[enemies.curr_index].x > 
-								enemies.waypoints[(enemies.curr_index + 1) % 2].x;
-							enemies.pos = enemies.waypoints[enemies.curr_index];
-							enemies.remaining_wait = enemies.wait_timers[enemies.curr_index];
-							enemies.walking = false;
-							enemies.vel.x = 0.0f;
-							enemies.update_pos();
+						if (!enemies.walking) {
+							enemies.remaining_wait -= elapsed;
+							if (enemies.remaining_wait <= 0.0f) {
+								enemies.alerted = false;
+								enemies.walking = true;
+								enemies.face_right = (enemies.waypoints[enemies.curr_index].x > enemies.pos.x);
+								if (enemies.face_right) {
+									enemies.vel.x = 1.0f;
+								} else {
+									enemies.vel.x = -1.0f;
+								}
+							}
+						} else {
+							enemies.pos += enemies.vel * elapsed;
+							if ((enemies.face_right && enemies.pos.x > enemies.target.x) ||
+									(!enemies.face_right && enemies.pos.x < enemies.target.x)) {
+								enemies.pos.x = enemies.target.x;
+								enemies.remaining_wait = 10.0f;
+								enemies.walking = false;
+								enemies.vel.x = 0.0f;
+							}
 						}
 					}
-				} else {
-					if (!enemies.walking) {
-						enemies.remaining_wait -= elapsed;
-						if (enemies.remaining_wait <= 0.0f) {
-							enemies.alerted = false;
-							enemies.walking = true;
-							enemies.face_right = (enemies.waypoints[enemies.curr_index].x > enemies.pos.x);
-							if (enemies.face_right) {
-								enemies.vel.x = 1.0f;
-							} else {
-								enemies.vel.x = -1.0f;
+
+					if (player.visible && !player.behind_door) {
+						if (enemies.face_right) {
+							if (enemies.pos.x <= player.pos.x && enemies.pos.x + enemies.sight_range >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
+								enemy_spotted_player = true;
+								enemies.target = player.pos;
+								enemies.vel.x = 2.5f;
+								enemies.alerted = true;
+								enemies.walking = true;
+							}
+						} else {
+							if (enemies.pos.x - enemies.sight_range <= player.pos.x && enemies.pos.x >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
+								enemy_spotted_player = true;
+								enemies.target = player.pos;
+								enemies.vel.x = -2.5f;
+								enemies.alerted = true;
+								enemies.walking = true;
 							}
-						}
-					} else {
-						enemies.pos += enemies.vel * elapsed;
-						if ((enemies.face_right && enemies.pos.x > enemies.target.x) ||
-								(!enemies.face_right && enemies.pos.x < enemies.target.x)) {
-							enemies.pos.x = enemies.target.x;
-							enemies.remaining_wait = 10.0f;
-							enemies.walking = false;
-							enemies.vel.x = 0.0f;
 						}
 					}
-				}
 
-				if (player.visible && !player.behind_door) {
-					if (enemies.face_right) {
-						if (enemies.pos.x <= player.pos.x && enemies.pos.x + enemies.sight_range >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
-							SDL_PauseAudioDevice(alertAudioDevice, 0);
-							enemies.target = player.pos;
-							enemies.vel.x = 2.5f;
-							enemies.alerted = true;
-							enemies.walking = true;
-						}
-					} else {
-						if (enemies.pos.x - enemies.sight_range <= player.pos.x && enemies.pos.x >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
-							SDL_PauseAudioDevice(alertAudioDevice, 0);
-							enemies.target = player.pos;
-							enemies.vel.x = -2.5f;
-							enemies.alerted = true;
-							enemies.walking = true;
+					if (!player.behind_door) {
+						if (enemies.face_right) {
+							if (enemies.pos.x <= player.pos.x && enemies.pos.x + enemies.catch_range >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
+								enemy_caught_player = true;
+							}
+						} else {
+							if (enemies.pos.x - enemies.catch_range <= player.pos.x && enemies.pos.x >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
+								enemy_caught_player = true;
+							}
 						}
 					}
 				}
+			});
 
-				if (!player.behind_door) {
-
-					if (enemies.face_right) {
-						if (enemies.pos.x <= player.pos.x && enemies.pos.x + enemies.catch_range >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
-							// should_quit = true;
-
-							//player was caught restart the level
-							player.pos = default_player_pos;
-							player.vel = default_player_vel;
-
-							on_platform = false;
-							on_ladder = false;
-							check_on_ladder = false;
-
-							player.face_right = false;
-							player.jumping = false;
-							player.shifting = false;
-							player.behind_door = false;
-							player.aiming = false;
-							player.visible = false; 
-
-							player.num_projectiles = 9;
-
-							Vector_Platforms = {};
-							Vector_Doors = {};
-							Vector_Lights = {};
-							Vector_Enemies = {};
-							Vector_Ladders = {};
-
-							loadLevel(level,
-									reinterpret_cast<void*>(&Vector_Platforms),
-									reinterpret_cast<void*>(&Vector_Doors),
-									reinterpret_cast<void*>(&Vector_Lights),
-									reinterpret_cast<void*>(&Vector_Enemies),
-									reinterpret_cast<void*>(&Vector_Ladders));
-						}
-					} else {
-						if (enemies.pos.x - enemies.catch_range <= player.pos.x && enemies.pos.x >= player.pos.x && (abs(enemies.pos.y - player.pos.y) <= 0.5f)) {
-							// should_quit = true;
-
-							// printf("made it to checkpoint 1\n");
-							caught = true;
-
-							//player was caught restart the level
-							player.pos = default_player_pos;
-							player.vel = default_player_vel;
-
-							on_platform = false;
-							on_ladder = false;
-							check_on_ladder = false;
-
-							player.face_right = false;
-							player.jumping = false;
-							player.shifting = false;
-							player.behind_door = false;
-							player.aiming = false;
-							player.visible = false; 
-
-							player.num_projectiles = 9;
-
-							Vector_Platforms = {};
-							Vector_Doors = {};
-							Vector_Lights = {};
-							Vector_Enemies = {};
-							Vector_Ladders = {};
-
-							// printf("made it to checkpoint 2\n");
+			if (enemy_spotted_player) {
+				SDL_PauseAudioDevice(alertAudioDevice, 0);
+			}
 
-							loadLevel(level,
-									reinterpret_cast<void*>(&Vector_Platforms),
-									reinterpret_cast<void*>(&Vector_Doors),
-									reinterpret_cast<void*>(&Vector_Lights),
-									reinterpret_cast<void*>(&Vector_Enemies),
-									reinterpret_cast<void*>(&Vector_Ladders));
+			if (enemy_caught_player) {
+				// should_quit = true;
+				caught = true;
+				world_events.push_back(WorldEvent{WORLD_CAUGHT, level});
+			}
 
-							// printf("made it to checkpoint 3\n");
-						}
-					}
+			//emit noises ----------------------------------------------------------------
+			noises.clear();
+			if (!player.jumping && !player.behind_door) {
+				glm::vec2 feet = glm::vec2(player.pos.x, player.pos.y - 0.5f * player.size.y);
+				if (player.vel.x == 1.0f || player.vel.x == -1.0f) {
+					noises.push_back(NoiseEvent{NoiseWalk, feet, 0.5f * player.walk_sound});
+				} else if (player.vel.x == 2.0f || player.vel.x == -2.0f) {
+					noises.push_back(NoiseEvent{NoiseRun, feet, 0.5f * player.run_sound});
+				}
+			}
+			if (mouse.remaining_time == 1.0f) {
+				for (glm::vec2 const &landed : player.projectiles_pos) {
+					noises.push_back(NoiseEvent{NoiseThrow, landed, 0.5f * player.throw_sound});
 				}
 			}
 
-			//detect footsteps
-			for (Enemy& enemy : Vector_Enemies) {
-				float h_diff = enemy.pos.x - player.pos.x;
-				float v_diff = (enemy.pos.y + 0.35f * enemy.size.y) - (player.pos.y - 0.5f * player.size.y);
-				float sound = 0.0f;
-				if ((player.vel.x == 1.0f || player.vel.x == -1.0f) && !player.jumping && !player.behind_door) {
-					sound = 0.5f * player.walk_sound;
-					SDL_PauseAudioDevice(stepDevice, 0);
-				} else if ((player.vel.x == 2.0f || player.vel.x == -2.0f) && !player.jumping && !player.behind_door) {
-					sound = 0.5f * player.run_sound;
-					SDL_PauseAudioDevice(stepDevice, 0);
+			// propagate noises to enemies and lights --------------------------------------
+			if (!noises.empty()) {
+				enemy_ears.points.clear();
+				for (Enemy& enemy : Vector_Enemies) {
+					enemy_ears.points.emplace_back(enemy.pos.x, enemy.pos.y + 0.35f * enemy.size.y);
 				}
+				enemy_ears.build();
 
-				if (sqrt(h_diff * h_diff + v_diff * v_diff) <= sound) {
-					if (player.pos.x > enemy.pos.x) {
-						enemy.target = (player.pos + enemy.pos)/2.0f;
-						enemy.vel.x = 2.5f;
-						enemy.alerted = true;
-						enemy.walking = true;
-						enemy.face_right = true;
-					} else {
-						enemy.target = (player.pos + enemy.pos)/2.0f;
-						enemy.vel.x = -2.5f;
-						enemy.alerted = true;
-						enemy.walking = true;
-						enemy.face_right = false;
+				bool thrown = false;
+				for (NoiseEvent const &noise : noises) {
+					thrown = thrown || noise.kind == NoiseThrow;
+				}
+				if (thrown) {
+					light_bulbs.points.clear();
+					for (Light& light : Vector_Lights) {
+						light_bulbs.points.emplace_back(light.pos.x, light.pos.y + 0.5f * light.size.y);
 					}
+					light_bulbs.build();
 				}
 			}
 
-			// projectile update ----------------------------------------------------------------
-			if (mouse.remaining_time == 1.0f) {
-				for (auto i = player.projectiles_pos.begin(); i != player.projectiles_pos.end() ; ++i) {
-
-					for (Enemy& enemy : Vector_Enemies) {
-						//enemies
-						float h_diff = enemy.pos.x - i->x;
-						float v_diff = (enemy.pos.y + 0.35f * enemy.size.y) - i->y;
-						if (sqrt(h_diff*h_diff + v_diff*v_diff) <= 0.5f * player.throw_sound) {
-							if (i->x > enemy.pos.x) {
-								enemy.target = *i;
-								enemy.vel.x = 2.5f;
-								enemy.alerted = true;
-								enemy.walking = true;
-								enemy.face_right = true;
-							} else {
-								enemy.target = *i;
-								enemy.vel.x = -2.5f;
-								enemy.alerted = true;
-								enemy.walking = true;
-								enemy.face_right = false;
-							}
-						}
-					}
+			for (NoiseEvent const &noise : noises) {
+				if (noise.kind == NoiseWalk || noise.kind == NoiseRun) {
+					SDL_PauseAudioDevice(stepDevice, 0);
+				}
 
-					//lights
-					for (Light& light : Vector_Lights) {
-						float h_diff = light.pos.x - i->x;
-						float v_diff = light.pos.y + 0.5f * light.size.y - i->y;
-						if (sqrt(h_diff*h_diff + v_diff*v_diff) <= 1.5f) {
-							light.light_on = false;
-						}
-					}
-				}       
+				//footsteps lead the enemy halfway to the player, thrown ornaments to where they landed
+				glm::vec2 source = (noise.kind == NoiseThrow ? noise.pos : player.pos);
+				enemy_ears.query(noise.pos, noise.radius, [&](uint32_t index) {
+					Enemy &enemy = Vector_Enemies[index];
+					enemy.target = (noise.kind == NoiseThrow ? noise.pos : (player.pos + enemy.pos) / 2.0f);
+					enemy.face_right = source.x > enemy.pos.x;
+					enemy.vel.x = (enemy.face_right ? 2.5f : -2.5f);
+					enemy.alerted = true;
+					enemy.walking = true;
+				});
+
+				if (noise.kind == NoiseThrow) {
+					//ornaments that land close enough to a lamp smash it
+					light_bulbs.query(noise.pos, 1.5f, [&](uint32_t index) {
+						Vector_Lights[index].light_on = false;
+					});
+				}
 			}
-
+			//moving enemies drag their flashlight along (marks it dirty only if it moved)
 			for (Enemy& enemy : Vector_Enemies) {
-				if (enemy.vel.x > 0.0f) {
-					enemy.flashlight.dir = 0.0f;
+				if (enemy.vel.x != 0.0f) {
 					enemy.update_pos();
-					//rotate_light(enemy.flashlight);
-				} else if (enemy.vel.x < 0.0f) {
-					enemy.flashlight.dir = PI;
-					enemy.update_pos();
-					//rotate_light(enemy.flashlight);
 				}
 			}
 
 			//level win -----------------------------------------------------------
 			if (player.pos.x >= level_end) {
-				/* go on to the next level (currently goes to level 1) */
+				world_events.push_back(WorldEvent{WORLD_LEVEL_COMPLETE, level});
+			}
+
+		}
+
+		//apply world events -----------------------------------------------------
+		//only the most drastic outcome of the tick is applied (menu > level load > win > caught)
+		frame_allocs.phase("world events");
+		if (!world_events.empty()) {
+			WorldEvent event = world_events[0];
+			for (WorldEvent const &e : world_events) {
+				if (e.type < event.type) event = e;
+			}
+			world_events.clear();
+
+			//loading (or dropping) a level allocates on purpose:
+			if (event.type != WORLD_CAUGHT) {
+				frame_allocs.excuse_frame();
+			}
+
+			if (event.type == WORLD_RETURN_TO_MENU) {
+				//go to menu
+				in_menu = true;
+				in_level_select = false;
+				play_highlighted = true;
+
+				reset_player();
 
+				//we set player behind door as a hack to "remove" player while we're in the main menu
+				player.behind_door = true;
 
+				//reset to level 0 just in case (shouldn't matter though)
+				level = 0;
 
+				release_level();
+			} else if (event.type == WORLD_START_LEVEL) {
+				//exit main menu and level select
+				in_menu = false;
+				in_level_select = false;
+
+				enter_level(event.level);
+			} else if (event.type == WORLD_LEVEL_COMPLETE) {
 				//record the completed level
 				if (completed_levels < level) {
 					completed_levels = level;
@@ -2065,46 +2194,16 @@ int main(int argc, char **argv) {
 					}
 				}
 
-				//reset player statuses
-				player.pos = default_player_pos;
-				player.vel = default_player_vel;
-
-				on_platform = false;
-				on_ladder = false;
-				check_on_ladder = false;
-
-				player.face_right = false;
-				player.jumping = false;
-				player.shifting = false;
-				player.behind_door = false;
-				player.aiming = false;
-				player.visible = false; 
-
-				player.num_projectiles = 9;
-
-				level += 1;
-
 				//if the player beats the fifth level, cycle around to the starting level
-				level = level % 5;
-
-				Vector_Platforms = {};
-				Vector_Doors = {};
-				Vector_Lights = {};
-				Vector_Enemies = {};
-				Vector_Ladders = {};
-
-				loadLevel(level,
-						reinterpret_cast<void*>(&Vector_Platforms),
-						reinterpret_cast<void*>(&Vector_Doors),
-						reinterpret_cast<void*>(&Vector_Lights),
-						reinterpret_cast<void*>(&Vector_Enemies),
-						reinterpret_cast<void*>(&Vector_Ladders));
-				//should_quit = true;
+				enter_level((level + 1) % 5);
+			} else if (event.type == WORLD_CAUGHT) {
+				//player was caught restart the level (from the chunks kept at load time)
+				restart_level();
 			}
-
 		}
 
 		//Audio Stuff
+		frame_allocs.phase("audio");
 		if (alertData.length == 0) {
 			SDL_PauseAudioDevice(alertAudioDevice, 1);
 			alertData.pos = alertData.init_pos;
@@ -2136,58 +2235,72 @@ int main(int argc, char **argv) {
 		}
 
 
-		//draw output:
+		//draw output (into a snapshot for the render thread):
+		frame_allocs.phase("draw");
+		RenderSnapshot &snapshot = snapshots.back();
 		//glClearColor(231.0 / 255, 125.0 / 255.0, 65.0 / 255.0, 1.0);
 		if (in_menu) {
-			glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+			snapshot.clear_color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 		} else {
-			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			snapshot.clear_color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 		}
-		glClear(GL_COLOR_BUFFER_BIT);
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+#ifdef COMPACT_VERTICES
+		snapshot.sprite_origin = camera.pos; //(keeps the 16-bit positions in range)
+#else
+		snapshot.sprite_origin = glm::vec2(0.0f);
+#endif
 
 		{ //draw game state:
-			std::vector< Vertex > verts;
-			std::vector< Vertex > tri_verts;
+			render_queue.clear();
+			sprite_records.clear();
+			sprite_verts.clear();
+			cone_verts.clear();
+			glm::vec2 const sprite_origin = snapshot.sprite_origin;
+			//layer of the sprites drawn next (set before each group below):
+			uint32_t layer = LayerDoors;
 
 
 			//---- Functions ----
-			auto draw_sprite = [&verts, &in_menu](SpriteInfo const &sprite, glm::vec2 const &at, glm::vec2 size, glm::u8vec4 tint = glm::u8vec4(0x34, 0x4c, 0x73, 0x88), float angle = 0.0f) {
-				glm::vec2 min_uv = sprite.min_uv;
-				glm::vec2 max_uv = sprite.max_uv;
-				glm::vec2 right = glm::vec2(std::cos(angle), std::sin(angle));
-				glm::vec2 up = glm::vec2(-right.y, right.x);
-
+			auto draw_sprite = [&render_queue, &sprite_records, &layer, &in_menu, sprite_origin](SpriteInfo const &sprite, glm::vec2 const &at, glm::vec2 size, glm::u8vec4 tint = glm::u8vec4(0x34, 0x4c, 0x73, 0x88), float angle = 0.0f) {
 				if (tint.x == 0x34 && in_menu)
 					tint = glm::u8vec4(0xff, 0xff, 0xff, 0xff);
 
-				verts.emplace_back(at + right * -size.x/2.0f + up * -size.y/2.0f, glm::vec2(min_uv.x, min_uv.y), tint);
-				verts.emplace_back(verts.back());
-				verts.emplace_back(at + right * -size.x/2.0f + up * size.y/2.0f, glm::vec2(min_uv.x, max_uv.y), tint);
-				verts.emplace_back(at + right *  size.x/2.0f + up * -size.y/2.0f, glm::vec2(max_uv.x, min_uv.y), tint);
-				verts.emplace_back(at + right *  size.x/2.0f + up *  size.y/2.0f, glm::vec2(max_uv.x, max_uv.y), tint);
-				verts.emplace_back(verts.back());
+				//(vertices are made for all the frame's sprites at once, by emit_sprites below)
+				SpriteRecord record{ at - sprite_origin, size, sprite.inset_min, sprite.inset_max, sprite.min_uv, sprite.max_uv, tint, angle };
+				size_t first = sprite_records.size();
+				if (sprite_in_range(record)) {
+					sprite_records.emplace_back(record);
+				} else {
+					//e.g., a floor merged across chunks -- too long for compact vertex positions:
+					split_sprite(record, &sprite_records);
+				}
+				for (size_t i = first; i < sprite_records.size(); ++i) {
+					render_queue.push(RenderQueue::key(layer, MaterialSprite, sprite.page), uint32_t(i));
+				}
 			};
 
-			//helper: add character to game
-			auto draw_triangle = [&tri_verts](glm::vec2 vec1, glm::vec2 vec2, glm::vec2 vec3, glm::vec2 const &rad, glm::u8vec4 const &tint) {
-				tri_verts.emplace_back(vec1, glm::vec2(0.0f, 0.0f), tint);
-				tri_verts.emplace_back(tri_verts.back());
-				tri_verts.emplace_back(vec2, glm::vec2(0.0f, 1.0f), tint);
-				tri_verts.emplace_back(vec3, glm::vec2(1.0f, 0.0f), tint);
-				// tri_verts.emplace_back(at + glm::vec2( rad.x, rad.y), glm::vec2(1.0f, 1.0f), tint);
-				tri_verts.emplace_back(tri_verts.back());
+			//helper: add a light's cone (apex first) as a strip-joined triangle
+			auto draw_cone = [&render_queue, &cone_verts](Light const &light) {
+				render_queue.push(RenderQueue::key(LayerLights, MaterialCone, 0), uint32_t(cone_verts.size() / 5));
+				float soft = light.softness;
+				cone_verts.emplace_back(light.vectors[0], glm::vec3(0.0f, 0.0f, soft), light.color);
+				cone_verts.emplace_back(cone_verts.back());
+				cone_verts.emplace_back(light.vectors[1], glm::vec3(1.0f,-1.0f, soft), light.color);
+				cone_verts.emplace_back(light.vectors[2], glm::vec3(1.0f, 1.0f, soft), light.color);
+				cone_verts.emplace_back(cone_verts.back());
 			};
 
 			//------------- Draw Objects -------------
 
 			//draw doors ------------------------------------------------------------------
+			layer = LayerDoors;
 			for (Door& door : Vector_Doors){
 				draw_sprite(door.sprite_empty, door.pos, door.size);
 			}
 
 			//draw ladders ------------------------------------------------------------------
+			layer = LayerLadders;
 			for (Ladder& ladder : Vector_Ladders){
 				draw_sprite(ladder.sprite_empty, ladder.pos, ladder.size);
 			}
@@ -2197,6 +2310,7 @@ int main(int argc, char **argv) {
 			}
 
 			//draw player -----------------------------------------------------------
+			layer = LayerPlayer;
 			glm::vec2 player_size = player.size;
 			if (!player.face_right) {
 				player_size.x *= -1.0f;
@@ -2217,6 +2331,7 @@ int main(int argc, char **argv) {
 			}
 
 			//draw enemies -----------------------------------------------------------
+			layer = LayerEnemies;
 			for (Enemy& enemy : Vector_Enemies){
 				glm::vec2 enemy_size = enemy.size;
 				if (enemy.face_right) {
@@ -2260,8 +2375,8 @@ int main(int argc, char **argv) {
 
 				//draw flashlights --------------------------------------------------------------
 				if (enemy.flashlight.light_on) {
-					draw_triangle(enemy.flashlight.vectors[0], enemy.flashlight.vectors[1], enemy.flashlight.vectors[2], 
-							glm::vec2(1.0f), glm::u8vec4(0xff, 0xff, 0xff, 0x88));
+					enemy.flashlight.update();
+					draw_cone(enemy.flashlight);
 				}
 
 				if (caught == true){
@@ -2272,13 +2387,14 @@ int main(int argc, char **argv) {
 		//draw stage lights
 		for (Light& light : Vector_Lights) {
 			if (light.light_on) {
+				light.update();
 				//printf("drawing triangles: (%f,%f), (%f,%f)\n", light.pos.x, light.pos.y, light.size.x, light.size.y);
-				draw_triangle(light.vectors[0], light.vectors[1], light.vectors[2], 
-						glm::vec2(1.0f), glm::u8vec4(0xff, 0xff, 0xff, 0x88));
+				draw_cone(light);
 			}
 		}
 
 		// Draw tutorial hints
+		layer = LayerHints;
 		if (level == 0 && !in_menu) {
 			draw_sprite(bg.hints[0], glm::vec2(1.0f, 2.5f), glm::vec2(0.8f, 0.8f), glm::u8vec4(0xff,0xff,0xff,0xff));
 			draw_sprite(bg.hints[1], glm::vec2(2.5f, 2.5f), glm::vec2(0.8f, 0.8f), glm::u8vec4(0xff,0xff,0xff,0xff));
@@ -2293,6 +2409,7 @@ int main(int argc, char **argv) {
 		}
 
 		//draw menu options --------------------------------------------------------
+		layer = LayerMenus;
 		//at the moment, we use triangles for buttons
 		if (in_menu){
 			//determine whether to be on the main select screen or the level select screen
@@ -2341,11 +2458,13 @@ int main(int argc, char **argv) {
 		}
 
 		//draw platforms -----------------------------------------------------------
+		layer = LayerPlatforms;
 		for (Platform& platform : Vector_Platforms){
 			draw_sprite(platform.sprite, platform.pos, platform.size);
 		}
 
 		//draw sounds ---------------------------------------------------------------
+		layer = LayerSounds;
 		if (!player.aiming && mouse.remaining_time > 0.0f) {
 			mouse.remaining_time -= elapsed;
 			for (auto i = player.projectiles_pos.begin(); i != player.projectiles_pos.end(); ++i) {
@@ -2436,52 +2555,99 @@ int main(int argc, char **argv) {
 			draw_sprite(mouse.sprite_throw, glm::vec2(player.pos.x, player.pos.y - 0.5 * player.size.y), glm::vec2(sound * (1.0f - player.sound_time)));
 		}
 
+		layer = LayerUI;
 if (!in_level_select && !in_menu) {
 		draw_sprite(player.numbers[player.num_projectiles], camera.pos - glm::vec2(5.5f, 3.25f), glm::vec2(0.75f,0.75f), glm::u8vec4(0xff, 0xff, 0xff, 0xff));
 }
 
 		//-----------------------------------------------------------------------
 
-		glBindBuffer(GL_ARRAY_BUFFER, buffer);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * verts.size(), &verts[0], GL_STREAM_DRAW);
-
-		glUseProgram(program);
-		glUniform1i(program_tex, 0);
-		glm::vec2 scale = 2.0f / camera.size;
-		glm::vec2 offset = scale * -camera.pos;
-		glm::mat4 mvp = glm::mat4(
-				glm::vec4(scale.x, 0.0f, 0.0f, 0.0f),
-				glm::vec4(0.0f, scale.y, 0.0f, 0.0f),
-				glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
-				glm::vec4(offset.x, offset.y, 0.0f, 1.0f)
-				);
-		glUniformMatrix4fv(program_mvp, 1, GL_FALSE, glm::value_ptr(mvp));
-
-		glBindTexture(GL_TEXTURE_2D, tex);
-		glBindVertexArray(vao);
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, verts.size());
-		//glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-		// glDisable(GL_TEXTURE_2D);
-
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * tri_verts.size(), &tri_verts[0], GL_STREAM_DRAW);
-
-		glBindTexture(GL_TEXTURE_2D, tex2);
+		//make the sprites' vertices, then put the vertices in key order and cut them
+		//into draws, a new one whenever the material or texture changes:
+		emit_sprites(sprite_records.data(), sprite_records.size(), &sprite_verts);
+		render_queue.sort();
+		snapshot.sprite_verts.clear();
+		snapshot.cone_verts.clear();
+		snapshot.batches.clear();
+		for (auto const &command : render_queue.commands) {
+			uint32_t material = RenderQueue::material(command.key);
+			uint32_t texture = RenderQueue::texture(command.key);
+			GLint first = GLint(material == MaterialCone ? snapshot.cone_verts.size() : snapshot.sprite_verts.size());
+			if (snapshot.batches.empty() || snapshot.batches.back().material != material || snapshot.batches.back().texture != texture) {
+				snapshot.batches.emplace_back(DrawBatch{ material, texture, first, 0 });
+			}
+			//(every sprite and cone starts and ends on a repeated vertex, so any run of them is one strip)
+			if (material == MaterialCone) {
+				auto from = cone_verts.begin() + command.payload * 5;
+				snapshot.cone_verts.insert(snapshot.cone_verts.end(), from, from + 5);
+				snapshot.batches.back().count += 5;
+			} else {
+				auto from = sprite_verts.begin() + command.payload * 6;
+				snapshot.sprite_verts.insert(snapshot.sprite_verts.end(), from, from + 6);
+				snapshot.batches.back().count += 6;
+			}
+		}
+	}
 
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, tri_verts.size());
+	snapshot.tick = tick;
+	snapshot.camera = camera;
+	snapshot.has_input = input_pending;
+	snapshot.input_time = input_time;
+	snapshot.input_tick = input_tick;
+	uint64_t hash = snapshot_hash(snapshot);
+	if (redraw || hash != sent_hash) {
+		snapshots.publish();
+		sent_hash = hash;
+		redraw = false;
+		still_ticks = 0;
+		usage_sent += 1;
+	} else {
+		still_ticks += 1;
+		input_pending = false; //(whatever input came in changed nothing on screen)
+	}
+	sim_ticks.store(tick);
+	frame_allocs.end_frame();
+
+	usage_ticks += 1;
+	auto now = std::chrono::steady_clock::now();
+	if (cpu_usage && now - usage_start >= std::chrono::seconds(60)) {
+		std::clock_t cpu = std::clock();
+		float wall = std::chrono::duration< float >(now - usage_start).count();
+		float cpu_ms = 1000.0f * float(cpu - usage_cpu_start) / CLOCKS_PER_SEC;
+		printf("cpu usage: %.0f ms of CPU time per minute (%.1f%% of one core); %u ticks, %u pictures sent, %u idle waits\n",
+			cpu_ms * 60.0f / wall, cpu_ms / (10.0f * wall), usage_ticks, usage_sent, usage_idle_waits);
+		usage_start = now;
+		usage_cpu_start = cpu;
+		usage_ticks = usage_sent = usage_idle_waits = 0;
 	}
 
-	SDL_GL_SwapWindow(window);
+	if ((in_menu || player.aiming) && still_ticks >= idle_after_ticks && alloc_check_frames == 0) {
+		//idle: nothing to do until something happens
+		SDL_WaitEventTimeout(nullptr, idle_timeout_ms);
+		usage_idle_waits += 1;
+		next_tick = std::chrono::steady_clock::now();
+	} else {
+		//wait for the next tick (when behind, run it right away; when too far behind, e.g.
+		//after a stall, drop the missed time rather than run a burst of ticks):
+		next_tick += tick_period;
+		if (now - next_tick > max_lag) {
+			next_tick = now;
+		} else if (next_tick > now) {
+			std::this_thread::sleep_until(next_tick);
+		}
+	}
 }
 
+snapshots.close();
+render_thread.join();
+SDL_GL_MakeCurrent(window, context);
+
 
 //------------  teardown ------------
 
 //Close the audio devices
 SDL_CloseAudioDevice(audioDevice);
 SDL_CloseAudioDevice(alertAudioDevice);
-SDL_FreeWAV(wavStart);
 
 SDL_GL_DeleteContext(context);
 context = 0;
@@ -2491,50 +2657,94 @@ window = NULL;
 
 SDL_Quit();
 
+if (alloc_check_frames != 0) {
+	std::cout << "alloc check: " << frame_allocs.failed_frames << " of " << frame_allocs.frame
+		<< " simulation tick(s) and " << render_allocs.failed_frames << " of " << render_allocs.frame
+		<< " rendered frame(s) allocated after the first " << frame_allocs.warmup_frames << "." << std::endl;
+	if (frame_allocs.failed_frames != 0 || render_allocs.failed_frames != 0) return 1;
+}
+
 return 0;
 }
 
 
-static GLuint compile_shader(GLenum type, std::string const &source) {
-	GLuint shader = glCreateShader(type);
-	GLchar const *str = source.c_str();
-	GLint length = source.size();
-	glShaderSource(shader, 1, &str, &length);
-	glCompileShader(shader);
-	GLint compile_status = GL_FALSE;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &compile_status);
-	if (compile_status != GL_TRUE) {
-		std::cerr << "Failed to compile shader." << std::endl;
-		GLint info_log_length = 0;
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &info_log_length);
-		std::vector< GLchar > info_log(info_log_length, 0);
-		GLsizei length = 0;
-		glGetShaderInfoLog(shader, info_log.size(), &length, &info_log[0]);
-		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
-		glDeleteShader(shader);
-		throw std::runtime_error("Failed to compile shader.");
+//The format to open an audio device with to play 'clip' as is:
+static SDL_AudioSpec clip_spec(WavClip const &clip) {
+	SDL_AudioSpec spec;
+	SDL_zero(spec);
+	spec.freq = int(clip.rate);
+	if (clip.encoding == WavClip::Float) {
+		spec.format = AUDIO_F32LSB;
+	} else if (clip.bits == 8) {
+		spec.format = AUDIO_U8;
+	} else if (clip.bits == 16) {
+		spec.format = AUDIO_S16LSB;
+	} else {
+		spec.format = AUDIO_S32LSB;
+	}
+	spec.channels = Uint8(clip.channels);
+	spec.samples = 4096; //as SDL_LoadWAV
+	return spec;
+}
+
+//Read atlas page 'page' into 'data' (no GL calls, so any thread may do this):
+//its .ctex copy if 'try_compressed' and there is a usable one, else the png, premultiplied and mipmapped.
+static bool load_atlas_page(AtlasPage const &page, bool try_compressed, JobSystem *jobs, AtlasPageData *data) {
+	*data = AtlasPageData();
+
+	//prefer the compressed copy made by compress_texture (it carries its own mip chain):
+	std::string png_file = page.file;
+	std::string ctex_file = png_file.substr(0, png_file.rfind('.')) + ".ctex";
+	if (try_compressed && load_compressed_texture(ctex_file, &data->compressed) && !data->compressed.levels.empty()) {
+		CompressedTexture const &texture = data->compressed;
+		if (texture.format == BlockBC3 && !texture.premultiplied) {
+			std::cerr << "NOTE: ignoring '" << ctex_file << "', its alpha is not premultiplied." << std::endl;
+		} else if (glm::uvec2(texture.levels[0].width, texture.levels[0].height) != page.size) {
+			std::cerr << "NOTE: ignoring '" << ctex_file << "', it does not match its source image." << std::endl;
+		} else {
+			data->loaded = true;
+			return true;
+		}
+	}
+	data->compressed = CompressedTexture();
+
+	MipLevel top;
+	if (!load_png(png_file, &top.width, &top.height, &top.pixels, LowerLeftOrigin)) {
+		return false;
+	}
+	if (glm::uvec2(top.width, top.height) != page.size) {
+		std::cerr << "Atlas page '" << png_file << "' does not match the size in its manifest." << std::endl;
+		return false;
 	}
-	return shader;
+	//premultiply and filter on the CPU, so every driver samples the same mips:
+	premultiply_alpha(&top.pixels, jobs);
+	build_mip_chain(std::move(top), &data->chain, jobs);
+	data->loaded = true;
+	return true;
 }
 
-static GLuint link_program(GLuint fragment_shader, GLuint vertex_shader) {
-	GLuint program = glCreateProgram();
-	glAttachShader(program, vertex_shader);
-	glAttachShader(program, fragment_shader);
-	glLinkProgram(program);
-	GLint link_status = GL_FALSE;
-	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
-	if (link_status != GL_TRUE) {
-		std::cerr << "Failed to link shader program." << std::endl;
-		GLint info_log_length = 0;
-		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &info_log_length);
-		std::vector< GLchar > info_log(info_log_length, 0);
-		GLsizei length = 0;
-		glGetProgramInfoLog(program, info_log.size(), &length, &info_log[0]);
-		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
-		throw std::runtime_error("Failed to link program");
+//Upload 'texture' (BC3 needs GL_EXT_texture_compression_s3tc) to the bound GL_TEXTURE_2D:
+static void upload_compressed_texture(CompressedTexture const &texture) {
+	GLenum internal_format = 0;
+	if (texture.format == BlockBC3) {
+		internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	} else {
+		//RGTC is core since GL 3.0:
+		internal_format = GL_COMPRESSED_RED_RGTC1;
+	}
+
+	for (uint32_t i = 0; i < texture.levels.size(); ++i) {
+		CompressedLevel const &level = texture.levels[i];
+		glCompressedTexImage2D(GL_TEXTURE_2D, i, internal_format, level.width, level.height, 0, level.data.size(), level.data.data());
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture.levels.size() - 1);
+
+	if (texture.format == BlockBC4) {
+		//single-channel: spread red to grey with opaque alpha, like the RGB png it replaces
+		GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
 	}
-	return program;
 }
 
 static void playTone(void *userData, Uint8 *stream, int streamLength) {
@@ -2555,4 +2765,11 @@ static void playTone(void *userData, Uint8 *stream, int streamLength) {
 
 	audioData->pos += length;
 	audioData->length -= length;
+
+	if (audioData->length == 0 && clip_finished_event != Uint32(-1)) {
+		SDL_Event event;
+		SDL_zero(event);
+		event.type = clip_finished_event;
+		SDL_PushEvent(&event);
+	}
 }
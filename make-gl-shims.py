@@ -1,11 +1,16 @@
 #!/usr/bin/env python3
 
 #create gl_shims.hpp by parsing everything from glcorearb.h (why not the regsistry xml, hmmmm?) and selecting only things that are core through version 3_3.
+#
+#with --counters, create gl_counters.hpp instead: a wrapper for every core (through 3.3) entry point
+#that counts and times its calls (used when building with GL_CALL_COUNTERS; see gl_call_counters.hpp).
 
 import re
+import sys
 
 protos = []
 extensions = []
+counted = [] #(version, return type, name, parameters) of every function through 3.3
 
 with open('glcorearb.h', 'r') as f:
 	in_version = None
@@ -28,6 +33,10 @@ with open('glcorearb.h', 'r') as f:
 				do_proto = False
 				do_extension = False
 		if in_version:
+			if (major,minor) <= (3,3):
+				m = re.match(r"^GLAPI (.*\S)\s*APIENTRY gl([^ ]+) \((.*)\);$", line)
+				if m != None:
+					counted.append((in_version, m.group(1), m.group(2), m.group(3)))
 			if do_proto:
 				m = re.match(r"^GLAPI ", line)
 				if m != None:
@@ -45,6 +54,58 @@ with open('glcorearb.h', 'r') as f:
 			if m != None:
 				in_version = None
 
+#name of each parameter in a parameter list (the last identifier of each):
+def parameter_names(parameters):
+	if parameters.strip() == "void":
+		return []
+	return [re.findall(r"\w+", p)[-1] for p in parameters.split(",")]
+
+def print_counters():
+	print("""#pragma once
+
+//Generated by 'make-gl-shims.py --counters > gl_counters.hpp'; do not edit.
+//
+//Every core GL entry point through 3.3, wrapped so that each call is counted and
+//timed (see gl_call_counters.hpp), and the gl* names redefined to the wrappers.
+//GL.hpp includes this after the GL prototypes when GL_CALL_COUNTERS is defined.
+
+#include "gl_call_counters.hpp"
+
+enum GLCallIndex {""")
+	for (version, result, name, parameters) in counted:
+		print("\tGLCall_" + name + ",")
+	print("""	GLCallCount
+};
+
+#ifdef GL_COUNTERS_DEFINE_NAMES
+char const *gl_call_names[GLCallCount] = {""")
+	for (version, result, name, parameters) in counted:
+		print("\t\"gl" + name + "\",")
+	print("""};
+#endif //GL_COUNTERS_DEFINE_NAMES
+""")
+	in_version = None
+	for (version, result, name, parameters) in counted:
+		if version != in_version:
+			if in_version == "GL_VERSION_3_3":
+				print("#endif")
+			print("\n// " + version + ":")
+			if version == "GL_VERSION_3_3":
+				print("#ifndef _WIN32 //(gl_shims.hpp stops at 3.2)")
+			in_version = version
+		names = ", ".join(parameter_names(parameters))
+		call = "gl" + name + "(" + names + ")"
+		if result != "void":
+			call = "return " + call
+		print("inline " + result + " counted_gl" + name + "(" + parameters + ") { GLCallTimer timer(GLCall_" + name + "); " + call + "; }")
+		print("#define gl" + name + " counted_gl" + name)
+	if in_version == "GL_VERSION_3_3":
+		print("#endif")
+
+if len(sys.argv) > 1 and sys.argv[1] == "--counters":
+	print_counters()
+	sys.exit(0)
+
 print("""#ifndef GL_SHIMS_HPP
 #define GL_SHIMS_HPP 1
 
@@ -0,0 +1,113 @@
+#include "mip_chain.hpp"
+
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//x / 255 rounded, exact for x in [0, 255 * 255]:
+static inline uint32_t div255(uint32_t x) {
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+void premultiply_alpha(std::vector< uint32_t > *pixels_, JobSystem *jobs) {
+	std::vector< uint32_t > &pixels = *pixels_;
+	auto premultiply = [&pixels](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			uint32_t px = pixels[i];
+			uint32_t a = px >> 24;
+			if (a == 0xff) continue;
+			uint32_t r = div255((px & 0xff) * a);
+			uint32_t g = div255(((px >> 8) & 0xff) * a);
+			uint32_t b = div255(((px >> 16) & 0xff) * a);
+			pixels[i] = r | (g << 8) | (b << 16) | (a << 24);
+		}
+	};
+	if (jobs) {
+		jobs->parallel_for(uint32_t(pixels.size()), 1 << 16, premultiply);
+	} else {
+		premultiply(0, uint32_t(pixels.size()));
+	}
+}
+
+//average of four packed RGBA8 texels, rounded:
+static inline uint32_t box4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+	uint32_t result = 0;
+	for (int s = 0; s < 32; s += 8) {
+		uint32_t sum = ((a >> s) & 0xff) + ((b >> s) & 0xff) + ((c >> s) & 0xff) + ((d >> s) & 0xff);
+		result |= ((sum + 2) >> 2) << s;
+	}
+	return result;
+}
+
+//one output row from two source rows (row1 may equal row0 when the source is one row tall):
+static void downsample_row(uint32_t src_width, uint32_t const *row0, uint32_t const *row1, uint32_t width, uint32_t *out) {
+	uint32_t x = 0;
+	if (src_width >= 2) {
+#ifdef __SSE2__
+		__m128i zero = _mm_setzero_si128();
+		__m128i two = _mm_set1_epi16(2);
+		//pairwise sums of four source columns -> two output texels as 16-bit channels:
+		auto pairs = [&](__m128i a, __m128i b) {
+			__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+			__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+			return _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		};
+		for (; x + 4 <= width; x += 4) {
+			__m128i a0 = _mm_loadu_si128(reinterpret_cast< __m128i const * >(row0 + 2 * x));
+			__m128i a1 = _mm_loadu_si128(reinterpret_cast< __m128i const * >(row0 + 2 * x + 4));
+			__m128i b0 = _mm_loadu_si128(reinterpret_cast< __m128i const * >(row1 + 2 * x));
+			__m128i b1 = _mm_loadu_si128(reinterpret_cast< __m128i const * >(row1 + 2 * x + 4));
+			__m128i s0 = _mm_srli_epi16(_mm_add_epi16(pairs(a0, b0), two), 2);
+			__m128i s1 = _mm_srli_epi16(_mm_add_epi16(pairs(a1, b1), two), 2);
+			_mm_storeu_si128(reinterpret_cast< __m128i * >(out + x), _mm_packus_epi16(s0, s1));
+		}
+#endif
+		for (; x < width; ++x) {
+			out[x] = box4(row0[2 * x], row0[2 * x + 1], row1[2 * x], row1[2 * x + 1]);
+		}
+	} else {
+		//one column wide: only rows are averaged
+		out[0] = box4(row0[0], row0[0], row1[0], row1[0]);
+	}
+}
+
+void downsample_level(MipLevel const &src, MipLevel *dst, JobSystem *jobs) {
+	dst->width = std::max(1U, src.width / 2);
+	dst->height = std::max(1U, src.height / 2);
+	dst->pixels.resize(size_t(dst->width) * dst->height);
+
+	uint32_t const *in = src.pixels.data();
+	uint32_t *out = dst->pixels.data();
+	uint32_t src_width = src.width, width = dst->width;
+	bool one_row = (src.height == 1);
+	auto rows = [=](uint32_t begin, uint32_t end) {
+		for (uint32_t y = begin; y < end; ++y) {
+			uint32_t const *row0 = in + size_t(one_row ? 0 : 2 * y) * src_width;
+			uint32_t const *row1 = in + size_t(one_row ? 0 : 2 * y + 1) * src_width;
+			downsample_row(src_width, row0, row1, width, out + size_t(y) * width);
+		}
+	};
+	//keep chunks near 64k texels so small levels stay on the calling thread:
+	uint32_t grain = std::max(1U, (1U << 16) / width);
+	if (jobs) {
+		jobs->parallel_for(dst->height, grain, rows);
+	} else {
+		rows(0, dst->height);
+	}
+}
+
+void build_mip_chain(MipLevel &&top, std::vector< MipLevel > *chain, JobSystem *jobs) {
+	chain->clear();
+	chain->emplace_back(std::move(top));
+	while (chain->back().width > 1 || chain->back().height > 1) {
+		MipLevel next;
+		downsample_level(chain->back(), &next, jobs);
+		chain->emplace_back(std::move(next));
+	}
+}
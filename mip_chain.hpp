@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+struct JobSystem;
+
+/*
+ * CPU mip chain generation for RGBA8 textures (red in the low byte, as from load_png).
+ *
+ * Textures are premultiplied before filtering so that the color of fully
+ * transparent texels never bleeds into the edges of a sprite; draw them with
+ * glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA).
+ *
+ * Each level is a 2x2 box filter of the one above (SSE2 where available), with
+ * rows split over 'jobs' when one is given. Results do not depend on the driver.
+ */
+
+struct MipLevel {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector< uint32_t > pixels;
+};
+
+//rgb *= alpha / 255, rounded:
+void premultiply_alpha(std::vector< uint32_t > *pixels, JobSystem *jobs = nullptr);
+
+//halve 'src' (odd sizes drop the last row/column; a side of 1 stays 1):
+void downsample_level(MipLevel const &src, MipLevel *dst, JobSystem *jobs = nullptr);
+
+//fill 'chain' with 'top' (level 0) and every smaller level down to 1x1:
+void build_mip_chain(MipLevel &&top, std::vector< MipLevel > *chain, JobSystem *jobs = nullptr);
@@ -0,0 +1,66 @@
+//pack_assets: gather the game's data files into one asset pack (see asset_pack.hpp).
+//
+//  usage: pack_assets <list> <out.pack>
+//
+//<list> names one file per line ('#' starts a comment), by the path the game
+//opens it with. Files that are missing are left out with a warning.
+//Run from dist/, e.g.: ../pack_assets assets.list assets.pack
+
+#include "asset_pack.hpp"
+#include "text_scan.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+	if (argc != 3) {
+		std::cerr << "usage: " << argv[0] << " <list> <out.pack>" << std::endl;
+		return 1;
+	}
+	std::string list_name = argv[1];
+	std::string out_name = argv[2];
+
+	TextScanner scan;
+	if (!scan.load(list_name)) {
+		std::cerr << "Failed to read '" << list_name << "'." << std::endl;
+		return 1;
+	}
+	std::vector< std::string > names;
+	while (scan.next_line()) {
+		std::string name;
+		scan.word(&name);
+		if (!scan.line_done()) {
+			std::cerr << scan.where() << ": expecting one file name per line (found " << scan.found() << ")." << std::endl;
+			return 1;
+		}
+		names.emplace_back(name);
+	}
+
+	if (!write_asset_pack(out_name, names)) {
+		std::cerr << "Failed to write '" << out_name << "'." << std::endl;
+		return 1;
+	}
+
+	//read it back, comparing every entry with its file:
+	AssetPack pack;
+	if (!pack.open(out_name)) {
+		std::cerr << "Failed to reopen '" << out_name << "'." << std::endl;
+		return 1;
+	}
+	size_t bytes = 0;
+	for (auto const &name : names) {
+		char const *data;
+		size_t size;
+		if (!pack.find(name, &data, &size)) continue; //left out (warned about above)
+		AssetBytes loose;
+		if (!load_asset(name, &loose) || loose.size != size || (size != 0 && std::memcmp(loose.data, data, size) != 0)) {
+			std::cerr << "'" << out_name << "' does not match '" << name << "'." << std::endl;
+			return 1;
+		}
+		bytes += size;
+	}
+	std::cout << "Packed " << pack.size() << " of " << names.size() << " file(s), " << bytes << " bytes, into '" << out_name << "'." << std::endl;
+	return 0;
+}
@@ -0,0 +1,203 @@
+//pack_atlas: trim and repack the sprites of an atlas manifest into power-of-two pages.
+//
+//  usage: pack_atlas <in.manifest> <out-name> [max-page-size [padding]]
+//
+//Writes <out-name>_<page>.png and <out-name>.manifest next to the input manifest.
+//Run from dist/, e.g.: ../pack_atlas atlas_source.manifest atlas
+
+#include "load_save_png.hpp"
+#include "sprite_atlas.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Item {
+	uint32_t sprite;          //index into the input manifest
+	glm::ivec2 src_min;       //trimmed rect on the source page (pixels, lower-left origin)
+	glm::ivec2 src_max;       //exclusive
+	glm::ivec2 size;          //src_max - src_min
+	uint32_t page = 0;        //placement in the output:
+	glm::ivec2 at = glm::ivec2(0);
+};
+
+//Shelf packing of 'items' (already sorted tallest first) into one page; returns how many fit:
+static size_t pack_page(std::vector< Item * > const &items, glm::ivec2 page_size, int padding, uint32_t page) {
+	int shelf_y = 0, shelf_h = 0, x = 0;
+	for (size_t i = 0; i < items.size(); ++i) {
+		glm::ivec2 need = items[i]->size + glm::ivec2(2 * padding);
+		if (need.x > page_size.x) return i;
+		if (x + need.x > page_size.x) {
+			shelf_y += shelf_h;
+			shelf_h = 0;
+			x = 0;
+		}
+		if (shelf_y + need.y > page_size.y) return i;
+		items[i]->page = page;
+		items[i]->at = glm::ivec2(x, shelf_y) + glm::ivec2(padding);
+		x += need.x;
+		shelf_h = std::max(shelf_h, need.y);
+	}
+	return items.size();
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3 || argc > 5) {
+		std::cerr << "usage: " << argv[0] << " <in.manifest> <out-name> [max-page-size [padding]]" << std::endl;
+		return 1;
+	}
+	std::string in_name = argv[1];
+	std::string out_name = argv[2];
+	int max_page = (argc > 3 ? std::stoi(argv[3]) : 4096);
+	int padding = (argc > 4 ? std::stoi(argv[4]) : 4);
+
+	AtlasManifest in;
+	if (!load_atlas_manifest(in_name, &in)) {
+		std::cerr << "Failed to load '" << in_name << "'." << std::endl;
+		return 1;
+	}
+
+	std::vector< glm::uvec2 > page_sizes(in.pages.size());
+	std::vector< std::vector< uint32_t > > page_data(in.pages.size());
+	uint64_t source_texels = 0;
+	for (uint32_t p = 0; p < in.pages.size(); ++p) {
+		if (!load_png(in.pages[p].file, &page_sizes[p].x, &page_sizes[p].y, &page_data[p], LowerLeftOrigin)) {
+			std::cerr << "Failed to load page '" << in.pages[p].file << "'." << std::endl;
+			return 1;
+		}
+		source_texels += uint64_t(page_sizes[p].x) * page_sizes[p].y;
+	}
+
+	//trim every sprite down to its non-transparent texels:
+	std::vector< Item > items;
+	AtlasManifest out;
+	for (uint32_t s = 0; s < in.sprites.size(); ++s) {
+		AtlasSprite const &sprite = in.sprites[s];
+		glm::uvec2 page_size = page_sizes[sprite.page];
+		std::vector< uint32_t > const &data = page_data[sprite.page];
+
+		glm::ivec2 lo = glm::ivec2(glm::floor(glm::min(sprite.uv0, sprite.uv1)));
+		glm::ivec2 hi = glm::ivec2(glm::ceil(glm::max(sprite.uv0, sprite.uv1)));
+		lo = glm::clamp(lo, glm::ivec2(0), glm::ivec2(page_size));
+		hi = glm::clamp(hi, glm::ivec2(0), glm::ivec2(page_size));
+
+		glm::ivec2 trim_lo = hi, trim_hi = lo;
+		for (int y = lo.y; y < hi.y; ++y) {
+			for (int x = lo.x; x < hi.x; ++x) {
+				if ((data[y * page_size.x + x] >> 24) != 0) {
+					trim_lo = glm::min(trim_lo, glm::ivec2(x, y));
+					trim_hi = glm::max(trim_hi, glm::ivec2(x + 1, y + 1));
+				}
+			}
+		}
+		if (trim_lo.x >= trim_hi.x || trim_lo.y >= trim_hi.y) {
+			//fully transparent; keep a single texel so the sprite still exists
+			trim_lo = lo;
+			trim_hi = lo + glm::ivec2(1);
+		}
+
+		Item item;
+		item.sprite = s;
+		item.src_min = trim_lo;
+		item.src_max = trim_hi;
+		item.size = trim_hi - trim_lo;
+		items.emplace_back(item);
+
+		//trimmed amounts, as a fraction of the untrimmed part of the drawn quad:
+		glm::vec2 extent = glm::max(glm::vec2(hi - lo), glm::vec2(1.0f));
+		glm::vec2 cut_low = glm::vec2(trim_lo - lo) / extent;
+		glm::vec2 cut_high = glm::vec2(hi - trim_hi) / extent;
+		glm::vec2 visible = glm::vec2(1.0f) - sprite.inset_min - sprite.inset_max;
+
+		AtlasSprite packed = sprite;
+		for (int c = 0; c < 2; ++c) {
+			bool mirrored = sprite.uv0[c] > sprite.uv1[c];
+			packed.inset_min[c] += visible[c] * (mirrored ? cut_high[c] : cut_low[c]);
+			packed.inset_max[c] += visible[c] * (mirrored ? cut_low[c] : cut_high[c]);
+		}
+		out.sprites.emplace_back(packed);
+	}
+
+	//tallest first keeps shelves tight:
+	std::vector< Item * > order;
+	for (auto &item : items) order.emplace_back(&item);
+	std::stable_sort(order.begin(), order.end(), [](Item const *a, Item const *b) {
+		return a->size.y > b->size.y;
+	});
+
+	//smallest power-of-two page that holds everything, or as many max-size pages as needed:
+	glm::ivec2 best = glm::ivec2(0);
+	for (int w = 64; w <= max_page; w *= 2) {
+		for (int h = std::max(64, w / 2); h <= std::min(max_page, w * 2); h *= 2) {
+			if (best.x != 0 && w * h >= best.x * best.y) continue;
+			if (pack_page(order, glm::ivec2(w, h), padding, 0) == order.size()) {
+				best = glm::ivec2(w, h);
+			}
+		}
+	}
+
+	std::vector< glm::ivec2 > out_sizes;
+	if (best.x != 0) {
+		pack_page(order, best, padding, 0);
+		out_sizes.emplace_back(best);
+	} else {
+		std::vector< Item * > remaining = order;
+		while (!remaining.empty()) {
+			uint32_t page = uint32_t(out_sizes.size());
+			size_t placed = pack_page(remaining, glm::ivec2(max_page), padding, page);
+			if (placed == 0) {
+				std::cerr << "Sprite '" << in.sprites[remaining[0]->sprite].name << "' does not fit on a " << max_page << "x" << max_page << " page." << std::endl;
+				return 1;
+			}
+			out_sizes.emplace_back(max_page, max_page);
+			remaining.erase(remaining.begin(), remaining.begin() + placed);
+		}
+	}
+
+	//copy texels and write the output:
+	std::vector< std::vector< uint32_t > > out_data(out_sizes.size());
+	for (uint32_t p = 0; p < out_sizes.size(); ++p) {
+		out_data[p].assign(out_sizes[p].x * out_sizes[p].y, 0);
+	}
+	for (auto const &item : items) {
+		AtlasSprite const &sprite = in.sprites[item.sprite];
+		std::vector< uint32_t > const &src = page_data[sprite.page];
+		uint32_t src_w = page_sizes[sprite.page].x;
+		std::vector< uint32_t > &dst = out_data[item.page];
+		uint32_t dst_w = out_sizes[item.page].x;
+		for (int y = 0; y < item.size.y; ++y) {
+			std::copy(
+				src.begin() + (item.src_min.y + y) * src_w + item.src_min.x,
+				src.begin() + (item.src_min.y + y) * src_w + item.src_min.x + item.size.x,
+				dst.begin() + (item.at.y + y) * dst_w + item.at.x);
+		}
+
+		//keep the source orientation (mirrored sprites stay mirrored):
+		AtlasSprite &packed = out.sprites[item.sprite];
+		packed.page = item.page;
+		glm::vec2 lo = glm::vec2(item.at), hi = glm::vec2(item.at + item.size);
+		for (int c = 0; c < 2; ++c) {
+			bool mirrored = sprite.uv0[c] > sprite.uv1[c];
+			packed.uv0[c] = (mirrored ? hi[c] : lo[c]);
+			packed.uv1[c] = (mirrored ? lo[c] : hi[c]);
+		}
+	}
+
+	uint64_t packed_texels = 0;
+	for (uint32_t p = 0; p < out_sizes.size(); ++p) {
+		AtlasPage page;
+		page.file = out_name + "_" + std::to_string(p) + ".png";
+		page.size = glm::uvec2(out_sizes[p]);
+		save_png(page.file, page.size.x, page.size.y, &out_data[p][0], LowerLeftOrigin);
+		out.pages.emplace_back(page);
+		packed_texels += uint64_t(page.size.x) * page.size.y;
+	}
+	if (!save_atlas_manifest(out_name + ".manifest", out)) return 1;
+
+	std::cout << "Packed " << out.sprites.size() << " sprites into " << out.pages.size() << " page(s) of "
+		<< out_sizes[0].x << "x" << out_sizes[0].y << ": "
+		<< source_texels << " -> " << packed_texels << " texels ("
+		<< (source_texels * 4) / (1024 * 1024) << " MiB -> " << (packed_texels * 4) / (1024 * 1024) << " MiB as RGBA8)." << std::endl;
+	return 0;
+}
@@ -0,0 +1,209 @@
+#include "program_cache.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+static GLuint compile_shader(GLenum type, std::string const &source) {
+	GLuint shader = glCreateShader(type);
+	GLchar const *str = source.c_str();
+	GLint length = source.size();
+	glShaderSource(shader, 1, &str, &length);
+	glCompileShader(shader);
+	GLint compile_status = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compile_status);
+	if (compile_status != GL_TRUE) {
+		std::cerr << "Failed to compile shader." << std::endl;
+		GLint info_log_length = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &info_log_length);
+		std::vector< GLchar > info_log(info_log_length, 0);
+		GLsizei length = 0;
+		glGetShaderInfoLog(shader, info_log.size(), &length, &info_log[0]);
+		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
+		glDeleteShader(shader);
+		throw std::runtime_error("Failed to compile shader.");
+	}
+	return shader;
+}
+
+//64-bit FNV-1a, continuing from 'hash':
+static uint64_t hash_bytes(void const *data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL) {
+	uint8_t const *bytes = reinterpret_cast< uint8_t const * >(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+ProgramCache::ProgramCache(std::string const &directory_) : directory(directory_) {
+	for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		char const *str = reinterpret_cast< char const * >(glGetString(name));
+		driver += (str ? str : "?");
+		driver += '\n';
+	}
+
+	bool extension = false;
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if (major > 4 || (major == 4 && minor >= 1)) {
+		extension = true;
+	} else {
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; ++i) {
+			char const *name = reinterpret_cast< char const * >(glGetStringi(GL_EXTENSIONS, i));
+			if (name && strcmp(name, "GL_ARB_get_program_binary") == 0) {
+				extension = true;
+			}
+		}
+	}
+	if (!extension) return;
+
+	//(only asked once the extension is known to be there, so it can't raise GL_INVALID_ENUM)
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if (formats <= 0) return;
+
+	get_program_binary = (PFNGLGETPROGRAMBINARYPROC)SDL_GL_GetProcAddress("glGetProgramBinary");
+	program_binary = (PFNGLPROGRAMBINARYPROC)SDL_GL_GetProcAddress("glProgramBinary");
+	program_parameteri = (PFNGLPROGRAMPARAMETERIPROC)SDL_GL_GetProcAddress("glProgramParameteri");
+	supported = (get_program_binary && program_binary && program_parameteri);
+}
+
+GLuint ProgramCache::program(std::string const &vertex_source, std::string const &fragment_source) {
+	uint64_t key = hash_bytes(driver.c_str(), driver.size() + 1);
+	key = hash_bytes(vertex_source.c_str(), vertex_source.size() + 1, key);
+	key = hash_bytes(fragment_source.c_str(), fragment_source.size() + 1, key);
+	char name[17];
+	snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+	std::string filename = directory + "/" + name + ".bin";
+
+	GLuint program = 0;
+	if (supported && load(filename, key, &program)) {
+		hits += 1;
+		return program;
+	}
+	misses += 1;
+
+	GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER, vertex_source);
+	GLuint fragment_shader = compile_shader(GL_FRAGMENT_SHADER, fragment_source);
+
+	program = glCreateProgram();
+	glAttachShader(program, vertex_shader);
+	glAttachShader(program, fragment_shader);
+	if (supported) program_parameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+	//(the program keeps what it needs; the shaders go once it does)
+	glDeleteShader(vertex_shader);
+	glDeleteShader(fragment_shader);
+	GLint link_status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+	if (link_status != GL_TRUE) {
+		std::cerr << "Failed to link shader program." << std::endl;
+		GLint info_log_length = 0;
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &info_log_length);
+		std::vector< GLchar > info_log(info_log_length, 0);
+		GLsizei length = 0;
+		glGetProgramInfoLog(program, info_log.size(), &length, &info_log[0]);
+		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
+		throw std::runtime_error("Failed to link program");
+	}
+
+	if (supported) save(filename, key, program);
+	return program;
+}
+
+bool ProgramCache::load(std::string const &filename, uint64_t key, GLuint *program_) {
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	if (!file) return false; //not cached yet
+
+	char magic[4];
+	uint64_t file_key = 0;
+	uint32_t driver_length = 0;
+	if (!file.read(magic, 4) || std::memcmp(magic, "PRG1", 4) != 0
+	 || !file.read(reinterpret_cast< char * >(&file_key), 8) || file_key != key
+	 || !file.read(reinterpret_cast< char * >(&driver_length), 4) || driver_length != driver.size()) {
+		return false;
+	}
+	std::string file_driver(driver_length, '\0');
+	uint32_t format = 0, length = 0;
+	if (!file.read(&file_driver[0], driver_length) || file_driver != driver
+	 || !file.read(reinterpret_cast< char * >(&format), 4)
+	 || !file.read(reinterpret_cast< char * >(&length), 4) || length == 0) {
+		return false;
+	}
+	//a corrupt length must not turn into a huge allocation -- check it against what is left of the file:
+	std::streamoff at = file.tellg();
+	file.seekg(0, std::ios::end);
+	std::streamoff end = file.tellg();
+	if (at < 0 || end < at || uint64_t(end - at) < length) return false;
+	file.seekg(at);
+	std::vector< char > binary(length);
+	if (!file.read(binary.data(), length)) return false;
+
+	GLuint program = glCreateProgram();
+	program_binary(program, format, binary.data(), GLsizei(length));
+	GLint link_status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+	if (link_status != GL_TRUE) {
+		//e.g. a driver update that kept its version string; compile and replace the entry:
+		glDeleteProgram(program);
+		return false;
+	}
+	*program_ = program;
+	return true;
+}
+
+void ProgramCache::save(std::string const &filename, uint64_t key, GLuint program) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) return;
+	std::vector< char > binary(length);
+	GLsizei written = 0;
+	GLenum format = 0;
+	get_program_binary(program, length, &written, &format, binary.data());
+	if (written <= 0) return;
+
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+	//(written whole to a temporary file and renamed, so a reader never sees part of an entry)
+	std::string temporary = filename + ".tmp";
+	{
+		std::ofstream file(temporary.c_str(), std::ios::binary);
+		uint32_t driver_length = uint32_t(driver.size());
+		uint32_t format32 = uint32_t(format);
+		uint32_t length32 = uint32_t(written);
+		file.write("PRG1", 4);
+		file.write(reinterpret_cast< char const * >(&key), 8);
+		file.write(reinterpret_cast< char const * >(&driver_length), 4);
+		file.write(driver.data(), driver_length);
+		file.write(reinterpret_cast< char const * >(&format32), 4);
+		file.write(reinterpret_cast< char const * >(&length32), 4);
+		file.write(binary.data(), written);
+		if (!file) {
+			std::cerr << "NOTE: could not write program cache entry '" << temporary << "'." << std::endl;
+			std::remove(temporary.c_str());
+			return;
+		}
+	}
+	std::remove(filename.c_str()); //(rename won't replace an existing file on Windows)
+	if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+		std::cerr << "NOTE: could not write program cache entry '" << filename << "'." << std::endl;
+		std::remove(temporary.c_str());
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <string>
+#include <stdint.h>
+
+/*
+ * Linked GL programs, cached on disk as driver program binaries.
+ *
+ * program() builds a program from vertex and fragment shader sources. When the
+ * driver can hand out program binaries (ARB_get_program_binary, core in 4.1,
+ * with GL_NUM_PROGRAM_BINARY_FORMATS > 0) the linked binary is saved in the
+ * cache directory, and later runs load it with glProgramBinary instead of
+ * compiling. Entries are keyed by a hash of the driver (GL_VENDOR, GL_RENDERER,
+ * GL_VERSION) and the sources, so an edited shader or a new driver just
+ * misses; a binary the driver refuses is replaced. Without binary support
+ * (or if anything goes wrong reading or writing the cache) programs are
+ * compiled and linked every time, as before.
+ *
+ * Cache files, "<directory>/<key hash as 16 hex digits>.bin" (little-endian):
+ *   "PRG1"
+ *   uint64 key hash
+ *   uint32 driver string length, driver string
+ *   uint32 binary format, uint32 binary length, binary
+ */
+
+struct ProgramCache {
+	//check for program binary support (needs a current GL context);
+	//'directory' is created when the first binary is saved:
+	explicit ProgramCache(std::string const &directory);
+
+	//A linked program from these sources, from the cache if possible.
+	//Throws std::runtime_error (after printing the info log) if compiling or linking fails:
+	GLuint program(std::string const &vertex_source, std::string const &fragment_source);
+
+	bool binaries_supported() const { return supported; }
+
+	//programs loaded from the cache / compiled, so far:
+	uint32_t hits = 0;
+	uint32_t misses = 0;
+
+private:
+	bool load(std::string const &filename, uint64_t key, GLuint *program);
+	void save(std::string const &filename, uint64_t key, GLuint program);
+
+	std::string directory;
+	std::string driver; //vendor, renderer and version strings
+	bool supported = false;
+
+	//(looked up at run time: these are GL 4.1, newer than the 3.3 context asked for)
+	PFNGLGETPROGRAMBINARYPROC get_program_binary = nullptr;
+	PFNGLPROGRAMBINARYPROC program_binary = nullptr;
+	PFNGLPROGRAMPARAMETERIPROC program_parameteri = nullptr;
+};
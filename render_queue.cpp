@@ -0,0 +1,41 @@
+#include "render_queue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+void RenderQueue::sort() {
+	size_t count = commands.size();
+	if (count < 2) return;
+	scratch.resize(count);
+
+	//histograms of all eight key bytes in one pass:
+	uint32_t histograms[8][256];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (auto const &command : commands) {
+		for (uint32_t b = 0; b < 8; ++b) {
+			histograms[b][(command.key >> (8 * b)) & 0xff] += 1;
+		}
+	}
+
+	Command *from = commands.data();
+	Command *to = scratch.data();
+	for (uint32_t b = 0; b < 8; ++b) {
+		uint32_t *histogram = histograms[b];
+		//every key has the same byte here -- the pass would not move anything:
+		if (histogram[(from[0].key >> (8 * b)) & 0xff] == count) continue;
+
+		uint32_t offsets[256];
+		uint32_t sum = 0;
+		for (uint32_t d = 0; d < 256; ++d) {
+			offsets[d] = sum;
+			sum += histogram[d];
+		}
+		for (size_t i = 0; i < count; ++i) {
+			to[offsets[(from[i].key >> (8 * b)) & 0xff]++] = from[i];
+		}
+		std::swap(from, to);
+	}
+	if (from != commands.data()) {
+		commands.swap(scratch);
+	}
+}
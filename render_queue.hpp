@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Draw commands, each with a 64-bit sort key, sorted once per frame so that
+ * drawing follows the key order instead of the order things were submitted in.
+ *
+ * Key layout, most significant bits first:
+ *   layer    (8 bits)  painter's order: lower layers are drawn first
+ *   material (8 bits)  program + blend mode (+ vertex format)
+ *   texture  (16 bits)
+ *   depth    (32 bits) order within a layer's (material, texture) group
+ * Commands with equal keys keep the order they were pushed in.
+ *
+ * Layers are the unit of back-to-front ordering: within a layer, commands are
+ * grouped by material and texture, so a layer's sprites should not depend on
+ * being drawn in submission order across different textures. The caller turns
+ * the sorted commands into draw calls, starting a new one only when the state
+ * bits (material, texture) change -- which also merges neighbouring layers that
+ * share a texture.
+ *
+ * Once the lists have grown to the largest frame seen, nothing allocates.
+ */
+
+struct RenderQueue {
+	struct Command {
+		uint64_t key;
+		uint32_t payload; //caller's: e.g. the index of the sprite's vertices
+	};
+
+	static uint64_t key(uint32_t layer, uint32_t material, uint32_t texture, uint32_t depth = 0) {
+		return (uint64_t(layer & 0xff) << 56) | (uint64_t(material & 0xff) << 48) | (uint64_t(texture & 0xffff) << 32) | uint64_t(depth);
+	}
+	static uint32_t layer(uint64_t key) { return uint32_t(key >> 56); }
+	static uint32_t material(uint64_t key) { return uint32_t(key >> 48) & 0xff; }
+	static uint32_t texture(uint64_t key) { return uint32_t(key >> 32) & 0xffff; }
+	//material and texture: the bits that need a state change when they differ
+	static uint64_t state(uint64_t key) { return (key >> 32) & 0xffffff; }
+
+	void clear() { commands.clear(); }
+	void push(uint64_t key, uint32_t payload) { commands.push_back(Command{ key, payload }); }
+
+	//order 'commands' by key (LSD radix sort, stable; byte positions every key shares are skipped):
+	void sort();
+
+	std::vector< Command > commands;
+
+private:
+	std::vector< Command > scratch;
+};
@@ -0,0 +1,36 @@
+#include "sound_field.hpp"
+
+void ListenerGrid::build() {
+	cell_start.clear();
+	items.clear();
+	if (points.empty()) {
+		dims = glm::ivec2(0);
+		return;
+	}
+
+	glm::ivec2 max_cell = cell_of(points[0]);
+	min_cell = max_cell;
+	for (auto const &p : points) {
+		glm::ivec2 c = cell_of(p);
+		min_cell = glm::min(min_cell, c);
+		max_cell = glm::max(max_cell, c);
+	}
+	dims = max_cell - min_cell + glm::ivec2(1);
+
+	//counting sort of listeners into cells:
+	cell_start.assign(dims.x * dims.y + 1, 0);
+	for (auto const &p : points) {
+		glm::ivec2 c = cell_of(p) - min_cell;
+		cell_start[c.y * dims.x + c.x + 1] += 1;
+	}
+	for (uint32_t i = 1; i < cell_start.size(); ++i) {
+		cell_start[i] += cell_start[i-1];
+	}
+	items.resize(points.size());
+	std::vector< uint32_t > &fill = scratch;
+	fill.assign(cell_start.begin(), cell_start.end() - 1);
+	for (uint32_t i = 0; i < points.size(); ++i) {
+		glm::ivec2 c = cell_of(points[i]) - min_cell;
+		items[fill[c.y * dims.x + c.x]++] = i;
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Route noises to nearby listeners through a uniform grid.
+ *
+ * Listener points (enemy ears, lamp bulbs, ...) are bucketed into square cells;
+ * a noise only visits the cells its radius overlaps and compares squared distances.
+ */
+
+enum NoiseKind {
+	NoiseWalk,
+	NoiseRun,
+	NoiseThrow,
+};
+
+struct NoiseEvent {
+	NoiseKind kind;
+	glm::vec2 pos;
+	float radius;
+};
+
+struct ListenerGrid {
+	float cell_size = 2.0f;
+
+	glm::ivec2 min_cell = glm::ivec2(0);
+	glm::ivec2 dims = glm::ivec2(0);
+
+	std::vector< glm::vec2 > points;    //listener positions, by listener index
+	std::vector< uint32_t > cell_start; //dims.x * dims.y + 1 offsets into items
+	std::vector< uint32_t > items;      //listener indices, grouped by cell
+	std::vector< uint32_t > scratch;    //fill cursors used during build()
+
+	//rebuild the buckets from 'points' (storage is reused between builds):
+	void build();
+
+	//call heard(index) for every listener within 'radius' of 'at', in cell order:
+	template< typename F >
+	void query(glm::vec2 const &at, float radius, F const &heard) const {
+		if (points.empty()) return;
+		glm::ivec2 lo = glm::max(cell_of(at - glm::vec2(radius)), min_cell);
+		glm::ivec2 hi = glm::min(cell_of(at + glm::vec2(radius)), min_cell + dims - glm::ivec2(1));
+		float radius2 = radius * radius;
+		for (int y = lo.y; y <= hi.y; ++y) {
+			for (int x = lo.x; x <= hi.x; ++x) {
+				uint32_t cell = (y - min_cell.y) * dims.x + (x - min_cell.x);
+				for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+					glm::vec2 d = points[items[i]] - at;
+					if (d.x * d.x + d.y * d.y <= radius2) {
+						heard(items[i]);
+					}
+				}
+			}
+		}
+	}
+
+	glm::ivec2 cell_of(glm::vec2 const &at) const {
+		return glm::ivec2(glm::floor(at / cell_size));
+	}
+};
@@ -0,0 +1,108 @@
+#include "sprite_atlas.hpp"
+#include "text_scan.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#define LOG_ERROR( X ) std::cerr << X << std::endl
+
+bool load_atlas_manifest(std::string const &filename, AtlasManifest *manifest) {
+	TextScanner scan;
+	if (!scan.load(filename)) {
+		return false;
+	}
+	manifest->pages.clear();
+	manifest->sprites.clear();
+
+	TextToken kind;
+	while (scan.next_line()) {
+		scan.word(&kind);
+
+		if (kind == "page") {
+			AtlasPage page;
+			if (!(scan.word(&page.file) && scan.number(&page.size.x) && scan.number(&page.size.y) && scan.line_done())) {
+				LOG_ERROR(scan.where() << ": malformed page record (found " << scan.found() << ").");
+				return false;
+			}
+			manifest->pages.emplace_back(page);
+		} else if (kind == "sprite") {
+			AtlasSprite sprite;
+			if (!(scan.word(&sprite.name) && scan.number(&sprite.page)
+				&& scan.number(&sprite.uv0.x) && scan.number(&sprite.uv0.y) && scan.number(&sprite.uv1.x) && scan.number(&sprite.uv1.y))) {
+				LOG_ERROR(scan.where() << ": malformed sprite record (found " << scan.found() << ").");
+				return false;
+			}
+			//insets are optional:
+			if (!scan.line_done()) {
+				if (!(scan.number(&sprite.inset_min.x) && scan.number(&sprite.inset_min.y)
+					&& scan.number(&sprite.inset_max.x) && scan.number(&sprite.inset_max.y) && scan.line_done())) {
+					LOG_ERROR(scan.where() << ": sprite insets need four values (found " << scan.found() << ").");
+					return false;
+				}
+			}
+			if (sprite.page >= manifest->pages.size()) {
+				LOG_ERROR(scan.where() << ": sprite '" << sprite.name << "' refers to an undeclared page.");
+				return false;
+			}
+			manifest->sprites.emplace_back(sprite);
+		} else {
+			LOG_ERROR(scan.where() << ": unknown record '" << kind.str() << "'.");
+			return false;
+		}
+	}
+	return true;
+}
+
+bool save_atlas_manifest(std::string const &filename, AtlasManifest const &manifest) {
+	std::ofstream file(filename.c_str());
+	if (!file) {
+		LOG_ERROR("  cannot open '" << filename << "' for writing.");
+		return false;
+	}
+	file << "# sprite atlas manifest (see sprite_atlas.hpp)\n";
+	for (auto const &page : manifest.pages) {
+		file << "page " << page.file << " " << page.size.x << " " << page.size.y << "\n";
+	}
+	for (auto const &sprite : manifest.sprites) {
+		file << "sprite " << sprite.name << " " << sprite.page
+			<< " " << sprite.uv0.x << " " << sprite.uv0.y
+			<< " " << sprite.uv1.x << " " << sprite.uv1.y;
+		if (sprite.inset_min != glm::vec2(0.0f) || sprite.inset_max != glm::vec2(0.0f)) {
+			file << " " << sprite.inset_min.x << " " << sprite.inset_min.y
+				<< " " << sprite.inset_max.x << " " << sprite.inset_max.y;
+		}
+		file << "\n";
+	}
+	return bool(file);
+}
+
+static std::map< std::string, SpriteInfo > &sprite_table() {
+	static std::map< std::string, SpriteInfo > table;
+	return table;
+}
+
+void use_atlas_manifest(AtlasManifest const &manifest) {
+	std::map< std::string, SpriteInfo > &table = sprite_table();
+	table.clear();
+	for (auto const &sprite : manifest.sprites) {
+		glm::vec2 page_size = glm::vec2(manifest.pages[sprite.page].size);
+		SpriteInfo info;
+		info.min_uv = sprite.uv0 / page_size;
+		info.max_uv = sprite.uv1 / page_size;
+		info.origin = glm::vec2(0.0f);
+		info.inset_min = sprite.inset_min;
+		info.inset_max = sprite.inset_max;
+		info.page = sprite.page;
+		table[sprite.name] = info;
+	}
+}
+
+SpriteInfo atlas_sprite(std::string const &name) {
+	auto f = sprite_table().find(name);
+	if (f == sprite_table().end()) {
+		throw std::runtime_error("no sprite named '" + name + "' in the atlas manifest");
+	}
+	return f->second;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Sprite atlas manifests: which image pages make up the atlas and where each
+ * named sprite lives on them.
+ *
+ * Text format, one record per line ('#' starts a comment):
+ *   page <file> <width> <height>
+ *   sprite <name> <page> <u0> <v0> <u1> <v1> [<left> <bottom> <right> <top>]
+ *
+ * Sprite rectangles are in pixels with a lower-left origin (the layout of a
+ * page loaded with LowerLeftOrigin). u0 > u1 or v0 > v1 means the sprite is
+ * drawn mirrored. The optional insets are the fractions of the drawn quad that
+ * pack_atlas trimmed away because they were fully transparent.
+ */
+
+struct SpriteInfo {
+	glm::vec2 min_uv;
+	glm::vec2 max_uv;
+	glm::vec2 origin;
+	glm::vec2 inset_min; //fraction of the quad trimmed at the min_uv corner
+	glm::vec2 inset_max; //fraction of the quad trimmed at the max_uv corner
+	uint32_t page;
+};
+
+struct AtlasPage {
+	std::string file;
+	glm::uvec2 size = glm::uvec2(0);
+};
+
+struct AtlasSprite {
+	std::string name;
+	uint32_t page = 0;
+	glm::vec2 uv0 = glm::vec2(0.0f); //pixels
+	glm::vec2 uv1 = glm::vec2(0.0f); //pixels
+	glm::vec2 inset_min = glm::vec2(0.0f);
+	glm::vec2 inset_max = glm::vec2(0.0f);
+};
+
+struct AtlasManifest {
+	std::vector< AtlasPage > pages;
+	std::vector< AtlasSprite > sprites;
+};
+
+bool load_atlas_manifest(std::string const &filename, AtlasManifest *manifest);
+bool save_atlas_manifest(std::string const &filename, AtlasManifest const &manifest);
+
+//Make 'manifest' the source of atlas_sprite() lookups:
+void use_atlas_manifest(AtlasManifest const &manifest);
+
+//Look up a sprite of the manifest in use (throws if there is no such sprite):
+SpriteInfo atlas_sprite(std::string const &name);
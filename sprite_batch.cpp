@@ -0,0 +1,176 @@
+#include "sprite_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//(the SSE2 path loads each pair of neighbouring vec2s as one register:)
+static_assert(offsetof(SpriteRecord, size) == offsetof(SpriteRecord, at) + 8, "at, size are adjacent");
+static_assert(offsetof(SpriteRecord, inset_max) == offsetof(SpriteRecord, inset_min) + 8, "inset_min, inset_max are adjacent");
+static_assert(offsetof(SpriteRecord, max_uv) == offsetof(SpriteRecord, min_uv) + 8, "min_uv, max_uv are adjacent");
+
+//any angle, one corner at a time:
+static void emit_rotated(SpriteRecord const &r, SpriteVertex *out) {
+	glm::vec2 right = glm::vec2(std::cos(r.angle), std::sin(r.angle));
+	glm::vec2 up = glm::vec2(-right.y, right.x);
+
+	//trimmed sprites only cover the untrimmed part of the quad:
+	glm::vec2 lo = r.size * (r.inset_min - 0.5f);
+	glm::vec2 hi = r.size * (0.5f - r.inset_max);
+
+	out[0] = SpriteVertex(r.at + right * lo.x + up * lo.y, glm::vec2(r.min_uv.x, r.min_uv.y), r.tint);
+	out[1] = out[0];
+	out[2] = SpriteVertex(r.at + right * lo.x + up * hi.y, glm::vec2(r.min_uv.x, r.max_uv.y), r.tint);
+	out[3] = SpriteVertex(r.at + right * hi.x + up * lo.y, glm::vec2(r.max_uv.x, r.min_uv.y), r.tint);
+	out[4] = SpriteVertex(r.at + right * hi.x + up * hi.y, glm::vec2(r.max_uv.x, r.max_uv.y), r.tint);
+	out[5] = out[4];
+}
+
+#ifdef __SSE2__
+#ifdef COMPACT_VERTICES
+//glm::round -- halves away from zero, unlike _mm_cvtps_epi32 -- of values in the int32 range:
+static inline __m128i round_half_away(__m128 x) {
+	__m128i truncated = _mm_cvttps_epi32(x);
+	__m128 fraction = _mm_sub_ps(x, _mm_cvtepi32_ps(truncated)); //(exact)
+	__m128i up = _mm_castps_si128(_mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), fraction), _mm_set1_ps(0.5f)));
+	__m128i away = _mm_or_si128(_mm_srai_epi32(_mm_castps_si128(x), 31), _mm_set1_epi32(1)); //+1 or -1, the sign of x
+	return _mm_add_epi32(truncated, _mm_and_si128(up, away));
+}
+#endif
+
+//angle 0: both corners in one register, as (lo.x, lo.y, hi.x, hi.y):
+static inline void emit_axis_aligned(SpriteRecord const &r, SpriteVertex *out) {
+	__m128 at_size = _mm_loadu_ps(&r.at.x);
+	__m128 at = _mm_movelh_ps(at_size, at_size);
+	__m128 size = _mm_movehl_ps(at_size, at_size);
+	//(inset_min - 0.5, 0.5 - inset_max), computed exactly as the scalar path does:
+	__m128 insets = _mm_loadu_ps(&r.inset_min.x);
+	__m128 fractions = _mm_add_ps(_mm_xor_ps(insets, _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f)), _mm_setr_ps(-0.5f, -0.5f, 0.5f, 0.5f));
+	__m128 corners = _mm_add_ps(at, _mm_mul_ps(size, fractions));
+	__m128 uvs = _mm_loadu_ps(&r.min_uv.x);
+
+#ifdef COMPACT_VERTICES
+	//quantize, to the same values as SpriteVertex's constructor:
+	__m128 scaled = _mm_mul_ps(corners, _mm_set1_ps(SpriteVertex::position_scale()));
+	scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+	__m128i positions = round_half_away(scaled);
+	positions = _mm_packs_epi32(positions, positions);
+	__m128 clamped = _mm_min_ps(_mm_max_ps(uvs, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+	__m128i texcoords = _mm_sub_epi32(round_half_away(_mm_mul_ps(clamped, _mm_set1_ps(65535.0f))), _mm_set1_epi32(32768));
+	texcoords = _mm_xor_si128(_mm_packs_epi32(texcoords, texcoords), _mm_set1_epi16(-32768)); //(no packus_epi32 in SSE2)
+	int16_t p[8];
+	uint16_t t[8];
+	_mm_storeu_si128(reinterpret_cast< __m128i * >(p), positions);
+	_mm_storeu_si128(reinterpret_cast< __m128i * >(t), texcoords);
+	auto corner = [&r, &p, &t](SpriteVertex *v, uint32_t x, uint32_t y) {
+		v->Position = glm::i16vec2(p[x], p[y]);
+		v->TexCoord = glm::u16vec2(t[x], t[y]);
+		v->Color = r.tint;
+	};
+	corner(out + 0, 0, 1);
+	corner(out + 2, 0, 3);
+	corner(out + 3, 2, 1);
+	corner(out + 4, 2, 3);
+#else
+	//one register per vertex, as (Position, TexCoord):
+	__m128 v0 = _mm_movelh_ps(corners, uvs);                           //lo.x lo.y min_uv.x min_uv.y
+	__m128 v2 = _mm_shuffle_ps(corners, uvs, _MM_SHUFFLE(3, 0, 3, 0)); //lo.x hi.y min_uv.x max_uv.y
+	__m128 v3 = _mm_shuffle_ps(corners, uvs, _MM_SHUFFLE(1, 2, 1, 2)); //hi.x lo.y max_uv.x min_uv.y
+	__m128 v4 = _mm_movehl_ps(uvs, corners);                           //hi.x hi.y max_uv.x max_uv.y
+	_mm_storeu_ps(&out[0].Position.x, v0);
+	_mm_storeu_ps(&out[2].Position.x, v2);
+	_mm_storeu_ps(&out[3].Position.x, v3);
+	_mm_storeu_ps(&out[4].Position.x, v4);
+	out[0].Color = out[2].Color = out[3].Color = out[4].Color = r.tint;
+#endif
+	out[1] = out[0];
+	out[5] = out[4];
+}
+#else
+//angle 0: no cos/sin, and just the two corners:
+static inline void emit_axis_aligned(SpriteRecord const &r, SpriteVertex *out) {
+	glm::vec2 lo = r.at + r.size * (r.inset_min - 0.5f);
+	glm::vec2 hi = r.at + r.size * (0.5f - r.inset_max);
+
+	out[0] = SpriteVertex(lo, r.min_uv, r.tint);
+	out[1] = out[0];
+	out[2] = SpriteVertex(glm::vec2(lo.x, hi.y), glm::vec2(r.min_uv.x, r.max_uv.y), r.tint);
+	out[3] = SpriteVertex(glm::vec2(hi.x, lo.y), glm::vec2(r.max_uv.x, r.min_uv.y), r.tint);
+	out[4] = SpriteVertex(hi, r.max_uv, r.tint);
+	out[5] = out[4];
+}
+#endif
+
+void emit_sprites(SpriteRecord const *records, size_t count, std::vector< SpriteVertex > *out_) {
+	std::vector< SpriteVertex > &out = *out_;
+	size_t start = out.size();
+	out.resize(start + 6 * count);
+	SpriteVertex *verts = out.data() + start;
+	for (size_t i = 0; i < count; ++i, verts += 6) {
+		if (records[i].angle == 0.0f) {
+			emit_axis_aligned(records[i], verts);
+		} else {
+			emit_rotated(records[i], verts);
+		}
+	}
+}
+
+bool sprite_in_range(SpriteRecord const &record) {
+	//(half the diagonal bounds the corners' reach at any angle and inset)
+	float reach = std::max(std::abs(record.at.x), std::abs(record.at.y)) + 0.5f * (std::abs(record.size.x) + std::abs(record.size.y));
+	return reach <= SpriteVertex::position_range();
+}
+
+void split_sprite(SpriteRecord const &record, std::vector< SpriteRecord > *out) {
+	constexpr float MaxPiece = 32.0f;
+	bool rotated = (record.angle != 0.0f);
+
+	//piece boundaries along each axis, as the quad's own corners are placed by emit_sprites:
+	glm::vec2 lo = record.size * (record.inset_min - 0.5f);
+	glm::vec2 hi = record.size * (0.5f - record.inset_max);
+	std::vector< float > bounds[2];
+	std::vector< float > fractions[2];
+	for (uint32_t axis = 0; axis < 2; ++axis) {
+		uint32_t count = uint32_t(std::max(1.0f, std::ceil(std::abs(hi[axis] - lo[axis]) / MaxPiece)));
+		for (uint32_t k = 0; k <= count; ++k) {
+			float t = float(k) / float(count);
+			float b = (k == count ? hi[axis] : lo[axis] + (hi[axis] - lo[axis]) * t);
+			if (!rotated) {
+				//unrotated boundaries are kept relative to the origin, and interior ones snapped
+				//to the position grid so both pieces that share one quantize it the same way:
+				b += record.at[axis];
+				if (k != 0 && k != count) {
+					b = std::round(b * SpriteVertex::position_scale()) / SpriteVertex::position_scale();
+					t = (b - record.at[axis] - lo[axis]) / (hi[axis] - lo[axis]);
+				}
+			}
+			bounds[axis].emplace_back(b);
+			fractions[axis].emplace_back(t);
+		}
+	}
+
+	glm::vec2 right = glm::vec2(std::cos(record.angle), std::sin(record.angle));
+	glm::vec2 up = glm::vec2(-right.y, right.x);
+	for (uint32_t y = 0; y + 1 < bounds[1].size(); ++y) {
+		for (uint32_t x = 0; x + 1 < bounds[0].size(); ++x) {
+			glm::vec2 c0 = glm::vec2(bounds[0][x], bounds[1][y]);
+			glm::vec2 c1 = glm::vec2(bounds[0][x + 1], bounds[1][y + 1]);
+			glm::vec2 t0 = glm::vec2(fractions[0][x], fractions[1][y]);
+			glm::vec2 t1 = glm::vec2(fractions[0][x + 1], fractions[1][y + 1]);
+
+			SpriteRecord piece = record;
+			glm::vec2 mid = 0.5f * (c0 + c1);
+			piece.at = (rotated ? record.at + right * mid.x + up * mid.y : mid);
+			piece.size = c1 - c0; //(keeps the sign, so mirrored sprites stay mirrored)
+			piece.inset_min = glm::vec2(0.0f);
+			piece.inset_max = glm::vec2(0.0f);
+			piece.min_uv = record.min_uv + (record.max_uv - record.min_uv) * t0;
+			piece.max_uv = record.min_uv + (record.max_uv - record.min_uv) * t1;
+			out->emplace_back(piece);
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Sprite vertex generation, a whole frame's sprites at a time.
+ *
+ * The frame loop records each sprite it draws as a SpriteRecord and turns
+ * them all into vertices with one emit_sprites() call. Each sprite becomes
+ * six triangle-strip vertices, with the first and last repeated, so any run
+ * of them draws as one strip. Unrotated sprites (angle 0, nearly all of them)
+ * take a fast path with no cos/sin, four corners computed at once with SSE2
+ * where available. Rotated ones are done one at a time.
+ *
+ * Positions are relative to an origin the caller picks per frame, and are
+ * stored in units of 1 / SpriteVertex::position_scale(). With COMPACT_VERTICES
+ * they only reach position_range() units from it, and level geometry can be
+ * bigger than that (a floor merged across chunks), so a record that reaches
+ * past it is split into pieces first (sprite_in_range(), split_sprite()).
+ */
+
+#ifdef COMPACT_VERTICES
+//12 bytes: 16-bit positions (1/256 unit steps, to +-128 units from the origin;
+//see split_sprite() for anything bigger), 16-bit normalized texture coordinates:
+struct SpriteVertex {
+	SpriteVertex() { } //(uninitialized, so resizing a vertex list to write into it does not clear it first)
+	SpriteVertex(glm::vec2 const &Position_, glm::vec2 const &TexCoord_, glm::u8vec4 const &Color_) :
+		Position(glm::clamp(glm::round(Position_ * position_scale()), -32768.0f, 32767.0f)),
+		TexCoord(glm::round(glm::clamp(TexCoord_, 0.0f, 1.0f) * 65535.0f)),
+		Color(Color_) { }
+	static float position_scale() { return 256.0f; }
+	static float position_range() { return 32767.0f / 256.0f; } //(farther is clamped)
+	glm::i16vec2 Position;
+	glm::u16vec2 TexCoord;
+	glm::u8vec4 Color;
+};
+static_assert(sizeof(SpriteVertex) == 12, "SpriteVertex is nicely packed.");
+#else
+struct SpriteVertex {
+	SpriteVertex() { } //(uninitialized, so resizing a vertex list to write into it does not clear it first)
+	SpriteVertex(glm::vec2 const &Position_, glm::vec2 const &TexCoord_, glm::u8vec4 const &Color_) :
+		Position(Position_), TexCoord(TexCoord_), Color(Color_) { }
+	static float position_scale() { return 1.0f; }
+	static float position_range() { return std::numeric_limits< float >::max(); }
+	glm::vec2 Position;
+	glm::vec2 TexCoord;
+	glm::u8vec4 Color;
+};
+static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex is nicely packed.");
+#endif
+
+struct SpriteRecord {
+	glm::vec2 at;   //center, relative to the origin
+	glm::vec2 size; //(negative to mirror)
+	glm::vec2 inset_min; //fraction of the quad trimmed at the min_uv corner (see SpriteInfo)
+	glm::vec2 inset_max; //fraction of the quad trimmed at the max_uv corner
+	glm::vec2 min_uv;
+	glm::vec2 max_uv;
+	glm::u8vec4 tint;
+	float angle; //radians, counterclockwise
+};
+
+//append six vertices per record to 'out' (record i's are out[start + 6i, start + 6i + 6)):
+void emit_sprites(SpriteRecord const *records, size_t count, std::vector< SpriteVertex > *out);
+
+//true if every corner of 'record' is within SpriteVertex::position_range() of the origin:
+bool sprite_in_range(SpriteRecord const &record);
+
+//Append pieces of 'record' (at most 32 units a side, with their share of its texture)
+//that together draw the same quad, so the ones near the origin are not clamped.
+//Unrotated pieces meet on the vertex position grid, so they leave no seams:
+void split_sprite(SpriteRecord const &record, std::vector< SpriteRecord > *out);
@@ -0,0 +1,66 @@
+#include "startup_timeline.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+StartupTimeline::StartupTimeline() : start(Clock::now()), main_thread(std::this_thread::get_id()) {
+}
+
+double StartupTimeline::now() const {
+	return std::chrono::duration< double, std::milli >(Clock::now() - start).count();
+}
+
+StartupTimeline::Stage::Stage(StartupTimeline *timeline_, std::string const &name) : timeline(timeline_) {
+	Record record;
+	record.name = name;
+	record.thread = std::this_thread::get_id();
+	record.begin = timeline->now();
+	std::lock_guard< std::mutex > lock(timeline->mutex);
+	index = uint32_t(timeline->records.size());
+	timeline->records.emplace_back(std::move(record));
+}
+
+void StartupTimeline::Stage::end() {
+	if (!timeline) return;
+	double at = timeline->now();
+	std::lock_guard< std::mutex > lock(timeline->mutex);
+	timeline->records[index].end = at;
+	timeline = nullptr;
+}
+
+void StartupTimeline::first_frame() {
+	if (first_frame_at < 0.0) first_frame_at = now();
+}
+
+void StartupTimeline::report() const {
+	std::vector< Record > sorted;
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		sorted = records;
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](Record const &a, Record const &b) { return a.begin < b.begin; });
+
+	//threads are numbered in order of their first stage:
+	std::vector< std::thread::id > workers;
+	auto thread_name = [&](std::thread::id id) -> std::string {
+		if (id == main_thread) return std::string("main");
+		auto found = std::find(workers.begin(), workers.end(), id);
+		if (found == workers.end()) found = workers.insert(workers.end(), id);
+		return "worker " + std::to_string(found - workers.begin() + 1);
+	};
+
+	std::printf("startup (ms since main() began):\n");
+	std::printf("  %-32s %-10s %9s %9s %9s\n", "stage", "thread", "start", "end", "took");
+	for (auto const &record : sorted) {
+		std::string thread = thread_name(record.thread);
+		if (record.end < 0.0) {
+			std::printf("  %-32s %-10s %9.1f %9s %9s\n", record.name.c_str(), thread.c_str(), record.begin, "-", "-");
+		} else {
+			std::printf("  %-32s %-10s %9.1f %9.1f %9.1f\n", record.name.c_str(), thread.c_str(), record.begin, record.end, record.end - record.begin);
+		}
+	}
+	if (first_frame_at >= 0.0) {
+		std::printf("  time to first frame: %.1f ms\n", first_frame_at);
+	}
+	std::fflush(stdout);
+}
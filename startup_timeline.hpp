@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Timing of startup stages, for --startup-report.
+ *
+ * Stages may run on any thread (startup loads images and sounds on worker
+ * threads while the main thread sets up the window and GL); each records
+ * when it began and ended relative to the timeline's creation and which
+ * thread ran it. first_frame() marks the end of startup.
+ *
+ * Typical use:
+ *   StartupTimeline startup;
+ *   { StartupTimeline::Stage stage(&startup, "shaders"); ...compile... }
+ *   ...
+ *   startup.first_frame();
+ *   startup.report();
+ */
+
+struct StartupTimeline {
+	typedef std::chrono::steady_clock Clock;
+
+	StartupTimeline();
+
+	//times a stage from construction to destruction (or end()):
+	struct Stage {
+		Stage(StartupTimeline *timeline, std::string const &name);
+		~Stage() { end(); }
+		Stage(Stage const &) = delete;
+		Stage &operator=(Stage const &) = delete;
+		void end();
+	private:
+		StartupTimeline *timeline;
+		uint32_t index;
+	};
+
+	//the first frame has been presented:
+	void first_frame();
+
+	//print every stage (ordered by start time) and the time to the first frame to stdout:
+	void report() const;
+
+private:
+	struct Record {
+		std::string name;
+		std::thread::id thread;
+		double begin = 0.0; //ms since 'start'
+		double end = -1.0;  //ms, < 0 while running
+	};
+
+	double now() const;
+
+	Clock::time_point start;
+	std::thread::id main_thread;
+	double first_frame_at = -1.0;
+
+	mutable std::mutex mutex; //guards 'records'
+	std::vector< Record > records;
+};
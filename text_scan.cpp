@@ -0,0 +1,180 @@
+#include "text_scan.hpp"
+#include "asset_pack.hpp"
+
+#include <cstdlib>
+
+bool TextScanner::load(std::string const &filename_) {
+	filename = filename_;
+	text.clear();
+	at = line_begin = line_end = next = token_at = 0;
+	line_number = 0;
+
+	AssetBytes bytes;
+	if (!load_asset(filename, &bytes)) return false;
+	text.assign(bytes.data, bytes.data + bytes.size);
+	text.push_back('\0');
+	return true;
+}
+
+void TextScanner::load_text(std::string const &name, std::string const &text_) {
+	filename = name;
+	text.assign(text_.begin(), text_.end());
+	text.push_back('\0');
+	at = line_begin = line_end = next = token_at = 0;
+	line_number = 0;
+}
+
+static bool is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+void TextScanner::skip_space() {
+	while (at < line_end && is_space(text[at])) ++at;
+	if (at < line_end && text[at] == '#') at = line_end;
+	token_at = at;
+}
+
+size_t TextScanner::token_end(size_t from) const {
+	while (from < line_end && !is_space(text[from]) && text[from] != '#') ++from;
+	return from;
+}
+
+bool TextScanner::next_line() {
+	size_t size = text.empty() ? 0 : text.size() - 1;
+	while (next < size) {
+		line_begin = next;
+		char const *newline = static_cast< char const * >(memchr(&text[line_begin], '\n', size - line_begin));
+		line_end = (newline ? size_t(newline - &text[0]) : size);
+		next = line_end + 1;
+		line_number += 1;
+
+		at = line_begin;
+		skip_space();
+		if (at < line_end) return true;
+	}
+	at = line_begin = line_end = next = size;
+	token_at = at;
+	return false;
+}
+
+bool TextScanner::word(TextToken *token) {
+	skip_space();
+	if (at == line_end) return false;
+	size_t end = token_end(at);
+	token->begin = &text[at];
+	token->size = end - at;
+	at = end;
+	return true;
+}
+
+bool TextScanner::word(std::string *value) {
+	TextToken token;
+	if (!word(&token)) return false;
+	value->assign(token.begin, token.size);
+	return true;
+}
+
+bool TextScanner::number(float *value) {
+	skip_space();
+	size_t p = at;
+	bool negative = false;
+	if (p < line_end && (text[p] == '-' || text[p] == '+')) {
+		negative = (text[p] == '-');
+		++p;
+	}
+	size_t digits_at = p;
+
+	//up to 19 significant digits go into the mantissa; the rest only move the exponent:
+	uint64_t mantissa = 0;
+	uint32_t digits = 0; //significant digits kept
+	bool any_digits = false;
+	int32_t exponent = 0;
+	while (p < line_end && text[p] >= '0' && text[p] <= '9') {
+		any_digits = true;
+		if (digits < 19) {
+			mantissa = mantissa * 10 + uint64_t(text[p] - '0');
+			if (mantissa != 0) ++digits;
+		} else {
+			++exponent;
+		}
+		++p;
+	}
+	if (p < line_end && text[p] == '.') {
+		++p;
+		while (p < line_end && text[p] >= '0' && text[p] <= '9') {
+			any_digits = true;
+			if (digits < 19) {
+				mantissa = mantissa * 10 + uint64_t(text[p] - '0');
+				if (mantissa != 0) ++digits;
+				--exponent;
+			}
+			++p;
+		}
+	}
+	if (!any_digits) return false;
+	if (p < line_end && (text[p] == 'e' || text[p] == 'E')) {
+		++p;
+		bool negative_exponent = false;
+		if (p < line_end && (text[p] == '-' || text[p] == '+')) {
+			negative_exponent = (text[p] == '-');
+			++p;
+		}
+		if (!(p < line_end && text[p] >= '0' && text[p] <= '9')) return false;
+		int32_t e = 0;
+		while (p < line_end && text[p] >= '0' && text[p] <= '9') {
+			if (e < 100000) e = e * 10 + (text[p] - '0');
+			++p;
+		}
+		exponent += (negative_exponent ? -e : e);
+	}
+	if (token_end(p) != p) return false; //trailing junk, e.g. "1.5x"
+
+	//Rounded once, straight to float (going through double would round twice,
+	//and then a few inputs would not match strtof):
+	float result;
+	static const float powers[11] = {
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+	};
+	if (mantissa == 0) {
+		result = 0.0f;
+	} else if (mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+		//both operands are exact floats, so this is one correctly-rounded operation:
+		result = float(mantissa);
+		result = (exponent < 0 ? result / powers[-exponent] : result * powers[exponent]);
+	} else {
+		//more than ~7 significant digits, or large exponents, are rare enough to leave to the C library:
+		result = std::strtof(&text[digits_at], nullptr);
+	}
+	*value = (negative ? -result : result);
+	at = p;
+	return true;
+}
+
+bool TextScanner::number(uint32_t *value) {
+	skip_space();
+	size_t p = at;
+	uint64_t result = 0;
+	while (p < line_end && text[p] >= '0' && text[p] <= '9') {
+		result = result * 10 + uint64_t(text[p] - '0');
+		if (result > 0xffffffffull) return false;
+		++p;
+	}
+	if (p == at || token_end(p) != p) return false;
+	*value = uint32_t(result);
+	at = p;
+	return true;
+}
+
+bool TextScanner::line_done() {
+	skip_space();
+	return at == line_end;
+}
+
+std::string TextScanner::where() const {
+	return filename + ":" + std::to_string(line_number) + ":" + std::to_string(token_at - line_begin + 1);
+}
+
+std::string TextScanner::found() const {
+	if (token_at >= line_end) return "end of line";
+	return "'" + std::string(&text[token_at], token_end(token_at) - token_at) + "'";
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Tokenizer for the game's line-oriented text files (level chunks, level
+ * headers, atlas manifests).
+ *
+ * The file is read into memory in one go (through load_asset(), so it may
+ * come from the asset pack) and values are parsed in place:
+ * no iostreams, no locale. Tokens are separated by spaces or tabs, '#'
+ * starts a comment that runs to the end of the line, and blank lines are
+ * skipped. Every read remembers where it started, so errors can point at
+ * the offending token as "file:line:column".
+ *
+ * Typical use:
+ *   TextScanner scan;
+ *   if (!scan.load(filename)) ...
+ *   while (scan.next_line()) {
+ *     TextToken kind;
+ *     scan.word(&kind);
+ *     if (kind == "door") ok = scan.number(&x) && scan.number(&y) && scan.line_done();
+ *     ...
+ *     if (!ok) LOG_ERROR(scan.where() << ": malformed door (found " << scan.found() << ").");
+ *   }
+ */
+
+//a token, pointing into the scanner's text:
+struct TextToken {
+	char const *begin = nullptr;
+	size_t size = 0;
+
+	bool operator==(char const *str) const { return strlen(str) == size && memcmp(begin, str, size) == 0; }
+	bool operator!=(char const *str) const { return !(*this == str); }
+	std::string str() const { return std::string(begin, size); }
+};
+
+struct TextScanner {
+	//read all of asset 'filename'; false if it can't be read:
+	bool load(std::string const &filename);
+	//scan 'text' instead of a file ('name' is used in where()):
+	void load_text(std::string const &name, std::string const &text);
+
+	//move to the next line with a token on it; false at the end of the text:
+	bool next_line();
+
+	//Read the next token on the current line. Each returns false if the line
+	//is used up or the token does not have the expected form; nothing is consumed then.
+	bool word(TextToken *token);
+	bool word(std::string *value);
+	bool number(float *value);    //decimal, with optional sign, fraction and exponent
+	bool number(uint32_t *value); //digits only
+
+	//true (after skipping trailing space and comments) if the line has no more tokens:
+	bool line_done();
+
+	//"<file>:<line>:<column>" of the token last read (or attempted):
+	std::string where() const;
+	//that token quoted, or "end of line":
+	std::string found() const;
+
+	std::string filename;
+
+private:
+	void skip_space();
+	size_t token_end(size_t from) const;
+
+	std::vector< char > text; //zero-terminated
+	size_t at = 0;         //read position
+	size_t line_begin = 0; //start of the current line
+	size_t line_end = 0;   //its '\n' (or the end of the text)
+	size_t next = 0;       //start of the line after it
+	size_t token_at = 0;   //start of the last token read or attempted
+	uint32_t line_number = 0;
+};
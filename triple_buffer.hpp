@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+
+/*
+ * Three slots for handing a stream of values (e.g. one frame's render state)
+ * from a producer thread to a consumer thread without either waiting for the
+ * other's work.
+ *
+ * The producer fills back() and publish()es it; the consumer takes the most
+ * recently published value with acquire(). A value published while the
+ * previous one was still unread replaces it (the consumer only ever sees the
+ * newest), and the slot the consumer is reading is never handed back to the
+ * producer until the consumer acquires another.
+ *
+ * Slots are reused, so a T whose members keep their storage (e.g. vectors
+ * that are clear()ed, not reassigned) stops allocating once it has grown.
+ * The lock is only held to swap slot indices.
+ */
+
+template< typename T >
+struct TripleBuffer {
+	//producer: the slot to fill next (its previous contents are stale, not cleared):
+	T &back() { return slots[back_index]; }
+
+	//producer: make back() the newest value; returns true if the value it replaces was never acquired:
+	bool publish() {
+		bool dropped;
+		{
+			std::lock_guard< std::mutex > lock(mutex);
+			std::swap(back_index, ready_index);
+			dropped = fresh;
+			fresh = true;
+		}
+		wake.notify_one();
+		return dropped;
+	}
+
+	//producer: wake a waiting consumer for good (acquire() returns nullptr from now on):
+	void close() {
+		{
+			std::lock_guard< std::mutex > lock(mutex);
+			closed = true;
+		}
+		wake.notify_one();
+	}
+
+	//consumer: wait for a value newer than the last one acquired and return it
+	//(it stays valid until the next acquire()); nullptr once closed:
+	T const *acquire() {
+		std::unique_lock< std::mutex > lock(mutex);
+		wake.wait(lock, [this](){ return fresh || closed; });
+		if (closed) return nullptr;
+		std::swap(front_index, ready_index);
+		fresh = false;
+		return &slots[front_index];
+	}
+
+private:
+	T slots[3];
+	uint32_t back_index = 0;  //producer's
+	uint32_t ready_index = 1; //newest published (if 'fresh')
+	uint32_t front_index = 2; //consumer's
+	bool fresh = false;
+	bool closed = false;
+	std::mutex mutex;
+	std::condition_variable wake;
+};
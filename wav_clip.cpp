@@ -0,0 +1,82 @@
+#include "wav_clip.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#define LOG_ERROR( X ) std::cerr << X << std::endl
+
+static uint16_t read16(uint8_t const *at) {
+	uint16_t value;
+	std::memcpy(&value, at, 2);
+	return value;
+}
+
+static uint32_t read32(uint8_t const *at) {
+	uint32_t value;
+	std::memcpy(&value, at, 4);
+	return value;
+}
+
+bool WavClip::load(std::string const &name) {
+	samples = nullptr;
+	length = 0;
+	if (!load_asset(name, &bytes)) {
+		LOG_ERROR("  cannot open '" << name << "'.");
+		return false;
+	}
+	uint8_t const *begin = reinterpret_cast< uint8_t const * >(bytes.data);
+	uint8_t const *end = begin + bytes.size;
+
+	if (bytes.size < 12 || std::memcmp(begin, "RIFF", 4) != 0 || std::memcmp(begin + 8, "WAVE", 4) != 0) {
+		LOG_ERROR("  '" << name << "' is not a RIFF WAVE file.");
+		return false;
+	}
+	//(the RIFF size is not trusted; plenty of writers get it wrong)
+
+	bool have_format = false;
+	uint16_t block_align = 0;
+	for (uint8_t const *at = begin + 12; end - at >= 8; ) {
+		uint32_t size = read32(at + 4);
+		uint8_t const *body = at + 8;
+		uint32_t available = uint32_t(std::min< size_t >(size, size_t(end - body)));
+
+		if (std::memcmp(at, "fmt ", 4) == 0) {
+			if (available < 16) break;
+			uint16_t tag = read16(body);
+			channels = read16(body + 2);
+			rate = read32(body + 4);
+			block_align = read16(body + 12);
+			bits = read16(body + 14);
+			if (tag == 0xfffe && available >= 26) {
+				//WAVE_FORMAT_EXTENSIBLE: the real format is the first two bytes of the subformat GUID
+				tag = read16(body + 24);
+			}
+			if (tag != PCM && tag != Float) {
+				LOG_ERROR("  '" << name << "' is compressed (format " << tag << "); only PCM and float WAVs are supported.");
+				return false;
+			}
+			encoding = Encoding(tag);
+			bool supported = (encoding == PCM ? (bits == 8 || bits == 16 || bits == 32) : bits == 32);
+			if (!supported || channels == 0 || rate == 0 || block_align != channels * (bits / 8)) {
+				LOG_ERROR("  '" << name << "' has an unsupported layout (" << channels << " channel(s), " << bits << " bits, block " << block_align << ").");
+				return false;
+			}
+			have_format = true;
+		} else if (std::memcmp(at, "data", 4) == 0) {
+			if (!have_format) {
+				LOG_ERROR("  '" << name << "' has its sample data before its format.");
+				return false;
+			}
+			//a truncated file still plays what it has, in whole frames:
+			samples = body;
+			length = available - available % block_align;
+			return true;
+		}
+
+		if (size_t(end - body) < size_t(size) + (size & 1)) break;
+		at = body + size + (size & 1); //chunks are padded to even sizes
+	}
+	LOG_ERROR("  '" << name << "' has no " << (have_format ? "sample data" : "format chunk") << ".");
+	return false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "asset_pack.hpp"
+
+#include <string>
+#include <stdint.h>
+
+/*
+ * WAV clips played straight from their file: the RIFF header is checked and
+ * the sample data is used where it lies in the mapped file (or asset pack),
+ * so loading copies nothing and the pages are shared with the page cache.
+ *
+ * Supports uncompressed PCM (8-bit unsigned, 16- or 32-bit signed) and
+ * 32-bit float, as plain or WAVE_FORMAT_EXTENSIBLE "fmt " chunks.
+ * Little-endian hosts only (as is everything else here).
+ */
+
+struct WavClip {
+	enum Encoding {
+		PCM = 1,
+		Float = 3,
+	};
+
+	//map asset 'name' and find its samples; false (and logs) if it isn't a supported WAV:
+	bool load(std::string const &name);
+
+	Encoding encoding = PCM;
+	uint16_t channels = 0;
+	uint32_t rate = 0; //frames per second
+	uint16_t bits = 0; //per sample
+
+	//interleaved samples, read-only (valid while the clip lives):
+	uint8_t const *samples = nullptr;
+	uint32_t length = 0; //bytes, a whole number of frames
+
+private:
+	AssetBytes bytes;
+};